@@ -15,6 +15,10 @@ set OUTPUT_EXE=%PROJECT_NAME%.exe
 REM Include the 'src' directory for header files
 set INCLUDE_PATHS=/I"src"
 
+REM Instruction set: the default x64 build uses the SSE2 line-of-sight kernel;
+REM /arch:AVX2 selects the AVX2 one, /DLOS_KERNEL_SCALAR the portable loop
+set ARCH_FLAGS=
+
 REM DEBUG: List all cpp files to verify they exist
 echo DEBUG: Listing all cpp files...
 dir /b src\*.cpp
@@ -34,7 +38,28 @@ src\SimulationSetup.cpp ^
 src\GameLogic.cpp ^
 src\CaptureLogic.cpp ^
 src\GridRenderer.cpp ^
-src\StatusDisplay.cpp
+src\StatusDisplay.cpp ^
+src\ChunkedGrid.cpp ^
+src\ThreadPool.cpp ^
+src\Benchmark.cpp ^
+src\MappedFile.cpp ^
+src\WorldFile.cpp ^
+src\ComponentIndex.cpp ^
+src\PathSearchContext.cpp ^
+src\JumpPointSearch.cpp ^
+src\PathHierarchy.cpp ^
+src\HierarchicalPathfinding.cpp ^
+src\PathCache.cpp ^
+src\IncrementalPlanner.cpp ^
+src\FlowField.cpp ^
+src\BidirectionalSearch.cpp ^
+src\BudgetedSearch.cpp ^
+src\PathService.cpp ^
+src\ThetaStar.cpp ^
+src\VisibilityCache.cpp ^
+src\LineOfSightBatch.cpp ^
+src\SpatialHash.cpp ^
+src\SpriteStore.cpp
 
 echo Compiling %PROJECT_NAME%...
 echo Files to compile:
@@ -44,7 +69,7 @@ REM Try compiling each file individually to see if any fail
 echo Testing individual compilation...
 for %%F in (%SOURCE_FILES%) do (
     echo Compiling %%F...
-    cl.exe /c /EHsc /std:c++17 /W4 /Zi %INCLUDE_PATHS% %%F
+    cl.exe /c /EHsc /std:c++17 /W4 /Zi %ARCH_FLAGS% %INCLUDE_PATHS% %%F
     if %ERRORLEVEL% NEQ 0 (
         echo ERROR compiling %%F
         goto :end
@@ -52,7 +77,7 @@ for %%F in (%SOURCE_FILES%) do (
 )
 
 REM Try full compilation
-cl.exe /EHsc /std:c++17 /W4 /Zi %INCLUDE_PATHS% %SOURCE_FILES% /link /OUT:%OUTPUT_EXE%
+cl.exe /EHsc /std:c++17 /W4 /Zi %ARCH_FLAGS% %INCLUDE_PATHS% %SOURCE_FILES% /link /OUT:%OUTPUT_EXE%
 
 echo.
 if %ERRORLEVEL% EQU 0 (
@@ -15,56 +15,45 @@ extern std::mt19937 gen;
 namespace AIController {
 
 // Helper function to find the closest sprite from a list
-const Sprite* find_closest_sprite(const Vec2D& current_pos, const std::vector<Sprite>& candidates,
-                                 int& out_distance, int max_dist) {
-    const Sprite* closest = nullptr;
-    int min_dist_sq = std::numeric_limits<int>::max();
+int find_closest_sprite(const Vec2D& current_pos, const SpatialHash& candidates,
+                        int& out_distance, int max_dist) {
     out_distance = std::numeric_limits<int>::max();
 
-    if (candidates.empty()) {
-        return nullptr;
+    // Whatever is nearest by squared distance beyond max_dist is beyond it by Manhattan too
+    const int64_t max_dist_sq = static_cast<int64_t>(max_dist) * max_dist;
+    const int closest = candidates.nearest(current_pos, max_dist_sq);
+    if (closest < 0) {
+        return -1;
     }
-
-    for (const auto& candidate : candidates) {
-        int dist_sq = PathfindingHelpers::squared_distance(current_pos, candidate.position);
-        if (dist_sq < min_dist_sq) {
-            min_dist_sq = dist_sq;
-            closest = &candidate;
-        }
-    }
-
-    if (closest) {
-        out_distance = PathfindingHelpers::manhattan_distance(current_pos, closest->position);
-        if (out_distance > max_dist) {
-            return nullptr;
-        }
+    out_distance = PathfindingHelpers::manhattan_distance(current_pos, candidates.position(closest));
+    if (out_distance > max_dist) {
+        return -1;
     }
     return closest;
 }
 
 // Implementation delegates to new modules
-void move_randomly(Sprite& sprite, const World& world) {
+void move_randomly(SpriteRef& sprite, const World& world) {
     MovementController::move_randomly(sprite, world);
 }
 
 // Implementation delegates to new module
-Vec2D handle_predator_path_following(Sprite& predator, const World& world) {
+Vec2D handle_predator_path_following(SpriteRef& predator, const World& world) {
     return MovementController::follow_path(predator, world);
 }
 
 // Implementation delegates to new module
-bool validate_and_repair_path(std::vector<Vec2D>& path,
-                             const std::unordered_set<Vec2D>& obstacles, int width, int height) {
-    return PathfindingHelpers::validate_and_repair_path(path, obstacles, width, height);
+bool validate_and_repair_path(std::vector<Vec2D>& path, const World& world) {
+    return PathfindingHelpers::validate_and_repair_path(path, world);
 }
 
 // Main update function - dispatches to the appropriate AI module
-void update_sprite_ai(Sprite& sprite_to_update, const std::vector<Sprite>& all_predators,
-                     const std::vector<Sprite>& all_prey, const World& world) {
+void update_sprite_ai(SpriteRef& sprite_to_update, const SpriteStore& opponents,
+                     const SpatialHash& opponent_index, const World& world) {
     if (sprite_to_update.type == Sprite::Type::PREDATOR) {
-        PredatorAI::update_predator(sprite_to_update, all_predators, all_prey, world);
+        PredatorAI::update_predator(sprite_to_update, opponents, opponent_index, world);
     } else if (sprite_to_update.type == Sprite::Type::PREY) {
-        PreyAI::update_prey(sprite_to_update, all_predators, world);
+        PreyAI::update_prey(sprite_to_update, opponent_index, world);
     }
 
     // Ensure position is valid (redundant safety check)
@@ -2,11 +2,11 @@
 #define AICONTROLLER_H
 
 #include <vector>
-#include <unordered_set>
 #include <limits>
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "Vec2D.h"
 #include "World.h"
+#include "SpatialHash.h"
 
 // Contains AI logic update functions.
 // Currently designed as free functions operating on Sprite and World data.
@@ -23,20 +23,23 @@ namespace AIController {
     const float SAFE_ZONE_FEAR_DECAY_MULTIPLIER = 2.0f; // Added for prey safe zone seeking
 
     // Updates the AI state and position for a single sprite, considering all other sprites.
-    void update_sprite_ai(Sprite& sprite_to_update, const std::vector<Sprite>& all_predators, const std::vector<Sprite>& all_prey, const World& world);
+    // opponents holds the sprites it looks for (the prey for a predator, the predators for
+    // a prey), and opponent_index indexes their current positions.
+    void update_sprite_ai(SpriteRef& sprite_to_update, const SpriteStore& opponents,
+                          const SpatialHash& opponent_index, const World& world);
 
     // Helper function for random movement (could be private if AIController was a class)
-    void move_randomly(Sprite& s, const World& world);
+    void move_randomly(SpriteRef& s, const World& world);
 
     // Helper function for predator path following (could be private if AIController was a class)
-    Vec2D handle_predator_path_following(Sprite& predator, const World& world);
+    Vec2D handle_predator_path_following(SpriteRef& predator, const World& world);
     
     // Validates a path and returns true if it's valid, false otherwise
-    bool validate_and_repair_path(std::vector<Vec2D>& path, 
-                                 const std::unordered_set<Vec2D>& obstacles, int width, int height);
+    bool validate_and_repair_path(std::vector<Vec2D>& path, const World& world);
 
-    // Helper function to find the closest sprite from a list
-    const Sprite* find_closest_sprite(const Vec2D& current_pos, const std::vector<Sprite>& candidates,  
+    // Helper function to find the closest sprite (squared distance) among the indexed ones;
+    // out_distance is its Manhattan distance. Returns its index, or -1 beyond max_dist
+    int find_closest_sprite(const Vec2D& current_pos, const SpatialHash& candidates,
                                      int& out_distance, int max_dist = std::numeric_limits<int>::max());
 
 } // namespace AIController
@@ -0,0 +1,188 @@
+#ifndef ASTAR_SEARCH_H
+#define ASTAR_SEARCH_H
+
+#include <vector>
+#include <cstdlib>   // For std::abs
+#include <algorithm> // For std::reverse, std::find, std::min, std::max
+#include <climits>   // For INT_MAX
+#include "Vec2D.h"
+#include "World.h"
+#include "PathPolicies.h"
+#include "PathSearchContext.h"
+#include "PathfindingHelpers.h"
+
+// A* with compile-time policies (see PathPolicies.h), e.g.
+//   find_path<PathPolicies::OctileHeuristic, PathPolicies::OctileCost>(start, goal, world, path)
+// Same contract as the non-template find_path: path is cleared, filled with every step
+// from start to goal, and checked by validate_and_repair_path; search state comes from
+// the calling thread's PathSearchContext. Ties in f go to the node with the lower h.
+template <typename Heuristic,
+          typename MoveCost = PathPolicies::UnitCost,
+          typename Neighborhood = PathPolicies::EightConnected>
+bool find_path(
+    const Vec2D& start,
+    const Vec2D& goal,
+    const World& world,
+    std::vector<Vec2D>& path
+) {
+    path.clear();
+
+    // Goals in another connected component (e.g. an enclosed pocket) can never be
+    // reached, so reject them before the search expands every reachable cell.
+    // Components are 8-connected, so this never rejects a goal any neighborhood reaches.
+    if (!world.is_reachable(start, goal)) {
+        return false;
+    }
+
+    auto estimate = [&goal](const Vec2D& pos) {
+        return Heuristic::template estimate<MoveCost>(std::abs(pos.x - goal.x), std::abs(pos.y - goal.y));
+    };
+
+    PathSearchContext& search = PathSearchContext::for_this_thread();
+    search.begin(world);
+
+    PathSearchContext::Node& start_node = search.touch(start.x, start.y);
+    start_node.g = 0;
+    const int start_h = estimate(start);
+    search.push_or_decrease(start, start_node, start_h, start_h);
+
+    while (!search.open_empty()) {
+        const Vec2D current = search.pop();
+
+        if (current == goal) {
+            // Path reconstruction: walk the parent directions back to the start
+            Vec2D trace_back_node = goal;
+            while (trace_back_node != start) {
+                path.push_back(trace_back_node);
+                const uint8_t dir = search.touch(trace_back_node.x, trace_back_node.y).parent_dir;
+                trace_back_node = {trace_back_node.x - World::NEIGHBOR_OFFSETS[dir].x,
+                                   trace_back_node.y - World::NEIGHBOR_OFFSETS[dir].y};
+            }
+            path.push_back(start);
+            std::reverse(path.begin(), path.end());
+
+            // Validate the path
+            if (PathfindingHelpers::validate_and_repair_path(path, world)) {
+                return true;
+            }
+            path.clear();
+            return false; // Path validation failed
+        }
+
+        const int current_g = search.touch(current.x, current.y).g;
+        for (uint8_t dir = 0; dir < Neighborhood::DIRECTION_COUNT; ++dir) {
+            const Vec2D neighbor_pos = {current.x + World::NEIGHBOR_OFFSETS[dir].x,
+                                        current.y + World::NEIGHBOR_OFFSETS[dir].y};
+            if (!world.is_walkable(neighbor_pos) || !Neighborhood::can_step(world, current, dir)) {
+                continue;
+            }
+
+            PathSearchContext::Node& neighbor = search.touch(neighbor_pos.x, neighbor_pos.y);
+            const int tentative_g_cost = current_g + (dir < 4 ? MoveCost::STRAIGHT : MoveCost::DIAGONAL);
+            if (tentative_g_cost < neighbor.g) {
+                neighbor.g = tentative_g_cost;
+                neighbor.parent_dir = dir;
+                neighbor.parent_steps = 1;
+                const int h_cost = estimate(neighbor_pos);
+                search.push_or_decrease(neighbor_pos, neighbor, tentative_g_cost + h_cost, h_cost);
+            }
+        }
+    }
+    return false; // Goal not reachable
+}
+
+// Multi-goal A*: path from start to whichever goal is fewest 8-connected unit-cost steps
+// away, in one search. The heuristic is the Chebyshev distance to the closest goal that
+// is reachable at all, so the first goal popped is a nearest one. allow_step(from, to)
+// vetoes single moves (e.g. a first step toward a threat), and nothing farther than
+// max_steps from start is searched. Same path contract as find_path; returns the index
+// of the goal reached in goals, or -1 (path empty) if none can be reached.
+template <typename StepFilter = PathPolicies::AnyStep>
+int find_path_to_any(
+    const Vec2D& start,
+    const std::vector<Vec2D>& goals,
+    const World& world,
+    std::vector<Vec2D>& path,
+    StepFilter&& allow_step = StepFilter(),
+    int max_steps = INT_MAX
+) {
+    path.clear();
+
+    // Goals in other components only weaken the heuristic
+    thread_local std::vector<Vec2D> targets;
+    targets.clear();
+    for (const Vec2D& goal : goals) {
+        if (world.is_reachable(start, goal)) {
+            targets.push_back(goal);
+        }
+    }
+    if (targets.empty()) {
+        return -1;
+    }
+
+    auto estimate = [](const Vec2D& pos) {
+        int nearest = INT_MAX;
+        for (const Vec2D& target : targets) {
+            nearest = std::min(nearest, std::max(std::abs(pos.x - target.x), std::abs(pos.y - target.y)));
+        }
+        return nearest;
+    };
+
+    PathSearchContext& search = PathSearchContext::for_this_thread();
+    search.begin(world);
+
+    PathSearchContext::Node& start_node = search.touch(start.x, start.y);
+    start_node.g = 0;
+    const int start_h = estimate(start);
+    if (start_h > max_steps) {
+        return -1;
+    }
+    search.push_or_decrease(start, start_node, start_h, start_h);
+
+    while (!search.open_empty()) {
+        const Vec2D current = search.pop();
+        const int current_g = search.touch(current.x, current.y).g;
+
+        if (estimate(current) == 0) {
+            Vec2D trace_back_node = current;
+            while (trace_back_node != start) {
+                path.push_back(trace_back_node);
+                const uint8_t dir = search.touch(trace_back_node.x, trace_back_node.y).parent_dir;
+                trace_back_node = {trace_back_node.x - World::NEIGHBOR_OFFSETS[dir].x,
+                                   trace_back_node.y - World::NEIGHBOR_OFFSETS[dir].y};
+            }
+            path.push_back(start);
+            std::reverse(path.begin(), path.end());
+
+            if (!PathfindingHelpers::validate_and_repair_path(path, world)) {
+                path.clear();
+                return -1;
+            }
+            return static_cast<int>(std::find(goals.begin(), goals.end(), current) - goals.begin());
+        }
+
+        for (uint8_t dir = 0; dir < 8; ++dir) {
+            const Vec2D neighbor_pos = {current.x + World::NEIGHBOR_OFFSETS[dir].x,
+                                        current.y + World::NEIGHBOR_OFFSETS[dir].y};
+            if (!world.is_walkable(neighbor_pos) || !allow_step(current, neighbor_pos)) {
+                continue;
+            }
+
+            PathSearchContext::Node& neighbor = search.touch(neighbor_pos.x, neighbor_pos.y);
+            const int tentative_g_cost = current_g + 1;
+            if (tentative_g_cost < neighbor.g) {
+                const int h_cost = estimate(neighbor_pos);
+                if (tentative_g_cost + h_cost > max_steps) {
+                    continue; // Every goal is out of range through here
+                }
+                neighbor.g = tentative_g_cost;
+                neighbor.parent_dir = dir;
+                neighbor.parent_steps = 1;
+                search.push_or_decrease(neighbor_pos, neighbor, tentative_g_cost + h_cost, h_cost);
+            }
+        }
+    }
+    return -1; // No goal within max_steps (or every route vetoed)
+}
+
+#endif // ASTAR_SEARCH_H
@@ -0,0 +1,1713 @@
+#include "Benchmark.h"
+#include "World.h"
+#include "Pathfinding.h"
+#include "ThreadPool.h"
+#include "PathSearchContext.h"
+#include "PathCache.h"
+#include "IncrementalPlanner.h"
+#include "FlowField.h"
+#include "BudgetedSearch.h"
+#include "PathService.h"
+#include "SpatialHash.h"
+#include "CaptureLogic.h"
+#include "SpriteStore.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include <functional>
+#include <climits>
+#include <cstdint>
+#include <cmath>
+
+namespace Benchmark {
+
+// Fixed seed so every run benchmarks the same maps
+const uint32_t BENCHMARK_SEED = 12345;
+
+// Wall-clock milliseconds taken by fn()
+template <typename Fn>
+static double time_ms(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void run_world_generation(std::ostream& out) {
+    const int sizes[] = {256, 1024, 4096, 8192};
+    // At least 4 threads so the determinism check also exercises tile interleaving on small machines
+    const unsigned thread_count = std::max(4u, std::thread::hardware_concurrency());
+
+    out << "World generation (seed " << BENCHMARK_SEED << ", N = " << thread_count << " threads)" << std::endl;
+    out << std::setw(12) << "size" << std::setw(14) << "1 thread ms" << std::setw(14) << "N threads ms"
+        << std::setw(10) << "speedup" << std::setw(14) << "Mcells/s" << std::setw(12) << "identical" << std::endl;
+
+    for (int size : sizes) {
+        World single(size, size);
+        World multi(size, size);
+        double single_ms = time_ms([&]() { single.initialize_obstacles(BENCHMARK_SEED, 1); });
+        double multi_ms = time_ms([&]() { multi.initialize_obstacles(BENCHMARK_SEED, thread_count); });
+
+        bool identical = single.grid.storage.same_contents(multi.grid.storage);
+        double mcells_per_s = (static_cast<double>(size) * size / 1.0e6) / (multi_ms / 1000.0);
+
+        out << std::setw(12) << (std::to_string(size) + "^2")
+            << std::fixed << std::setprecision(1)
+            << std::setw(14) << single_ms << std::setw(14) << multi_ms
+            << std::setw(10) << single_ms / multi_ms << std::setw(14) << mcells_per_s
+            << std::setw(12) << (identical ? "yes" : "NO") << std::endl;
+    }
+}
+
+void run_world_file(std::ostream& out) {
+    const int size = 10000; // 100M cells
+    const std::string path = "benchmark_world.ppworld";
+
+    World generated(size, size);
+    double generate_ms = time_ms([&]() { generated.initialize_obstacles(BENCHMARK_SEED); });
+    bool saved = false;
+    double save_ms = time_ms([&]() { saved = generated.save_to_file(path); });
+
+    {   // The loaded world is destroyed (and the file unmapped) before the file is deleted
+        World loaded;
+        bool ok = false;
+        double load_ms = time_ms([&]() { ok = saved && loaded.load_from_file(path); });
+
+        // First pass over the mapped obstacle rows pays for reading the pages
+        size_t obstacles = 0;
+        double scan_ms = time_ms([&]() { obstacles = loaded.grid.count_set(); });
+
+        bool identical = ok &&
+                         loaded.grid.storage.same_contents(generated.grid.storage) &&
+                         loaded.safe_zone_mask.storage.same_contents(generated.safe_zone_mask.storage) &&
+                         loaded.safe_zone_distance.storage.same_contents(generated.safe_zone_distance.storage) &&
+                         loaded.safe_zone_next_step.storage.same_contents(generated.safe_zone_next_step.storage) &&
+                         loaded.safe_zone_centers == generated.safe_zone_centers;
+
+        out << "World file (" << size << "^2, seed " << BENCHMARK_SEED << ")" << std::endl;
+        out << std::fixed << std::setprecision(1)
+            << "  generate " << generate_ms << " ms, save " << save_ms << " ms, load "
+            << std::setprecision(3) << load_ms << " ms, first obstacle scan "
+            << std::setprecision(1) << scan_ms << " ms (" << obstacles << " obstacles)" << std::endl;
+        out << "  identical: " << (identical ? "yes" : "NO") << std::endl;
+    }
+    std::remove(path.c_str());
+}
+
+void run_components(std::ostream& out) {
+    const int sizes[] = {1024, 4096};
+    const int pocket_queries = 20;
+
+    out << "Connected components (seed " << BENCHMARK_SEED << ")" << std::endl;
+    out << std::setw(12) << "size" << std::setw(12) << "build ms" << std::setw(14) << "update us"
+        << std::setw(14) << "components" << std::setw(20) << "pocket query us" << std::endl;
+
+    for (int size : sizes) {
+        World world(size, size);
+        world.initialize_obstacles(BENCHMARK_SEED);
+
+        ThreadPool pool;
+        double build_ms = time_ms([&]() { world.components.build(world.grid, pool); });
+
+        // Seal a goal cell in the middle of the map inside a ring of obstacles
+        const Vec2D goal = {size / 2, size / 2};
+        double update_ms = time_ms([&]() {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    world.set_obstacle({goal.x + dx, goal.y + dy}, dx != 0 || dy != 0);
+                }
+            }
+        });
+
+        const Vec2D start = {2, 2};
+        bool all_rejected = true;
+        double query_ms = time_ms([&]() {
+            for (int i = 0; i < pocket_queries; ++i) {
+                all_rejected = all_rejected && find_path(start, goal, world).empty();
+            }
+        });
+
+        out << std::setw(12) << (std::to_string(size) + "^2")
+            << std::fixed << std::setprecision(1)
+            << std::setw(12) << build_ms << std::setw(14) << update_ms * 1000.0 / 9
+            << std::setw(14) << world.components.component_count
+            << std::setw(20) << query_ms * 1000.0 / pocket_queries
+            << (all_rejected ? "" : "  (path found?)") << std::endl;
+    }
+}
+
+void run_dynamic_obstacles(std::ostream& out) {
+    const int size = 512;
+    const int path_count = 200;
+    const int edit_count = 100;
+    const int wall_length = 6;
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    std::mt19937 rng(BENCHMARK_SEED);
+    std::uniform_int_distribution<> coordinate(1, size - 2);
+
+    // Cached paths between random walkable cells, all checked against the current version
+    std::vector<std::vector<Vec2D>> paths;
+    while (static_cast<int>(paths.size()) < path_count) {
+        const Vec2D start = {coordinate(rng), coordinate(rng)};
+        const Vec2D goal = {std::min(size - 2, start.x + coordinate(rng) % 64),
+                            std::min(size - 2, start.y + coordinate(rng) % 64)};
+        if (world.is_walkable(start) && world.is_walkable(goal) && start != goal) {
+            std::vector<Vec2D> path = find_path(start, goal, world);
+            if (!path.empty()) {
+                paths.push_back(path);
+            }
+        }
+    }
+    std::vector<uint64_t> checked_version(paths.size(), world.obstacle_version);
+    std::vector<bool> dropped(paths.size(), false);
+
+    // Alternate placing a wall segment and removing it again, checking the paths after each edit
+    std::vector<Vec2D> wall;
+    int edits_touching_paths = 0;
+    double edit_ms = 0.0;
+    double check_ms = 0.0;
+    for (int edit = 0; edit < edit_count; ++edit) {
+        const bool placing = wall.empty();
+        if (placing) {
+            const Vec2D origin = {coordinate(rng), coordinate(rng)};
+            const bool horizontal = (rng() & 1) != 0;
+            for (int i = 0; i < wall_length; ++i) {
+                const Vec2D cell = {origin.x + (horizontal ? i : 0), origin.y + (horizontal ? 0 : i)};
+                if (world.is_walkable(cell)) {
+                    wall.push_back(cell);
+                }
+            }
+        }
+        edit_ms += time_ms([&]() { world.set_obstacles(wall, placing); });
+        if (!placing) {
+            wall.clear();
+        }
+
+        bool touched = false;
+        check_ms += time_ms([&]() {
+            for (size_t i = 0; i < paths.size(); ++i) {
+                if (!dropped[i] && world.is_path_blocked_since(paths[i], 0, checked_version[i])) {
+                    dropped[i] = true;
+                    touched = true;
+                }
+                checked_version[i] = world.obstacle_version;
+            }
+        });
+        edits_touching_paths += touched ? 1 : 0;
+    }
+
+    const long long dropped_count = std::count(dropped.begin(), dropped.end(), true);
+    out << "Dynamic obstacles (" << size << "^2, " << path_count << " cached paths, "
+        << edit_count << " edits of up to " << wall_length << " cells)" << std::endl;
+    out << std::fixed << std::setprecision(1)
+        << "  edit " << edit_ms * 1000.0 / edit_count << " us avg (components + safe-zone field), "
+        << "path check " << check_ms * 1000.0 / edit_count << " us avg for all paths" << std::endl;
+    out << "  paths dropped: " << dropped_count << " of " << path_count
+        << " (dropping on any change would discard all " << path_count << " on each of "
+        << edit_count << " edits; " << edits_touching_paths << " edits blocked some path)" << std::endl;
+}
+
+// Random start/goal pairs with a path between them, at most max_offset apart per axis
+static std::vector<std::pair<Vec2D, Vec2D>> make_queries(const World& world, int count, int max_offset, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> x_dist(1, world.width - 2);
+    std::uniform_int_distribution<> y_dist(1, world.height - 2);
+    std::uniform_int_distribution<> offset(-max_offset, max_offset);
+    std::vector<std::pair<Vec2D, Vec2D>> queries;
+    while (static_cast<int>(queries.size()) < count) {
+        const Vec2D start = {x_dist(rng), y_dist(rng)};
+        const Vec2D goal = {std::max(1, std::min(world.width - 2, start.x + offset(rng))),
+                            std::max(1, std::min(world.height - 2, start.y + offset(rng)))};
+        if (start != goal && world.is_walkable(start) && world.is_reachable(start, goal)) {
+            queries.push_back({start, goal});
+        }
+    }
+    return queries;
+}
+
+void run_pathfinding(std::ostream& out) {
+    const int size = 1024;
+    const int query_count = 200;
+    const int max_offset = 200;
+    const PathEngine engines[] = {PathEngine::ASTAR, PathEngine::ASTAR_CHEBYSHEV, PathEngine::ASTAR_OCTILE,
+                                  PathEngine::JPS, PathEngine::BIDIRECTIONAL, PathEngine::THETA};
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+
+    out << "find_path (" << size << "^2, " << query_count << " reachable queries up to "
+        << max_offset << " cells apart per axis)" << std::endl;
+    out << std::setw(16) << "engine" << std::setw(12) << "us/query" << std::setw(16) << "expanded/query"
+        << std::setw(14) << "M nodes/s" << std::setw(14) << "path length" << std::setw(10) << "found"
+        << std::setw(16) << "cold us/query" << std::endl;
+
+    const PathEngine previous_engine = get_active_path_engine();
+    std::vector<Vec2D> path;
+    for (PathEngine engine : engines) {
+        set_active_path_engine(engine);
+        size_t expanded = 0;
+        size_t total_length = 0;
+        int found = 0;
+        auto run_queries = [&]() {
+            expanded = 0;
+            total_length = 0;
+            found = 0;
+            for (const auto& query : queries) {
+                found += find_path(query.first, query.second, world, path) ? 1 : 0;
+                expanded += engine == PathEngine::BIDIRECTIONAL ? bidirectional_expanded_count()
+                                                                : PathSearchContext::for_this_thread().expanded_count();
+                total_length += path.size();
+            }
+        };
+        double cold_ms = time_ms(run_queries); // Allocates search pages for every chunk the queries touch
+        double total_ms = time_ms(run_queries);
+
+        out << std::setw(16) << path_engine_name(engine)
+            << std::fixed << std::setprecision(1)
+            << std::setw(12) << total_ms * 1000.0 / query_count
+            << std::setw(16) << static_cast<double>(expanded) / query_count
+            << std::setw(14) << (expanded / 1.0e6) / (total_ms / 1000.0)
+            << std::setw(14) << total_length << std::setw(10) << found
+            << std::setw(16) << cold_ms * 1000.0 / query_count << std::endl;
+    }
+    set_active_path_engine(previous_engine);
+}
+
+// Per-query results of one policy combination over a fixed query set
+struct PolicyRun {
+    double total_ms = 0.0;
+    size_t expanded = 0;
+    std::vector<int> steps;        // Moves per query (-1 if not found)
+    std::vector<double> geometric; // Length with diagonals counted as sqrt(2)
+};
+
+template <typename Heuristic, typename MoveCost, typename Neighborhood>
+static PolicyRun run_policy(const World& world, const std::vector<std::pair<Vec2D, Vec2D>>& queries) {
+    PolicyRun run;
+    std::vector<Vec2D> path;
+    auto run_queries = [&]() {
+        run.expanded = 0;
+        run.steps.clear();
+        run.geometric.clear();
+        for (const auto& query : queries) {
+            const bool found = find_path<Heuristic, MoveCost, Neighborhood>(query.first, query.second, world, path);
+            run.expanded += PathSearchContext::for_this_thread().expanded_count();
+            double length = 0.0;
+            for (size_t i = 1; i < path.size(); ++i) {
+                length += (path[i].x != path[i - 1].x && path[i].y != path[i - 1].y) ? 1.41421356 : 1.0;
+            }
+            run.steps.push_back(found ? static_cast<int>(path.size()) - 1 : -1);
+            run.geometric.push_back(length);
+        }
+    };
+    run_queries(); // Warm the search pages
+    run.total_ms = time_ms(run_queries);
+    return run;
+}
+
+void run_path_policies(std::ostream& out) {
+    using namespace PathPolicies;
+    const int size = 1024;
+    const int query_count = 200;
+    const int max_offset = 200;
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+
+    struct Row {
+        const char* name;
+        PolicyRun run;
+    };
+    const Row rows[] = {
+        {"manhattan/unit/8", run_policy<ManhattanHeuristic, UnitCost, EightConnected>(world, queries)},
+        {"chebyshev/unit/8", run_policy<ChebyshevHeuristic, UnitCost, EightConnected>(world, queries)},
+        {"octile/octile/8", run_policy<OctileHeuristic, OctileCost, EightConnected>(world, queries)},
+        {"octile/octile/8nc", run_policy<OctileHeuristic, OctileCost, EightConnectedNoCornerCutting>(world, queries)},
+        {"manhattan/unit/4", run_policy<ManhattanHeuristic, UnitCost, FourConnected>(world, queries)},
+    };
+    // Chebyshev under unit cost is admissible, so its step counts are the minimum; likewise
+    // octile under octile cost gives the shortest geometric length (up to the 14/10 rounding)
+    const PolicyRun& fewest_steps = rows[1].run;
+    const PolicyRun& shortest_geometric = rows[2].run;
+
+    out << "find_path policies (" << size << "^2, " << query_count << " reachable queries up to "
+        << max_offset << " cells apart per axis; heuristic/cost/neighborhood, 8nc = no corner cutting)" << std::endl;
+    out << std::setw(20) << "policy" << std::setw(12) << "us/query" << std::setw(16) << "expanded/query"
+        << std::setw(10) << "steps" << std::setw(12) << "+steps %" << std::setw(12) << "geometric"
+        << std::setw(14) << "+geometric %" << std::setw(10) << "optimal" << std::setw(8) << "found" << std::endl;
+    for (const Row& row : rows) {
+        long long steps = 0;
+        long long min_steps = 0;
+        double geometric = 0.0;
+        double min_geometric = 0.0;
+        int optimal = 0; // Queries with the fewest possible steps
+        int found = 0;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            if (row.run.steps[i] < 0) {
+                continue;
+            }
+            found++;
+            steps += row.run.steps[i];
+            min_steps += fewest_steps.steps[i];
+            geometric += row.run.geometric[i];
+            min_geometric += shortest_geometric.geometric[i];
+            optimal += row.run.steps[i] == fewest_steps.steps[i] ? 1 : 0;
+        }
+        out << std::setw(20) << row.name << std::fixed << std::setprecision(1)
+            << std::setw(12) << row.run.total_ms * 1000.0 / query_count
+            << std::setw(16) << static_cast<double>(row.run.expanded) / query_count
+            << std::setw(10) << steps
+            << std::setw(12) << (min_steps > 0 ? 100.0 * (steps - min_steps) / min_steps : 0.0)
+            << std::setw(12) << geometric
+            << std::setw(14) << (min_geometric > 0.0 ? 100.0 * (geometric - min_geometric) / min_geometric : 0.0)
+            << std::setw(10) << optimal << std::setw(8) << found << std::endl;
+    }
+}
+
+void run_hierarchical(std::ostream& out) {
+    const int size = 4096;
+    const int query_count = 50;
+    const int max_offset = 2000;
+    const int edit_count = 100;
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const double build_ms = time_ms([&]() { world.build_path_hierarchy(); });
+    const PathHierarchy& hierarchy = world.path_hierarchy;
+    out << "Path hierarchy (" << size << "^2): built in " << std::fixed << std::setprecision(1) << build_ms
+        << " ms, " << hierarchy.node_count() << " entrances in " << hierarchy.clusters.size() << " clusters, "
+        << hierarchy.memory_bytes() / 1024 << " KB" << std::endl;
+
+    const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+    struct Row {
+        const char* name;
+        std::function<bool(const Vec2D&, const Vec2D&, std::vector<Vec2D>&)> search;
+    };
+    const Row rows[] = {
+        {"astar", [&](const Vec2D& a, const Vec2D& b, std::vector<Vec2D>& p) {
+             return find_path_astar(a, b, world, p); }},
+        {"astar-chebyshev", [&](const Vec2D& a, const Vec2D& b, std::vector<Vec2D>& p) {
+             return find_path<PathPolicies::ChebyshevHeuristic>(a, b, world, p); }},
+        {"hpa (full path)", [&](const Vec2D& a, const Vec2D& b, std::vector<Vec2D>& p) {
+             return find_path_hierarchical(a, b, world, p, INT_MAX); }},
+        {"hpa (first 32)", [&](const Vec2D& a, const Vec2D& b, std::vector<Vec2D>& p) {
+             return find_path_hierarchical(a, b, world, p); }},
+    };
+    out << "  " << query_count << " reachable queries up to " << max_offset << " cells apart per axis" << std::endl;
+    out << std::setw(18) << "search" << std::setw(12) << "us/query" << std::setw(14) << "path length"
+        << std::setw(10) << "found" << std::endl;
+    std::vector<Vec2D> path;
+    for (const Row& row : rows) {
+        size_t total_length = 0;
+        int found = 0;
+        auto run_queries = [&]() {
+            total_length = 0;
+            found = 0;
+            for (const auto& query : queries) {
+                found += row.search(query.first, query.second, path) ? 1 : 0;
+                total_length += path.size();
+            }
+        };
+        run_queries(); // Warm the search pages
+        const double total_ms = time_ms(run_queries);
+        out << std::setw(18) << row.name << std::setw(12) << total_ms * 1000.0 / query_count
+            << std::setw(14) << total_length << std::setw(10) << found << std::endl;
+    }
+
+    // Short walls placed and removed again: only the clusters they touch are rebuilt
+    std::mt19937 rng(BENCHMARK_SEED);
+    std::uniform_int_distribution<> coordinate(1, size - 8);
+    std::vector<Vec2D> wall;
+    double edit_ms = 0.0;
+    for (int edit = 0; edit < edit_count; ++edit) {
+        const bool placing = wall.empty();
+        if (placing) {
+            const Vec2D origin = {coordinate(rng), coordinate(rng)};
+            for (int i = 0; i < 6; ++i) {
+                if (world.is_walkable({origin.x + i, origin.y})) {
+                    wall.push_back({origin.x + i, origin.y});
+                }
+            }
+        }
+        edit_ms += time_ms([&]() { world.set_obstacles(wall, placing); });
+        if (!placing) {
+            wall.clear();
+        }
+    }
+    out << "  Wall edit with hierarchy update: " << std::setprecision(3) << edit_ms / edit_count
+        << " ms per edit (full rebuild " << std::setprecision(1) << build_ms << " ms)" << std::endl;
+}
+
+void run_path_cache(std::ostream& out) {
+    const int size = 1024;
+    const int chaser_count = 20;
+    const int goal_count = 4;
+    const int tick_count = 200;
+    const int replan_interval = 2; // Same as the predators' REPLAN_PATH_INTERVAL
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    std::mt19937 rng(BENCHMARK_SEED);
+
+    // Chasers spread around a few shared goals, like predators after the same prey
+    // or the same last known position
+    const auto goal_queries = make_queries(world, goal_count, 150, BENCHMARK_SEED);
+    std::vector<Vec2D> goals;
+    std::vector<Vec2D> starts;
+    std::uniform_int_distribution<> offset(-100, 100);
+    for (const auto& query : goal_queries) {
+        goals.push_back(query.second);
+    }
+    while (static_cast<int>(starts.size()) < chaser_count) {
+        const Vec2D& goal = goals[starts.size() % goals.size()];
+        const Vec2D start = {std::max(1, std::min(size - 2, goal.x + offset(rng))),
+                             std::max(1, std::min(size - 2, goal.y + offset(rng)))};
+        if (world.is_reachable(start, goal) && start != goal) {
+            starts.push_back(start);
+        }
+    }
+
+    out << "Path cache (" << size << "^2, " << chaser_count << " chasers after " << goal_count
+        << " goals, replanning every " << replan_interval << " ticks for " << tick_count << " ticks)" << std::endl;
+    out << std::setw(8) << "engine" << std::setw(10) << "capacity" << std::setw(12) << "total ms" << std::setw(10)
+        << "hits" << std::setw(14) << "suffix hits" << std::setw(10) << "misses" << std::setw(12) << "hit rate"
+        << std::setw(10) << "arrived" << std::endl;
+    // HPA* hands back only the first stretch of a route, which must not be cached as the whole route
+    const PathEngine previous_engine = get_active_path_engine();
+    world.build_path_hierarchy();
+    for (PathEngine engine : {PathEngine::ASTAR, PathEngine::HPA}) {
+        set_active_path_engine(engine);
+        for (size_t capacity : {size_t{0}, PathCache::DEFAULT_CAPACITY}) {
+            PathCache cache(capacity);
+            std::vector<Vec2D> positions = starts;
+            std::vector<std::vector<Vec2D>> paths(chaser_count);
+            std::vector<size_t> next_step(chaser_count, 0);
+            double plan_ms = 0.0;
+            for (int tick = 0; tick < tick_count; ++tick) {
+                for (int i = 0; i < chaser_count; ++i) {
+                    const Vec2D& goal = goals[i % goal_count];
+                    if (tick % replan_interval == 0 && positions[i] != goal) {
+                        plan_ms += time_ms([&]() { cache.find_path(positions[i], goal, world, paths[i]); });
+                        next_step[i] = 1;
+                    }
+                    if (next_step[i] < paths[i].size()) {
+                        positions[i] = paths[i][next_step[i]++];
+                    }
+                }
+            }
+            int arrived = 0;
+            for (int i = 0; i < chaser_count; ++i) {
+                arrived += positions[i] == goals[i % goal_count] ? 1 : 0;
+            }
+            const PathCache::Stats stats = cache.stats();
+            const uint64_t lookups = stats.hits + stats.suffix_hits + stats.misses;
+            out << std::setw(8) << path_engine_name(engine) << std::setw(10) << capacity << std::fixed
+                << std::setprecision(1) << std::setw(12) << plan_ms << std::setw(10) << stats.hits << std::setw(14)
+                << stats.suffix_hits << std::setw(10) << stats.misses << std::setw(11)
+                << (lookups > 0 ? 100.0 * (stats.hits + stats.suffix_hits) / lookups : 0.0) << "%" << std::setw(10)
+                << (std::to_string(arrived) + " / " + std::to_string(chaser_count)) << std::endl;
+        }
+    }
+    set_active_path_engine(previous_engine);
+}
+
+void run_incremental_replanning(std::ostream& out) {
+    const int size = 1024;
+    const int chaser_count = 20;
+    const int tick_count = 200;
+    const int wall_interval = 10; // Ticks between wall edits
+    const int wall_length = 6;
+
+    // Each chaser starts up to 100 cells from its own target, which wanders a cell
+    // most ticks; the chaser steps along its path and replans every tick
+    World base(size, size);
+    base.initialize_obstacles(BENCHMARK_SEED);
+    const auto queries = make_queries(base, chaser_count, 300, BENCHMARK_SEED);
+
+    out << "Incremental replanning (" << size << "^2, " << chaser_count << " chasers after moving targets, "
+        << tick_count << " ticks, a " << wall_length << "-cell wall every " << wall_interval << " ticks)"
+        << std::endl;
+    out << std::setw(22) << "planner" << std::setw(12) << "total ms" << std::setw(12) << "us/plan"
+        << std::setw(14) << "expanded/plan" << std::setw(12) << "mean steps" << std::setw(10) << "resets"
+        << std::endl;
+
+    enum class Planner { ASTAR, ASTAR_CHEBYSHEV, INCREMENTAL };
+    const std::pair<Planner, const char*> planners[] = {{Planner::ASTAR, "fresh astar"},
+                                                        {Planner::ASTAR_CHEBYSHEV, "fresh astar-chebyshev"},
+                                                        {Planner::INCREMENTAL, "incremental"}};
+    for (const auto& entry : planners) {
+        World world(size, size);
+        world.initialize_obstacles(BENCHMARK_SEED);
+        std::mt19937 rng(BENCHMARK_SEED); // Same target walks and walls for every planner
+        std::vector<IncrementalPlanner> incremental(chaser_count);
+        std::vector<Vec2D> chasers;
+        std::vector<Vec2D> targets;
+        for (const auto& query : queries) {
+            chasers.push_back(query.first);
+            targets.push_back(query.second);
+        }
+
+        std::vector<Vec2D> path;
+        double plan_ms = 0.0;
+        size_t plans = 0;
+        size_t expanded = 0;
+        size_t steps = 0;
+        size_t resets = 0;
+        for (int tick = 0; tick < tick_count; ++tick) {
+            if (tick % wall_interval == wall_interval - 1) {
+                // A short wall across a random chaser's surroundings
+                const Vec2D& near = chasers[rng() % chaser_count];
+                const Vec2D corner = {near.x + static_cast<int>(rng() % 21) - 10,
+                                      near.y + static_cast<int>(rng() % 21) - 10};
+                std::vector<Vec2D> wall;
+                for (int i = 0; i < wall_length; ++i) {
+                    const Vec2D cell = (rng() % 2) ? Vec2D{corner.x + i, corner.y} : Vec2D{corner.x, corner.y + i};
+                    if (world.is_walkable(cell) && std::find(chasers.begin(), chasers.end(), cell) == chasers.end() &&
+                        std::find(targets.begin(), targets.end(), cell) == targets.end()) {
+                        wall.push_back(cell);
+                    }
+                }
+                world.set_obstacles(wall, true);
+            }
+            for (int i = 0; i < chaser_count; ++i) {
+                const Vec2D offset = World::NEIGHBOR_OFFSETS[rng() % 8];
+                const Vec2D moved = {targets[i].x + offset.x, targets[i].y + offset.y};
+                if (world.is_walkable(moved)) {
+                    targets[i] = moved;
+                }
+                if (chasers[i] == targets[i]) {
+                    continue;
+                }
+
+                bool found = false;
+                plan_ms += time_ms([&]() {
+                    switch (entry.first) {
+                    case Planner::ASTAR:
+                        found = find_path_astar(chasers[i], targets[i], world, path);
+                        break;
+                    case Planner::ASTAR_CHEBYSHEV:
+                        found = find_path<PathPolicies::ChebyshevHeuristic>(chasers[i], targets[i], world, path);
+                        break;
+                    case Planner::INCREMENTAL:
+                        found = incremental[i].plan(chasers[i], targets[i], world, path);
+                        break;
+                    }
+                });
+                plans++;
+                expanded += entry.first == Planner::INCREMENTAL ? incremental[i].expanded_count()
+                                                                : PathSearchContext::for_this_thread().expanded_count();
+                if (found) {
+                    steps += path.size() - 1;
+                    chasers[i] = path.size() > 1 ? path[1] : chasers[i];
+                }
+            }
+        }
+        for (const IncrementalPlanner& planner : incremental) {
+            resets += planner.reset_count();
+        }
+        out << std::setw(22) << entry.second << std::fixed << std::setprecision(1) << std::setw(12) << plan_ms
+            << std::setw(12) << (plans > 0 ? 1000.0 * plan_ms / plans : 0.0) << std::setw(14)
+            << (plans > 0 ? static_cast<double>(expanded) / plans : 0.0) << std::setw(12)
+            << (plans > 0 ? static_cast<double>(steps) / plans : 0.0) << std::setw(10) << resets << std::endl;
+    }
+}
+
+void run_multi_goal(std::ostream& out) {
+    const int size = 1024;
+    const int query_count = 200;
+    const int max_offset = 60;
+    const int goal_counts[] = {4, 16, 64};
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+    std::mt19937 rng(BENCHMARK_SEED);
+    std::uniform_int_distribution<> offset(-max_offset, max_offset);
+
+    out << "Nearest of several goals (" << size << "^2, " << query_count << " starts, goals within " << max_offset
+        << " cells): one find_path<Chebyshev> per goal vs find_path_to_any" << std::endl;
+    out << std::setw(8) << "goals" << std::setw(16) << "per-goal ms" << std::setw(18) << "per-goal expanded"
+        << std::setw(12) << "any ms" << std::setw(14) << "any expanded" << std::setw(12) << "same steps" << std::endl;
+    for (int goal_count : goal_counts) {
+        std::vector<std::vector<Vec2D>> goal_sets;
+        for (const auto& query : queries) {
+            std::vector<Vec2D> goals;
+            while (static_cast<int>(goals.size()) < goal_count) {
+                const Vec2D goal = {std::max(0, std::min(size - 1, query.first.x + offset(rng))),
+                                    std::max(0, std::min(size - 1, query.first.y + offset(rng)))};
+                if (world.is_walkable(goal)) {
+                    goals.push_back(goal);
+                }
+            }
+            goal_sets.push_back(goals);
+        }
+
+        std::vector<Vec2D> path;
+        std::vector<size_t> loop_steps;
+        std::vector<size_t> any_steps;
+        size_t loop_expanded = 0;
+        size_t any_expanded = 0;
+        const double loop_ms = time_ms([&]() {
+            for (size_t q = 0; q < queries.size(); ++q) {
+                size_t best = 0;
+                for (const Vec2D& goal : goal_sets[q]) {
+                    if (find_path<PathPolicies::ChebyshevHeuristic>(queries[q].first, goal, world, path) &&
+                        (best == 0 || path.size() < best)) {
+                        best = path.size();
+                    }
+                    loop_expanded += PathSearchContext::for_this_thread().expanded_count();
+                }
+                loop_steps.push_back(best);
+            }
+        });
+        const double any_ms = time_ms([&]() {
+            for (size_t q = 0; q < queries.size(); ++q) {
+                const bool found = find_path_to_any(queries[q].first, goal_sets[q], world, path) >= 0;
+                any_expanded += PathSearchContext::for_this_thread().expanded_count();
+                any_steps.push_back(found ? path.size() : 0);
+            }
+        });
+        size_t same = 0;
+        for (size_t q = 0; q < queries.size(); ++q) {
+            same += loop_steps[q] == any_steps[q] ? 1 : 0;
+        }
+        out << std::setw(8) << goal_count << std::fixed << std::setprecision(1) << std::setw(16) << loop_ms
+            << std::setw(18) << loop_expanded << std::setw(12) << any_ms << std::setw(14) << any_expanded
+            << std::setw(8) << same << " / " << queries.size() << std::endl;
+    }
+}
+
+void run_flow_fields(std::ostream& out) {
+    const int size = 1024;
+    const int tick_count = 20;
+    const int spread = 50; // Chasers start up to this many cells from the target per axis
+    const int chaser_counts[] = {1, 4, 16, 64, 256};
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const Vec2D first_target = make_queries(world, 1, 1, BENCHMARK_SEED).front().first;
+
+    out << "Flow fields (" << size << "^2, chasers within " << spread << " cells of one moving target, "
+        << tick_count << " ticks, radius " << FlowFieldCache::DEFAULT_RADIUS << ")" << std::endl;
+    out << std::setw(10) << "chasers" << std::setw(18) << "find_path ms/tick" << std::setw(20)
+        << "flow field ms/tick" << std::setw(16) << "cells/field" << std::setw(14) << "same steps" << std::endl;
+    for (int chaser_count : chaser_counts) {
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::uniform_int_distribution<> offset(-spread, spread);
+        std::vector<Vec2D> chasers;
+        while (static_cast<int>(chasers.size()) < chaser_count) {
+            const Vec2D chaser = {first_target.x + offset(rng), first_target.y + offset(rng)};
+            if (world.is_walkable(chaser) && world.is_reachable(chaser, first_target)) {
+                chasers.push_back(chaser);
+            }
+        }
+
+        FlowFieldCache cache;
+        cache.set_radius(FlowFieldCache::DEFAULT_RADIUS);
+        Vec2D target = first_target;
+        std::vector<Vec2D> path;
+        std::vector<size_t> search_steps;
+        std::vector<size_t> field_steps;
+        double search_ms = 0.0;
+        double field_ms = 0.0;
+        size_t reached = 0;
+        for (int tick = 0; tick < tick_count; ++tick) {
+            const Vec2D step = World::NEIGHBOR_OFFSETS[rng() % 8];
+            if (world.is_walkable({target.x + step.x, target.y + step.y})) {
+                target = {target.x + step.x, target.y + step.y};
+            }
+            search_ms += time_ms([&]() {
+                for (const Vec2D& chaser : chasers) {
+                    find_path<PathPolicies::ChebyshevHeuristic>(chaser, target, world, path);
+                    search_steps.push_back(path.size());
+                }
+            });
+            field_ms += time_ms([&]() {
+                cache.begin_tick();
+                for (const Vec2D& chaser : chasers) {
+                    cache.field_for(target, world).route(chaser, path);
+                    field_steps.push_back(path.size());
+                }
+            });
+            reached += cache.field_for(target, world).reached_count();
+        }
+        size_t same = 0;
+        for (size_t i = 0; i < search_steps.size(); ++i) {
+            same += search_steps[i] == field_steps[i] ? 1 : 0;
+        }
+        out << std::setw(10) << chaser_count << std::fixed << std::setprecision(3) << std::setw(18)
+            << search_ms / tick_count << std::setw(20) << field_ms / tick_count << std::setw(16)
+            << reached / tick_count << std::setw(8) << same << " / " << search_steps.size() << std::endl;
+    }
+}
+
+// Random horizontal and vertical wall segments, so routes have to go around
+static void add_long_walls(World& world, int wall_count, int wall_length, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> x_dist(1, world.width - 2);
+    std::uniform_int_distribution<> y_dist(1, world.height - 2);
+    std::vector<Vec2D> walls;
+    for (int i = 0; i < wall_count; ++i) {
+        const Vec2D origin = {x_dist(rng), y_dist(rng)};
+        const bool horizontal = (rng() & 1) != 0;
+        for (int j = 0; j < wall_length; ++j) {
+            const Vec2D cell = {origin.x + (horizontal ? j : 0), origin.y + (horizontal ? 0 : j)};
+            if (cell.x < world.width - 1 && cell.y < world.height - 1) {
+                walls.push_back(cell);
+            }
+        }
+    }
+    world.set_obstacles(walls, true);
+}
+
+void run_bidirectional(std::ostream& out) {
+    const int size = 1024;
+    const int query_count = 600;
+    const int max_offset = 200;
+    const int wall_count = 600;
+    const int wall_length = 64;
+    const char* bucket_names[] = {"open", "goal boxed in", "start boxed in"};
+    const int bucket_count = 3;
+
+    out << "Bidirectional A* (" << size << "^2, " << query_count << " reachable queries up to " << max_offset
+        << " cells apart per axis; an end is boxed in when A* toward it expands over twice the cells A* from it does)"
+        << std::endl;
+    out << std::setw(10) << "map" << std::setw(16) << "queries" << std::setw(8) << "count" << std::setw(18) << "engine"
+        << std::setw(12) << "us/query" << std::setw(16) << "expanded/query" << std::setw(14) << "path length"
+        << std::endl;
+
+    // The generated map as is, then with long wall segments added so routes have to go around
+    for (int walled = 0; walled < 2; ++walled) {
+        World world(size, size);
+        world.initialize_obstacles(BENCHMARK_SEED);
+        if (walled) {
+            add_long_walls(world, wall_count, wall_length, BENCHMARK_SEED);
+        }
+        const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+
+        // Sort queries by which end a one-way search has trouble reaching
+        std::vector<Vec2D> path;
+        std::vector<int> bucket_of;
+        std::vector<int> bucket_sizes(bucket_count, 0);
+        for (const auto& query : queries) {
+            find_path<PathPolicies::ChebyshevHeuristic>(query.first, query.second, world, path);
+            const size_t toward_goal = PathSearchContext::for_this_thread().expanded_count();
+            find_path<PathPolicies::ChebyshevHeuristic>(query.second, query.first, world, path);
+            const size_t toward_start = PathSearchContext::for_this_thread().expanded_count();
+            const int bucket = toward_goal > 2 * toward_start ? 1 : toward_start > 2 * toward_goal ? 2 : 0;
+            bucket_of.push_back(bucket);
+            bucket_sizes[bucket]++;
+        }
+
+        struct Engine {
+            const char* name;
+            std::function<bool(const Vec2D&, const Vec2D&, std::vector<Vec2D>&)> search;
+            std::function<size_t()> expanded;
+        };
+        const Engine engines[] = {
+            {"astar", [&](const Vec2D& a, const Vec2D& b, std::vector<Vec2D>& p) {
+                 return find_path_astar(a, b, world, p); },
+             []() { return PathSearchContext::for_this_thread().expanded_count(); }},
+            {"astar-chebyshev", [&](const Vec2D& a, const Vec2D& b, std::vector<Vec2D>& p) {
+                 return find_path<PathPolicies::ChebyshevHeuristic>(a, b, world, p); },
+             []() { return PathSearchContext::for_this_thread().expanded_count(); }},
+            {"bidirectional", [&](const Vec2D& a, const Vec2D& b, std::vector<Vec2D>& p) {
+                 return find_path_bidirectional(a, b, world, p); },
+             []() { return bidirectional_expanded_count(); }},
+        };
+        for (int bucket = 0; bucket < bucket_count; ++bucket) {
+            if (bucket_sizes[bucket] == 0) {
+                continue;
+            }
+            for (const Engine& engine : engines) {
+                size_t expanded = 0;
+                size_t total_length = 0;
+                auto run_queries = [&]() {
+                    expanded = 0;
+                    total_length = 0;
+                    for (size_t q = 0; q < queries.size(); ++q) {
+                        if (bucket_of[q] == bucket) {
+                            engine.search(queries[q].first, queries[q].second, path);
+                            expanded += engine.expanded();
+                            total_length += path.size();
+                        }
+                    }
+                };
+                run_queries(); // Warm the search pages
+                const double total_ms = time_ms(run_queries);
+                out << std::setw(10) << (walled ? "walled" : "generated") << std::setw(16) << bucket_names[bucket]
+                    << std::setw(8) << bucket_sizes[bucket] << std::setw(18) << engine.name
+                    << std::fixed << std::setprecision(1)
+                    << std::setw(12) << total_ms * 1000.0 / bucket_sizes[bucket]
+                    << std::setw(16) << static_cast<double>(expanded) / bucket_sizes[bucket]
+                    << std::setw(14) << total_length << std::endl;
+            }
+        }
+    }
+}
+
+void run_path_budget(std::ostream& out) {
+    const int size = 1024;
+    const int query_count = 100;
+    const int max_offset = 400;
+    const size_t budgets[] = {1024, 4096, 16384};
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    add_long_walls(world, 600, 64, BENCHMARK_SEED);
+    const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+
+    out << "Budgeted search (" << size << "^2 with long walls, " << query_count << " reachable queries up to "
+        << max_offset << " cells apart per axis): longest single call, and calls (ticks) until the path is found"
+        << std::endl;
+    out << std::setw(10) << "budget" << std::setw(14) << "max ms/call" << std::setw(14) << "avg ms/query"
+        << std::setw(12) << "avg calls" << std::setw(12) << "max calls" << std::setw(12) << "found" << std::endl;
+
+    // Warm the search pages of both the one-shot search and the resumable one
+    std::vector<Vec2D> path;
+    BudgetedSearch search;
+    for (const auto& query : queries) {
+        find_path_budgeted(query.first, query.second, world, path, SIZE_MAX);
+        search.start(query.first, query.second, world);
+        search.resume(query.first, SIZE_MAX, path);
+    }
+
+    std::vector<size_t> reference_steps;
+    double longest_ms = 0.0;
+    const double unlimited_ms = time_ms([&]() {
+        for (const auto& query : queries) {
+            const double call_ms = time_ms([&]() {
+                find_path_budgeted(query.first, query.second, world, path, SIZE_MAX);
+            });
+            longest_ms = std::max(longest_ms, call_ms);
+            reference_steps.push_back(path.size());
+        }
+    });
+    out << std::setw(10) << "none" << std::fixed << std::setprecision(3) << std::setw(14) << longest_ms
+        << std::setw(14) << unlimited_ms / query_count << std::setw(12) << 1.0 << std::setw(12) << 1
+        << std::setw(8) << query_count << " / " << query_count << std::endl;
+
+    for (size_t budget : budgets) {
+        longest_ms = 0.0;
+        size_t total_calls = 0;
+        size_t most_calls = 0;
+        int same_steps = 0;
+        const double total_ms = time_ms([&]() {
+            for (size_t q = 0; q < queries.size(); ++q) {
+                search.start(queries[q].first, queries[q].second, world);
+                size_t calls = 0;
+                PathStatus status = PathStatus::PARTIAL;
+                while (status == PathStatus::PARTIAL) {
+                    const double call_ms = time_ms([&]() {
+                        status = search.resume(queries[q].first, budget, path);
+                    });
+                    longest_ms = std::max(longest_ms, call_ms);
+                    calls++;
+                }
+                total_calls += calls;
+                most_calls = std::max(most_calls, calls);
+                same_steps += status == PathStatus::FOUND && path.size() == reference_steps[q] ? 1 : 0;
+            }
+        });
+        out << std::setw(10) << budget << std::fixed << std::setprecision(3) << std::setw(14) << longest_ms
+            << std::setw(14) << total_ms / query_count << std::setw(12)
+            << static_cast<double>(total_calls) / query_count << std::setw(12) << most_calls
+            << std::setw(8) << same_steps << " / " << query_count << std::endl;
+    }
+}
+
+void run_path_service(std::ostream& out) {
+    const int size = 1024;
+    const int query_count = 64;
+    const int requests_per_query = 2; // Chasers standing on the same cell after the same prey
+    const int max_offset = 200;
+    const int tick_count = 10;
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    add_long_walls(world, 600, 64, BENCHMARK_SEED);
+    const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+    const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    out << "Path service (" << size << "^2 with long walls, " << query_count * requests_per_query
+        << " chase requests per tick, " << query_count << " distinct; " << hardware_threads
+        << " hardware threads): time per tick" << std::endl;
+    out << std::setw(10) << "workers" << std::setw(16) << "sim thread ms" << std::setw(14) << "results ms"
+        << std::setw(12) << "searches" << std::setw(12) << "same steps" << std::endl;
+
+    PathService::Search search_for[query_count];
+    for (int q = 0; q < query_count; ++q) {
+        const Vec2D start = queries[q].first;
+        const Vec2D goal = queries[q].second;
+        search_for[q] = [start, goal](const World& searched, std::vector<Vec2D>& path) {
+            return find_path(start, goal, searched, path) ? PathStatus::FOUND : PathStatus::NO_PATH;
+        };
+    }
+
+    std::vector<size_t> reference_steps;
+    const size_t worker_counts[] = {0, 1, 2, 4, hardware_threads};
+    for (size_t workers : worker_counts) {
+        PathService service;
+        service.set_thread_count(workers);
+        double requesting_ms = 0.0; // Simulation thread: request() and dispatch()
+        double results_ms = 0.0;    // Until every ticket is ready (sync() included)
+        int same_steps = 0;
+        std::vector<std::shared_ptr<PathService::Ticket>> tickets;
+        for (int tick = 0; tick < tick_count; ++tick) {
+            tickets.clear();
+            const double tick_requesting_ms = time_ms([&]() {
+                for (int q = 0; q < query_count; ++q) {
+                    for (int r = 0; r < requests_per_query; ++r) {
+                        tickets.push_back(service.request(queries[q].first, queries[q].second, world, search_for[q]));
+                    }
+                }
+                service.dispatch(world);
+            });
+            requesting_ms += tick_requesting_ms;
+            results_ms += tick_requesting_ms + time_ms([&]() { service.sync(); });
+        }
+        for (size_t t = 0; t < tickets.size(); ++t) {
+            if (workers == 0) {
+                reference_steps.push_back(tickets[t]->path.size());
+            }
+            same_steps += tickets[t]->ready && tickets[t]->path.size() == reference_steps[t] ? 1 : 0;
+        }
+        out << std::setw(10) << workers << std::fixed << std::setprecision(3) << std::setw(16)
+            << requesting_ms / tick_count << std::setw(14) << results_ms / tick_count << std::setw(12)
+            << service.stats().searches / tick_count << std::setw(6) << same_steps << " / " << tickets.size()
+            << std::endl;
+    }
+}
+
+void run_any_angle(std::ostream& out) {
+    const int size = 1024;
+    const int query_count = 200;
+    const int max_offset = 200;
+    const int validation_rounds = 20;
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const auto queries = make_queries(world, query_count, max_offset, BENCHMARK_SEED);
+
+    std::vector<std::vector<Vec2D>> step_paths(queries.size());
+    std::vector<std::vector<Vec2D>> waypoint_paths(queries.size());
+    auto search_steps = [&]() {
+        for (size_t q = 0; q < queries.size(); ++q) {
+            find_path<PathPolicies::OctileHeuristic, PathPolicies::OctileCost>(queries[q].first, queries[q].second,
+                                                                               world, step_paths[q]);
+        }
+    };
+    auto search_waypoints = [&]() {
+        for (size_t q = 0; q < queries.size(); ++q) {
+            find_waypoints_theta(queries[q].first, queries[q].second, world, waypoint_paths[q]);
+        }
+    };
+    search_steps(); // Warm the search pages
+    const double steps_search_ms = time_ms(search_steps);
+    const double waypoints_search_ms = time_ms(search_waypoints);
+
+    int valid_steps = 0;
+    int valid_waypoints = 0;
+    const double steps_validate_ms = time_ms([&]() {
+        for (int round = 0; round < validation_rounds; ++round) {
+            for (auto& path : step_paths) {
+                valid_steps += PathfindingHelpers::validate_and_repair_path(path, world) ? 1 : 0;
+            }
+        }
+    });
+    const double waypoints_validate_ms = time_ms([&]() {
+        for (int round = 0; round < validation_rounds; ++round) {
+            for (const auto& path : waypoint_paths) {
+                valid_waypoints += PathfindingHelpers::validate_waypoint_path(path, world) ? 1 : 0;
+            }
+        }
+    });
+
+    // Entries stored, moves walked and geometric length of each kind of path
+    auto summarize = [&](const std::vector<std::vector<Vec2D>>& paths, bool waypoints, size_t& entries, size_t& moves,
+                         double& length) {
+        entries = 0;
+        moves = 0;
+        length = 0.0;
+        for (const auto& path : paths) {
+            entries += path.size();
+            for (size_t i = 1; i < path.size(); ++i) {
+                const int dx = std::abs(path[i].x - path[i - 1].x);
+                const int dy = std::abs(path[i].y - path[i - 1].y);
+                moves += waypoints ? std::max(dx, dy) : 1;
+                length += std::sqrt(static_cast<double>(dx * dx + dy * dy));
+            }
+        }
+    };
+    size_t entries[2];
+    size_t moves[2];
+    double length[2];
+    summarize(step_paths, false, entries[0], moves[0], length[0]);
+    summarize(waypoint_paths, true, entries[1], moves[1], length[1]);
+
+    out << "Any-angle paths (" << size << "^2, " << query_count << " reachable queries up to " << max_offset
+        << " cells apart per axis): octile A* steps against Theta* waypoints" << std::endl;
+    out << std::setw(12) << "path" << std::setw(12) << "us/query" << std::setw(14) << "entries/path"
+        << std::setw(12) << "bytes/path" << std::setw(16) << "validate us" << std::setw(10) << "moves"
+        << std::setw(12) << "geometric" << std::setw(8) << "valid" << std::endl;
+    const char* names[] = {"steps", "waypoints"};
+    const double search_ms[] = {steps_search_ms, waypoints_search_ms};
+    const double validate_ms[] = {steps_validate_ms, waypoints_validate_ms};
+    const int valid[] = {valid_steps, valid_waypoints};
+    for (int row = 0; row < 2; ++row) {
+        out << std::setw(12) << names[row] << std::fixed << std::setprecision(1)
+            << std::setw(12) << search_ms[row] * 1000.0 / query_count
+            << std::setw(14) << static_cast<double>(entries[row]) / query_count
+            << std::setw(12) << static_cast<double>(entries[row] * sizeof(Vec2D)) / query_count
+            << std::setprecision(2) << std::setw(16) << validate_ms[row] * 1000.0 / (query_count * validation_rounds)
+            << std::setw(10) << moves[row] << std::setprecision(1) << std::setw(12) << length[row]
+            << std::setw(8) << valid[row] / validation_rounds << std::endl;
+    }
+
+    // Starts on a wall next to a query's start (a sprite a new wall landed on), which
+    // is_reachable accepts: both searches must return, and agree on whether there is a path
+    int blocked_queries = 0;
+    int steps_found = 0;
+    int waypoints_found = 0;
+    int agree = 0;
+    std::vector<Vec2D> step_path;
+    std::vector<Vec2D> waypoint_path;
+    for (const auto& query : queries) {
+        for (const auto& offset : World::NEIGHBOR_OFFSETS) {
+            const Vec2D start = {query.first.x + offset.x, query.first.y + offset.y};
+            if (world.is_walkable(start) || !world.is_reachable(start, query.second)) {
+                continue;
+            }
+            const bool steps_ok = find_path<PathPolicies::OctileHeuristic, PathPolicies::OctileCost>(
+                start, query.second, world, step_path);
+            const bool waypoints_ok = find_waypoints_theta(start, query.second, world, waypoint_path);
+            blocked_queries++;
+            steps_found += steps_ok ? 1 : 0;
+            waypoints_found += waypoints_ok ? 1 : 0;
+            agree += steps_ok == waypoints_ok ? 1 : 0;
+            break;
+        }
+    }
+    out << "  blocked starts: " << blocked_queries << " queries, " << steps_found << " found by octile A*, "
+        << waypoints_found << " by Theta*, " << agree << " agree" << std::endl;
+}
+
+void run_path_repair(std::ostream& out) {
+    const int size = 1024;
+    const int path_count = 200;
+    const int max_offset = 200;
+    const int wall_length = 7;
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const auto queries = make_queries(world, path_count, max_offset, BENCHMARK_SEED);
+
+    struct RepairRun {
+        int blocked = 0;
+        int repaired = 0;
+        int replanned = 0;
+        long long repaired_steps = 0;  // Over the paths both approaches fixed
+        long long replanned_steps = 0;
+        double repair_ms = 0.0;
+        double replan_ms = 0.0;
+    };
+    std::vector<Vec2D> path;
+    std::vector<Vec2D> repaired;
+    std::vector<Vec2D> wall;
+    auto cut_paths = [&]() {
+        RepairRun run;
+        std::mt19937 rng(BENCHMARK_SEED);
+        for (const auto& query : queries) {
+            if (!find_path(query.first, query.second, world, path) || path.size() < 8) {
+                continue;
+            }
+            // Wall across the path somewhere between its ends, at right angles to the step there
+            const size_t cut = 2 + rng() % (path.size() - 4);
+            const Vec2D along = {path[cut + 1].x - path[cut].x, path[cut + 1].y - path[cut].y};
+            const Vec2D across = along.x != 0 && along.y != 0 ? Vec2D{along.x, -along.y}
+                                                               : Vec2D{along.y != 0 ? 1 : 0, along.x != 0 ? 1 : 0};
+            wall.clear();
+            for (int i = -wall_length / 2; i <= wall_length / 2; ++i) {
+                const Vec2D cell = {path[cut].x + across.x * i, path[cut].y + across.y * i};
+                if (world.is_walkable(cell) && cell != query.first && cell != query.second) {
+                    wall.push_back(cell);
+                }
+            }
+            world.set_obstacles(wall, true);
+            run.blocked++;
+
+            repaired = path;
+            bool fixed = false;
+            bool found = false;
+            run.repair_ms += time_ms([&]() { fixed = PathfindingHelpers::validate_and_repair_path(repaired, world); });
+            run.replan_ms += time_ms([&]() { found = find_path(query.first, query.second, world, path); });
+            run.repaired += fixed ? 1 : 0;
+            run.replanned += found ? 1 : 0;
+            if (fixed && found) {
+                run.repaired_steps += static_cast<long long>(repaired.size());
+                run.replanned_steps += static_cast<long long>(path.size());
+            }
+            world.set_obstacles(wall, false);
+        }
+        return run;
+    };
+    cut_paths(); // Allocates the search pages of both approaches where the cuts are
+    const RepairRun run = cut_paths();
+
+    out << "Path repair (" << size << "^2, " << run.blocked << " paths up to " << max_offset
+        << " cells apart per axis, each cut by a " << wall_length << "-cell wall)" << std::endl;
+    out << std::fixed << std::setprecision(1)
+        << "  local repair " << run.repair_ms * 1000.0 / run.blocked << " us avg, " << run.repaired << " repaired; "
+        << "full replan " << run.replan_ms * 1000.0 / run.blocked << " us avg, " << run.replanned << " found"
+        << std::endl;
+    out << "  repaired paths are "
+        << (run.replanned_steps > 0 ? 100.0 * (run.repaired_steps - run.replanned_steps) / run.replanned_steps : 0.0)
+        << "% longer than replanned ones" << std::endl;
+}
+
+void run_visibility(std::ostream& out) {
+    const int size = 512;
+    const int pair_count = 20000;
+    const int edit_count = 100;
+    const int wall_length = 6;
+    const int awareness_radius = 5; // PreyAI's PREY_AWARENESS_RADIUS
+    const size_t prey_per_predator = 50;
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    std::mt19937 rng(BENCHMARK_SEED);
+    std::uniform_int_distribution<> coordinate(1, size - 2);
+    std::uniform_int_distribution<> offset(-awareness_radius, awareness_radius);
+
+    // Predator / prey pairs close enough for the prey to notice, as update_prey sees them:
+    // a few hundred predators with the prey around them (checked against the closest one)
+    std::vector<std::pair<Vec2D, Vec2D>> pairs;
+    Vec2D predator = {0, 0};
+    while (static_cast<int>(pairs.size()) < pair_count) {
+        if (pairs.size() % prey_per_predator == 0) {
+            do {
+                predator = {coordinate(rng), coordinate(rng)};
+            } while (!world.is_walkable(predator));
+        }
+        const Vec2D prey = {predator.x + offset(rng), predator.y + offset(rng)};
+        if (world.is_walkable(prey) && PathfindingHelpers::manhattan_distance(predator, prey) <= awareness_radius) {
+            pairs.push_back({predator, prey});
+        }
+    }
+
+    // One prey update: the awareness check, then the nine flee candidates
+    long long visible = 0; // Keeps the checks from being optimized away
+    auto check_pairs = [&](const std::function<bool(const Vec2D&, const Vec2D&)>& sees) {
+        for (const auto& pair : pairs) {
+            visible += sees(pair.first, pair.second) ? 1 : 0;
+            for (const Vec2D& step : World::NEIGHBOR_OFFSETS) {
+                const Vec2D candidate = {pair.second.x + step.x, pair.second.y + step.y};
+                if (world.is_walkable(candidate)) {
+                    visible += sees(pair.first, candidate) ? 1 : 0;
+                }
+            }
+            visible += sees(pair.first, pair.second) ? 1 : 0; // Staying put
+        }
+    };
+    auto bresenham = [&](const Vec2D& from, const Vec2D& to) {
+        return PathfindingHelpers::has_line_of_sight(from, to, world);
+    };
+    auto cached = [&](const Vec2D& from, const Vec2D& to) { return PathfindingHelpers::can_see(from, to, world); };
+
+    check_pairs(bresenham); // Warms the obstacle chunks for both
+    const double bresenham_ms = time_ms([&]() { check_pairs(bresenham); });
+    const double cold_ms = time_ms([&]() { check_pairs(cached); });
+    const size_t masks_built = world.visibility.built_count();
+    const double warm_ms = time_ms([&]() { check_pairs(cached); });
+
+    long long checks = 0;
+    long long agree = 0;
+    for (const auto& pair : pairs) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                const Vec2D target = {pair.second.x + dx, pair.second.y + dy};
+                if (world.is_walkable(target)) {
+                    checks++;
+                    agree += bresenham(pair.first, target) == cached(pair.first, target) ? 1 : 0;
+                }
+            }
+        }
+    }
+
+    // Walls placed and removed among the pairs: masks near the wall are forgotten and rebuilt
+    std::vector<Vec2D> wall;
+    double edit_ms = 0.0;
+    double recheck_ms = 0.0;
+    const size_t built_before_edits = world.visibility.built_count();
+    for (int edit = 0; edit < edit_count; ++edit) {
+        const bool placing = wall.empty();
+        if (placing) {
+            const Vec2D origin = pairs[rng() % pairs.size()].first;
+            const bool horizontal = (rng() & 1) != 0;
+            for (int i = 1; i <= wall_length; ++i) {
+                const Vec2D cell = {origin.x + (horizontal ? i : 0), origin.y + (horizontal ? 0 : i)};
+                if (world.is_walkable(cell)) {
+                    wall.push_back(cell);
+                }
+            }
+        }
+        edit_ms += time_ms([&]() { world.set_obstacles(wall, placing); });
+        if (!placing) {
+            wall.clear();
+        }
+        recheck_ms += time_ms([&]() { check_pairs(cached); });
+    }
+    const size_t rebuilt = world.visibility.built_count() - built_before_edits;
+
+    const double per_update = 1000.0 / pair_count;
+    out << "Visibility (" << size << "^2, " << pair_count << " prey updates of 1 awareness + 9 flee checks, "
+        << prey_per_predator << " per predator, "
+        << "cache radius " << VisibilityCache::RADIUS << ")" << std::endl;
+    out << std::fixed << std::setprecision(3)
+        << "  Bresenham " << bresenham_ms * per_update << " us per update; cached " << cold_ms * per_update
+        << " us cold (" << masks_built << " masks built), " << warm_ms * per_update << " us warm" << std::endl;
+    out << std::setprecision(1)
+        << "  " << edit_count << " wall edits of " << wall_length << " cells: " << edit_ms * 1000.0 / edit_count
+        << " us per edit, " << rebuilt / edit_count << " masks rebuilt per edit, all updates rechecked in "
+        << recheck_ms / edit_count << " ms" << std::endl;
+    out << std::setprecision(2) << "  agrees with Bresenham on " << 100.0 * agree / checks << "% of " << checks
+        << " checks; cache " << world.visibility.memory_bytes() / 1024 << " KiB" << std::endl;
+}
+
+void run_line_of_sight_batch(std::ostream& out) {
+    const int size = 512;
+    const int batch_count = 20000;
+    struct BatchShape {
+        const char* name;
+        size_t targets;
+        int radius;
+    };
+    const BatchShape shapes[] = {
+        {"flee candidates", 9, 6},
+        {"vision sweep", 32, PathfindingHelpers::LOS_BATCH_RADIUS},
+    };
+
+    World world(size, size);
+    world.initialize_obstacles(BENCHMARK_SEED);
+    const PathfindingHelpers::LosKernel simd = PathfindingHelpers::LosKernel::SIMD;
+    const PathfindingHelpers::LosKernel scalar = PathfindingHelpers::LosKernel::SCALAR;
+
+    out << "Line of sight batches (" << size << "^2, " << batch_count << " batches per shape, SIMD kernel "
+        << PathfindingHelpers::los_kernel_name(simd) << ")" << std::endl;
+    for (const BatchShape& shape : shapes) {
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::uniform_int_distribution<> coordinate(0, size - 1);
+        std::uniform_int_distribution<> offset(-shape.radius, shape.radius);
+        std::vector<Vec2D> origins;
+        std::vector<Vec2D> targets;
+        while (static_cast<int>(origins.size()) < batch_count) {
+            const Vec2D origin = {coordinate(rng), coordinate(rng)};
+            if (!world.is_walkable(origin)) {
+                continue;
+            }
+            origins.push_back(origin);
+            for (size_t i = 0; i < shape.targets; ++i) {
+                targets.push_back({origin.x + offset(rng), origin.y + offset(rng)});
+            }
+        }
+
+        std::vector<uint8_t> expected(targets.size());
+        std::vector<uint8_t> visible(targets.size());
+        auto one_by_one = [&]() {
+            for (size_t i = 0; i < targets.size(); ++i) {
+                expected[i] = PathfindingHelpers::has_line_of_sight(origins[i / shape.targets], targets[i], world);
+            }
+        };
+        auto batched = [&](PathfindingHelpers::LosKernel kernel) {
+            for (size_t b = 0; b < origins.size(); ++b) {
+                PathfindingHelpers::has_line_of_sight_many(origins[b], &targets[b * shape.targets], shape.targets,
+                                                           world, &visible[b * shape.targets], kernel);
+            }
+        };
+        one_by_one(); // Warms the obstacle chunks and the ray table
+        batched(simd);
+        const double single_ms = time_ms(one_by_one);
+        const double scalar_ms = time_ms([&]() { batched(scalar); });
+        const bool scalar_matches = visible == expected;
+        const double simd_ms = time_ms([&]() { batched(simd); });
+        const bool simd_matches = visible == expected;
+
+        const double per_ray = 1e6 / static_cast<double>(targets.size());
+        out << "  " << shape.name << " (" << shape.targets << " rays up to " << shape.radius << " cells): "
+            << std::fixed << std::setprecision(1) << "has_line_of_sight " << single_ms * per_ray << " ns/ray, batch "
+            << "scalar " << scalar_ms * per_ray << " ns/ray, " << PathfindingHelpers::los_kernel_name(simd) << " "
+            << simd_ms * per_ray << " ns/ray" << (scalar_matches && simd_matches ? "" : " (MISMATCH)") << std::endl;
+    }
+}
+
+void run_spatial_hash(std::ostream& out) {
+    const int sprite_counts[] = {1000, 10000, 100000};
+    const int vision_radius = 60; // PredatorAI's PREDATOR_VISION_RADIUS
+    const size_t scan_samples = 500; // Full scans timed per side, then scaled up
+
+    out << "Spatial hash (closest-sprite queries for one tick, half predators and half prey, "
+        << "spread over a square map with about 16 cells per sprite)" << std::endl;
+    for (const int sprite_count : sprite_counts) {
+        const int side = static_cast<int>(std::sqrt(16.0 * sprite_count));
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::uniform_int_distribution<> coordinate(0, side - 1);
+        std::vector<Vec2D> predators(sprite_count / 2);
+        std::vector<Vec2D> prey(sprite_count - sprite_count / 2);
+        for (Vec2D& pos : predators) {
+            pos = {coordinate(rng), coordinate(rng)};
+        }
+        for (Vec2D& pos : prey) {
+            pos = {coordinate(rng), coordinate(rng)};
+        }
+
+        // What find_closest_prey and find_closest_predator did: every sprite against every other
+        auto scan = [](const Vec2D& pos, const std::vector<Vec2D>& candidates) {
+            int closest = -1;
+            int min_dist_sq = INT_MAX;
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                const int dist_sq = PathfindingHelpers::squared_distance(pos, candidates[i]);
+                if (dist_sq < min_dist_sq) {
+                    min_dist_sq = dist_sq;
+                    closest = static_cast<int>(i);
+                }
+            }
+            return closest;
+        };
+        const size_t sampled = std::min(scan_samples, predators.size());
+        std::vector<int> scanned(2 * sampled);
+        const double scan_ms = time_ms([&]() {
+            for (size_t i = 0; i < sampled; ++i) {
+                scanned[i] = scan(predators[i], prey);
+                scanned[sampled + i] = scan(prey[i], predators);
+            }
+        });
+        const double scan_tick_ms = scan_ms * predators.size() / sampled;
+
+        SpatialHash prey_index;
+        SpatialHash predator_index;
+        std::vector<int> found(predators.size() + prey.size());
+        double build_ms = 0.0;
+        double query_ms = 0.0;
+        build_ms += time_ms([&]() { prey_index.build(prey); });
+        query_ms += time_ms([&]() {
+            for (size_t i = 0; i < predators.size(); ++i) {
+                found[i] = prey_index.nearest(predators[i],
+                                              static_cast<int64_t>(vision_radius) * vision_radius);
+            }
+        });
+        build_ms += time_ms([&]() { predator_index.build(predators); });
+        query_ms += time_ms([&]() {
+            for (size_t i = 0; i < prey.size(); ++i) {
+                found[predators.size() + i] = predator_index.nearest(prey[i]);
+            }
+        });
+
+        int mismatches = 0;
+        for (size_t i = 0; i < sampled; ++i) {
+            const int predator_target = PathfindingHelpers::squared_distance(
+                predators[i], prey[scanned[i]]) <= vision_radius * vision_radius ? scanned[i] : -1;
+            mismatches += found[i] != predator_target ? 1 : 0;
+            mismatches += found[predators.size() + i] != scanned[sampled + i] ? 1 : 0;
+        }
+
+        // The other two queries, from every predator
+        std::vector<int> neighbors;
+        size_t in_radius_count = 0;
+        const double k_nearest_ms = time_ms([&]() {
+            for (const Vec2D& predator : predators) {
+                prey_index.k_nearest(predator, 8, neighbors);
+            }
+        });
+        const double radius_ms = time_ms([&]() {
+            for (const Vec2D& predator : predators) {
+                prey_index.within_radius(predator, 16, neighbors);
+                in_radius_count += neighbors.size();
+            }
+        });
+
+        out << "  " << sprite_count << " sprites (" << side << "^2, cell " << prey_index.cell_size() << "): "
+            << std::fixed << std::setprecision(2) << "full scans " << scan_tick_ms << " ms/tick"
+            << (sampled < predators.size() ? " (from " + std::to_string(sampled) + " sampled)" : "")
+            << ", hash build " << build_ms << " ms + queries " << query_ms << " ms" << std::endl;
+        out << "    8-nearest " << k_nearest_ms * 1000.0 / predators.size() << " us, within 16 cells "
+            << radius_ms * 1000.0 / predators.size() << " us per query (" << std::setprecision(1)
+            << static_cast<double>(in_radius_count) / predators.size() << " found); " << mismatches
+            << " mismatches with the scan" << std::endl;
+    }
+}
+
+void run_captures(std::ostream& out) {
+    struct Size {
+        int predators;
+        int prey;
+    };
+    const Size sizes[] = {{100, 1000}, {200, 2000}, {2000, 20000}};
+    const int ticks = 4;
+    const double rescan_limit = 1e9; // Predator-prey pairs tried per run before the old way is skipped
+
+    out << "Capture checks (" << ticks << " ticks of one random step per sprite, a check after every "
+        << "predator step and one after the prey step, about 16 cells per sprite)" << std::endl;
+    for (const Size& size : sizes) {
+        const int side = static_cast<int>(std::sqrt(16.0 * (size.predators + size.prey)));
+        World world(side, side);
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::uniform_int_distribution<> coordinate(0, side - 1);
+        std::uniform_int_distribution<> step(-1, 1);
+        SpriteStore start_predators(Sprite::Type::PREDATOR);
+        SpriteStore start_prey(Sprite::Type::PREY);
+        Sprite sprite;
+        for (int i = 0; i < size.predators; ++i) {
+            sprite.position = {coordinate(rng), coordinate(rng)};
+            start_predators.push_back(sprite);
+        }
+        for (int i = 0; i < size.prey; ++i) {
+            sprite.position = {coordinate(rng), coordinate(rng)};
+            start_prey.push_back(sprite);
+        }
+
+        // A random step, with the stun countdown move_randomly keeps
+        auto wander = [&](SpriteStore& sprites, size_t i) {
+            if (sprites.stunned[i]) {
+                if (--sprites.stun_duration[i] <= 0) {
+                    sprites.stunned[i] = 0;
+                }
+                return;
+            }
+            Vec2D& pos = sprites.position[i];
+            pos.x = std::max(0, std::min(side - 1, pos.x + step(rng)));
+            pos.y = std::max(0, std::min(side - 1, pos.y + step(rng)));
+        };
+
+        // What process_captures did after every move: every prey against every predator,
+        // then one erase per caught prey
+        auto rescan = [&](SpriteStore& predators, SpriteStore& prey, size_t& evasions) {
+            std::vector<std::pair<Vec2D, std::string>> messages;
+            std::vector<size_t> caught;
+            for (size_t i = 0; i < prey.size(); ++i) {
+                for (size_t p_idx = 0; p_idx < predators.size(); ++p_idx) {
+                    if (CaptureLogic::attempt_capture(predators, p_idx, prey, i, world, messages)) {
+                        caught.push_back(i);
+                        break;
+                    }
+                }
+            }
+            for (auto it = caught.rbegin(); it != caught.rend(); ++it) {
+                prey.remove({*it});
+            }
+            evasions += messages.size();
+        };
+
+        // The run is repeated with the same steps and rolls for each way of checking
+        struct Run {
+            double ms = 0.0;
+            size_t captures = 0;
+            size_t evasions = 0;
+        };
+        auto run = [&](bool broadphase) {
+            Run result;
+            SpriteStore predators = start_predators;
+            SpriteStore prey = start_prey;
+            SpatialHash prey_index;
+            rng.seed(BENCHMARK_SEED);
+            gen.seed(BENCHMARK_SEED);
+            // Sprites start wherever they landed: settle that first, as the last tick's check would have
+            size_t settled = 0;
+            if (broadphase) {
+                CaptureLogic::process_captures(predators, prey, world);
+            } else {
+                rescan(predators, prey, settled);
+            }
+            for (int tick = 0; tick < ticks; ++tick) {
+                prey_index.build(prey.position);
+                for (size_t p_idx = 0; p_idx < predators.size(); ++p_idx) {
+                    wander(predators, p_idx);
+                    result.ms += time_ms([&]() {
+                        if (broadphase) {
+                            auto [captures, messages] =
+                                CaptureLogic::process_captures_after_move(predators, p_idx, prey, prey_index, world);
+                            if (captures > 0 || !messages.empty()) {
+                                prey_index.build(prey.position);
+                            }
+                            result.captures += captures;
+                            result.evasions += messages.size();
+                        } else {
+                            const size_t before = prey.size();
+                            rescan(predators, prey, result.evasions);
+                            result.captures += before - prey.size();
+                        }
+                    });
+                }
+                for (size_t i = 0; i < prey.size(); ++i) {
+                    wander(prey, i);
+                }
+                result.ms += time_ms([&]() {
+                    if (broadphase) {
+                        auto [captures, messages] = CaptureLogic::process_captures(predators, prey, world);
+                        result.captures += captures;
+                        result.evasions += messages.size();
+                    } else {
+                        const size_t before = prey.size();
+                        rescan(predators, prey, result.evasions);
+                        result.captures += before - prey.size();
+                    }
+                });
+            }
+            return result;
+        };
+
+        const Run fast = run(true);
+        out << "  " << size.predators << " predators, " << size.prey << " prey (" << side << "^2): "
+            << std::fixed << std::setprecision(2) << "broadphase " << fast.ms / ticks << " ms/tick ("
+            << fast.captures << " caught, " << fast.evasions << " evaded)";
+        if (static_cast<double>(size.predators) * size.predators * size.prey * ticks <= rescan_limit) {
+            const Run slow = run(false);
+            out << ", full rescans " << slow.ms / ticks << " ms/tick (" << slow.captures << " caught, "
+                << slow.evasions << " evaded)";
+        } else {
+            out << ", full rescans skipped";
+        }
+        out << std::endl;
+    }
+}
+
+void run_entity_store(std::ostream& out) {
+    const int counts[] = {10000, 100000};
+    const int repeats = 20;
+    const int lookups = 200; // Cells checked per occupancy pass, as is_occupied does for each move
+
+    out << "Sprite storage (the hot sweeps of a tick over std::vector<Sprite> against SpriteStore columns, "
+        << repeats << " repeats)" << std::endl;
+    out << std::setw(10) << "sprites" << std::setw(16) << "status AoS ms" << std::setw(16) << "status SoA ms"
+        << std::setw(18) << "occupied AoS ms" << std::setw(18) << "occupied SoA ms" << std::setw(14)
+        << "stun AoS ms" << std::setw(14) << "stun SoA ms" << std::setw(12) << "identical" << std::endl;
+    for (int count : counts) {
+        const int side = static_cast<int>(std::sqrt(16.0 * count));
+        std::mt19937 rng(BENCHMARK_SEED);
+        std::uniform_int_distribution<> coordinate(0, side - 1);
+        std::uniform_int_distribution<> state(0, 4);
+        std::uniform_int_distribution<> stun(0, 3);
+        std::vector<Sprite> sprites(count);
+        SpriteStore store(Sprite::Type::PREY);
+        store.reserve(count);
+        for (Sprite& sprite : sprites) {
+            sprite.type = Sprite::Type::PREY;
+            sprite.position = {coordinate(rng), coordinate(rng)};
+            sprite.currentState = static_cast<Sprite::AIState>(state(rng));
+            sprite.currentFear = static_cast<float>(coordinate(rng) % 100);
+            sprite.currentStamina = coordinate(rng) % 6;
+            sprite.isStunned = stun(rng) == 0;
+            sprite.stunDuration = sprite.isStunned ? 3 : 0;
+            sprite.currentPath.assign(20, sprite.position); // Sprites mid-route carry a path
+            sprite.recentWanderTrail.assign(5, sprite.position);
+            store.push_back(sprite);
+        }
+        std::vector<Vec2D> cells(lookups);
+        for (Vec2D& cell : cells) {
+            cell = {coordinate(rng), coordinate(rng)};
+        }
+
+        // What StatusDisplay and the renderer sum over every sprite each frame
+        double aos_status = 0.0;
+        double soa_status = 0.0;
+        int64_t aos_sum = 0;
+        int64_t soa_sum = 0;
+        for (int r = 0; r < repeats; ++r) {
+            aos_status += time_ms([&]() {
+                for (const Sprite& sprite : sprites) {
+                    aos_sum += static_cast<int>(sprite.currentState) + sprite.currentStamina +
+                               static_cast<int64_t>(sprite.currentFear);
+                }
+            });
+            soa_status += time_ms([&]() {
+                for (size_t i = 0; i < store.size(); ++i) {
+                    soa_sum += static_cast<int>(store.state[i]) + store.stamina[i] + static_cast<int64_t>(store.fear[i]);
+                }
+            });
+        }
+
+        // GameLogic::is_occupied: the first sprite on a cell
+        double aos_occupied = 0.0;
+        double soa_occupied = 0.0;
+        size_t aos_hits = 0;
+        size_t soa_hits = 0;
+        for (int r = 0; r < repeats; ++r) {
+            aos_occupied += time_ms([&]() {
+                for (const Vec2D& cell : cells) {
+                    aos_hits += std::find_if(sprites.begin(), sprites.end(),
+                                             [&](const Sprite& s) { return s.position == cell; }) != sprites.end();
+                }
+            });
+            soa_occupied += time_ms([&]() {
+                for (const Vec2D& cell : cells) {
+                    soa_hits += std::find(store.position.begin(), store.position.end(), cell) != store.position.end();
+                }
+            });
+        }
+
+        // The stun countdown every sprite's update starts with
+        double aos_stun = 0.0;
+        double soa_stun = 0.0;
+        for (int r = 0; r < repeats; ++r) {
+            aos_stun += time_ms([&]() {
+                for (Sprite& sprite : sprites) {
+                    if (sprite.isStunned && --sprite.stunDuration <= 0) {
+                        sprite.isStunned = false;
+                    }
+                }
+            });
+            soa_stun += time_ms([&]() {
+                for (size_t i = 0; i < store.size(); ++i) {
+                    if (store.stunned[i] && --store.stun_duration[i] <= 0) {
+                        store.stunned[i] = 0;
+                    }
+                }
+            });
+        }
+
+        bool identical = aos_sum == soa_sum && aos_hits == soa_hits;
+        for (size_t i = 0; i < store.size() && identical; ++i) {
+            identical = sprites[i].isStunned == (store.stunned[i] != 0) && sprites[i].stunDuration == store.stun_duration[i];
+        }
+        out << std::setw(10) << count << std::fixed << std::setprecision(3) << std::setw(16) << aos_status / repeats
+            << std::setw(16) << soa_status / repeats << std::setw(18) << aos_occupied / repeats << std::setw(18)
+            << soa_occupied / repeats << std::setw(14) << aos_stun / repeats << std::setw(14) << soa_stun / repeats
+            << std::setw(12) << (identical ? "yes" : "NO") << std::endl;
+    }
+}
+
+void run_all(std::ostream& out) {
+    run_world_generation(out);
+    run_world_file(out);
+    run_components(out);
+    run_dynamic_obstacles(out);
+    run_pathfinding(out);
+    run_path_policies(out);
+    run_hierarchical(out);
+    run_path_cache(out);
+    run_incremental_replanning(out);
+    run_multi_goal(out);
+    run_flow_fields(out);
+    run_bidirectional(out);
+    run_path_budget(out);
+    run_path_service(out);
+    run_any_angle(out);
+    run_path_repair(out);
+    run_visibility(out);
+    run_line_of_sight_batch(out);
+    run_spatial_hash(out);
+    run_captures(out);
+    run_entity_store(out);
+}
+
+} // namespace Benchmark
@@ -0,0 +1,102 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <iosfwd>
+
+// Micro-benchmarks for the world and pathfinding modules.
+// Enabled by setting the BENCHMARK environment variable; results go to the given stream.
+namespace Benchmark {
+    // Run every benchmark in turn
+    void run_all(std::ostream& out);
+
+    // World generation time against map size, single-threaded vs. all hardware threads.
+    // Also checks that both runs produce bit-identical grids.
+    void run_world_generation(std::ostream& out);
+
+    // Saving a 10000 x 10000 map and memory-mapping it back, compared with generating it.
+    // Also checks that the loaded grids match the generated ones.
+    void run_world_file(std::ostream& out);
+
+    // Connected-component labeling time, incremental update time after one obstacle
+    // change, and find_path time toward a goal sealed off in an enclosed pocket.
+    void run_components(std::ostream& out);
+
+    // Cost of placing and removing wall segments mid-run, and how many cached paths
+    // the dirty-region check drops compared with dropping every path on any change.
+    void run_dynamic_obstacles(std::ostream& out);
+
+    // find_path throughput (expanded nodes per second) on random reachable queries,
+    // for every PathEngine
+    void run_pathfinding(std::ostream& out);
+
+    // find_path<Heuristic, MoveCost, Neighborhood> for several policy combinations:
+    // expansions, time, and path quality (steps and geometric length against the optimum)
+    void run_path_policies(std::ostream& out);
+
+    // Path hierarchy build time and size on a large map, long queries with flat A*
+    // against HPA* (whole route and default partial refinement), and update cost per wall edit
+    void run_hierarchical(std::ostream& out);
+
+    // Replanning cost of chasers that share goals and replan every few ticks, with the
+    // path cache off and on (exact and suffix hit counts), under A* and HPA*, and how many
+    // chasers reach their goal
+    void run_path_cache(std::ostream& out);
+
+    // Chasers replanning every tick toward moving targets while walls appear: fresh
+    // A* searches against one IncrementalPlanner per chaser (time and expansions per plan)
+    void run_incremental_replanning(std::ostream& out);
+
+    // Nearest of several goals: one find_path per goal (keeping the shortest) against a
+    // single find_path_to_any search, with the step counts compared
+    void run_multi_goal(std::ostream& out);
+
+    // Many chasers after one moving target: an A* per chaser per tick against one shared
+    // flow field per tick (time per tick, cells the field reached, step counts compared)
+    void run_flow_fields(std::ostream& out);
+
+    // Bidirectional A* against unidirectional A* (Manhattan and Chebyshev) on the generated
+    // map and on one with long walls added, grouped by whether an end of the query is boxed in
+    void run_bidirectional(std::ostream& out);
+
+    // Long searches on a walled map: the longest single call and the calls needed to
+    // finish, unbudgeted against BudgetedSearch slices of several sizes
+    void run_path_budget(std::ostream& out);
+
+    // Chase searches through a PathService: inline against several worker counts (time the
+    // simulation thread spends per tick, time until the results are in, searches after
+    // deduplicating requests that share a start and goal)
+    void run_path_service(std::ostream& out);
+
+    // Octile A* step paths against Theta* waypoint paths on the same queries: search time,
+    // stored entries, validation time, moves walked and geometric length
+    void run_any_angle(std::ostream& out);
+
+    // Paths cut by a new wall: validate_and_repair_path's local detours against a full
+    // replan (time per path, paths fixed, extra length)
+    void run_path_repair(std::ostream& out);
+
+    // The prey's sight checks (awareness plus flee candidates) with has_line_of_sight
+    // against the cached field of view: time per prey update cold and warm, masks rebuilt
+    // after wall edits, and how often the two agree
+    void run_visibility(std::ostream& out);
+
+    // has_line_of_sight_many with the scalar and SIMD kernels against one
+    // has_line_of_sight call per ray, for flee-sized and vision-sized batches
+    void run_line_of_sight_batch(std::ostream& out);
+
+    // One tick of closest-sprite queries (every predator for prey, every prey for a
+    // predator) for up to 100k sprites: full scans against SpatialHash builds and queries,
+    // plus k-nearest and within-radius query times
+    void run_spatial_hash(std::ostream& out);
+
+    // Capture checks over a few ticks: the old full rescan after every move against the
+    // broadphase (prey around the predator that moved, then one indexed pass after the
+    // prey move), with the captures and evasions each one resolved
+    void run_captures(std::ostream& out);
+
+    // The per-tick sweeps over every sprite (status sums, occupancy lookups, stun countdown)
+    // on a std::vector<Sprite> against the same sprites in SpriteStore columns
+    void run_entity_store(std::ostream& out);
+}
+
+#endif // BENCHMARK_H
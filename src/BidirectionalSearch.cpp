@@ -0,0 +1,140 @@
+#include "Pathfinding.h"
+#include "PathSearchContext.h"
+
+#include <algorithm> // For std::max, std::min, std::reverse
+#include <climits>   // For INT_MAX
+#include <cstdlib>   // For std::abs
+#include <cstdint>   // For int64_t
+
+// Bidirectional A*: one search from the start toward the goal and one from the goal
+// toward the start, each with the Chebyshev heuristic to its own target. Every cell
+// reached by both searches closes a route; the shortest one is final once either
+// open set's smallest f reaches its length (no cheaper route can still be found).
+
+namespace {
+
+// Search state of the backward half; the forward half shares the thread's A* context
+thread_local PathSearchContext backward;
+
+int chebyshev_distance(const Vec2D& a, const Vec2D& b) {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
+
+// Heap tie-break: lower h first, then cells closer to the start-goal line. Many
+// equally short routes exist on an 8-connected grid; without the second key the two
+// halves tend to follow different ones and only meet near the far ends.
+struct TieBreak {
+    Vec2D origin;
+    Vec2D direction;
+    int64_t scale;
+
+    TieBreak(const Vec2D& start, const Vec2D& goal)
+        : origin(start), direction{goal.x - start.x, goal.y - start.y},
+          scale(std::max<int64_t>(1, chebyshev_distance(start, goal))) {}
+
+    int key(const Vec2D& pos, int h) const {
+        const int64_t cross = static_cast<int64_t>(pos.x - origin.x) * direction.y -
+                              static_cast<int64_t>(pos.y - origin.y) * direction.x;
+        const int64_t off_line = std::min<int64_t>(MAX_OFF_LINE, (cross < 0 ? -cross : cross) / scale);
+        return h * (MAX_OFF_LINE + 1) + static_cast<int>(off_line);
+    }
+
+    static constexpr int MAX_OFF_LINE = 1023;
+};
+
+void open_root(PathSearchContext& search, const Vec2D& root, const Vec2D& target, const TieBreak& tie_break) {
+    PathSearchContext::Node& node = search.touch(root.x, root.y);
+    node.g = 0;
+    const int h = chebyshev_distance(root, target);
+    search.push_or_decrease(root, node, h, tie_break.key(root, h));
+}
+
+} // namespace
+
+bool find_path_bidirectional(
+    const Vec2D& start,
+    const Vec2D& goal,
+    const World& world,
+    std::vector<Vec2D>& path
+) {
+    path.clear();
+    if (!world.is_reachable(start, goal)) {
+        return false;
+    }
+
+    PathSearchContext& forward = PathSearchContext::for_this_thread();
+    forward.begin(world);
+    backward.begin(world);
+    const TieBreak tie_break(start, goal);
+    open_root(forward, start, goal, tie_break);
+    open_root(backward, goal, start, tie_break);
+
+    int best_length = start == goal ? 0 : INT_MAX;
+    Vec2D meeting_cell = start;
+    while (!forward.open_empty() && !backward.open_empty() &&
+           std::max(forward.open_min_f(), backward.open_min_f()) < best_length) {
+        // Expand the side with the smaller open set, so neither frontier runs away
+        const bool from_start = forward.open_size() <= backward.open_size();
+        PathSearchContext& search = from_start ? forward : backward;
+        const PathSearchContext& other = from_start ? backward : forward;
+        const Vec2D& target = from_start ? goal : start;
+
+        const Vec2D current = search.pop();
+        const PathSearchContext::Node* reached = other.find(current.x, current.y);
+        if (reached && reached->closed) {
+            continue; // Its exact distance to the other end is known, and best_length already counts it
+        }
+        const int current_g = search.touch(current.x, current.y).g;
+        for (uint8_t dir = 0; dir < 8; ++dir) {
+            const Vec2D neighbor_pos = {current.x + World::NEIGHBOR_OFFSETS[dir].x,
+                                        current.y + World::NEIGHBOR_OFFSETS[dir].y};
+            if (!world.is_walkable(neighbor_pos)) {
+                continue;
+            }
+            PathSearchContext::Node& neighbor = search.touch(neighbor_pos.x, neighbor_pos.y);
+            const int tentative_g_cost = current_g + 1;
+            if (tentative_g_cost >= neighbor.g) {
+                continue;
+            }
+            neighbor.g = tentative_g_cost;
+            neighbor.parent_dir = dir;
+            neighbor.parent_steps = 1;
+            const int h_cost = chebyshev_distance(neighbor_pos, target);
+            search.push_or_decrease(neighbor_pos, neighbor, tentative_g_cost + h_cost,
+                                    tie_break.key(neighbor_pos, h_cost));
+
+            reached = other.find(neighbor_pos.x, neighbor_pos.y);
+            if (reached && reached->g != INT_MAX && tentative_g_cost + reached->g < best_length) {
+                best_length = tentative_g_cost + reached->g;
+                meeting_cell = neighbor_pos;
+            }
+        }
+    }
+    if (best_length == INT_MAX) {
+        return false;
+    }
+
+    // Start to meeting cell from the forward parents, then on to the goal along the backward ones
+    for (Vec2D cell = meeting_cell; cell != start;) {
+        path.push_back(cell);
+        const Vec2D& step = World::NEIGHBOR_OFFSETS[forward.find(cell.x, cell.y)->parent_dir];
+        cell = {cell.x - step.x, cell.y - step.y};
+    }
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+    for (Vec2D cell = meeting_cell; cell != goal;) {
+        const Vec2D& step = World::NEIGHBOR_OFFSETS[backward.find(cell.x, cell.y)->parent_dir];
+        cell = {cell.x - step.x, cell.y - step.y};
+        path.push_back(cell);
+    }
+
+    if (!PathfindingHelpers::validate_and_repair_path(path, world)) {
+        path.clear();
+        return false;
+    }
+    return true;
+}
+
+size_t bidirectional_expanded_count() {
+    return PathSearchContext::for_this_thread().expanded_count() + backward.expanded_count();
+}
@@ -0,0 +1,131 @@
+#include "BudgetedSearch.h"
+#include "World.h"
+#include "PathfindingHelpers.h"
+
+#include <algorithm> // For std::max
+#include <cstdlib>   // For std::abs
+#include <cstdint>   // For SIZE_MAX
+#include <climits>   // For INT_MAX
+
+static int chebyshev_distance(const Vec2D& a, const Vec2D& b) {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
+
+void BudgetedSearch::start(const Vec2D& start, const Vec2D& goal, const World& new_world) {
+    world = &new_world;
+    world_version = new_world.obstacle_version;
+    root = start;
+    target = goal;
+    closest = start;
+    closest_h = chebyshev_distance(start, goal);
+
+    context.begin(new_world);
+    PathSearchContext::Node& start_node = context.touch(start.x, start.y);
+    start_node.g = 0;
+    context.push_or_decrease(start, start_node, closest_h, closest_h);
+
+    // Goals in another connected component would make the search expand every reachable cell.
+    // A path from a blocked start fails validate_and_repair_path, as find_path's does
+    finished = !new_world.is_walkable(start) || !new_world.is_reachable(start, goal);
+    outcome = PathStatus::NO_PATH;
+}
+
+bool BudgetedSearch::can_resume(const World& current) const {
+    return !finished && world == &current && world_version == current.obstacle_version;
+}
+
+bool BudgetedSearch::has_reached(const Vec2D& cell) const {
+    if (!world || !world->grid.in_bounds(cell.x, cell.y)) {
+        return false;
+    }
+    const PathSearchContext::Node* node = context.find(cell.x, cell.y);
+    return node && node->g != INT_MAX;
+}
+
+PathStatus BudgetedSearch::resume(const Vec2D& from, size_t max_expansions, std::vector<Vec2D>& path) {
+    path.clear();
+    if (!world) {
+        return PathStatus::NO_PATH;
+    }
+
+    const size_t expansion_limit = max_expansions > SIZE_MAX - context.expanded_count()
+                                       ? SIZE_MAX
+                                       : context.expanded_count() + max_expansions;
+    while (!finished && context.expanded_count() < expansion_limit) {
+        if (context.open_empty()) {
+            finished = true;
+            outcome = PathStatus::NO_PATH;
+            break;
+        }
+        const Vec2D current = context.pop();
+        if (current == target) {
+            finished = true;
+            outcome = PathStatus::FOUND;
+            break;
+        }
+
+        const int current_g = context.touch(current.x, current.y).g;
+        for (uint8_t dir = 0; dir < 8; ++dir) {
+            const Vec2D neighbor_pos = {current.x + World::NEIGHBOR_OFFSETS[dir].x,
+                                        current.y + World::NEIGHBOR_OFFSETS[dir].y};
+            if (!world->is_walkable(neighbor_pos)) {
+                continue;
+            }
+            PathSearchContext::Node& neighbor = context.touch(neighbor_pos.x, neighbor_pos.y);
+            const int tentative_g_cost = current_g + 1;
+            if (tentative_g_cost < neighbor.g) {
+                neighbor.g = tentative_g_cost;
+                neighbor.parent_dir = dir;
+                neighbor.parent_steps = 1;
+                const int h_cost = chebyshev_distance(neighbor_pos, target);
+                context.push_or_decrease(neighbor_pos, neighbor, tentative_g_cost + h_cost, h_cost);
+                if (h_cost < closest_h) {
+                    closest = neighbor_pos;
+                    closest_h = h_cost;
+                }
+            }
+        }
+    }
+
+    const PathStatus status = finished ? outcome : PathStatus::PARTIAL;
+    if (status == PathStatus::NO_PATH || !build_path(from, status == PathStatus::FOUND ? target : closest, path)) {
+        path.clear();
+        // A finished search with no path from `from` has nothing to offer it
+        return status == PathStatus::FOUND ? PathStatus::NO_PATH : status;
+    }
+    return status;
+}
+
+void BudgetedSearch::trace_to_root(Vec2D cell, std::vector<Vec2D>& trail) const {
+    trail.push_back(cell);
+    while (cell != root) {
+        const Vec2D& step = World::NEIGHBOR_OFFSETS[context.find(cell.x, cell.y)->parent_dir];
+        cell = {cell.x - step.x, cell.y - step.y};
+        trail.push_back(cell);
+    }
+}
+
+bool BudgetedSearch::build_path(const Vec2D& from, const Vec2D& to, std::vector<Vec2D>& path) {
+    if (!has_reached(from)) {
+        return false;
+    }
+    trace_to_root(from, path);
+    to_trail.clear();
+    trace_to_root(to, to_trail);
+
+    // Both trails end at the root; cut them back to their last shared cell
+    while (path.size() > 1 && to_trail.size() > 1 &&
+           path[path.size() - 2] == to_trail[to_trail.size() - 2]) {
+        path.pop_back();
+        to_trail.pop_back();
+    }
+    path.insert(path.end(), to_trail.rbegin() + 1, to_trail.rend());
+    return PathfindingHelpers::validate_and_repair_path(path, *world);
+}
+
+PathStatus find_path_budgeted(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path,
+                              size_t max_expansions) {
+    thread_local BudgetedSearch search;
+    search.start(start, goal, world);
+    return search.resume(start, max_expansions, path);
+}
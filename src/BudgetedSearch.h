@@ -0,0 +1,61 @@
+#ifndef BUDGETED_SEARCH_H
+#define BUDGETED_SEARCH_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Vec2D.h"
+#include "Pathfinding.h"
+#include "PathSearchContext.h"
+
+// A* toward one goal (Chebyshev heuristic, fewest 8-connected unit-cost steps) that
+// runs in slices: each resume() expands at most a given number of cells and then
+// hands back the whole path, or a partial one toward the reached cell nearest the
+// goal. The open set and every reached cell stay in the search's own
+// PathSearchContext, so the next resume() carries on where the last one stopped.
+//
+// A caller walking a partial path can resume from the cell it has reached since:
+// every cell on a partial path belongs to the search tree, and paths are built along
+// that tree. A search only resumes on the world and obstacle_version it started on.
+class BudgetedSearch {
+public:
+    // Begin a new search (drops any unfinished one)
+    void start(const Vec2D& start, const Vec2D& goal, const World& world);
+
+    // Expand at most max_expansions more cells, then fill path starting at from (the
+    // search's start or any cell it has reached; path is empty otherwise). Returns
+    // FOUND or NO_PATH once the search has finished, PARTIAL while it has not; FOUND
+    // only with a path (NO_PATH if none could be built from `from`). A search that
+    // starts on a blocked cell finishes at once with NO_PATH.
+    PathStatus resume(const Vec2D& from, size_t max_expansions, std::vector<Vec2D>& path);
+
+    // True if a started search has not finished and the world has not changed since
+    bool can_resume(const World& world) const;
+
+    // True if the current search has reached cell
+    bool has_reached(const Vec2D& cell) const;
+
+    const Vec2D& goal() const { return target; }
+
+    // Cells expanded since start()
+    size_t expanded_count() const { return context.expanded_count(); }
+
+private:
+    // Tree path from one reached cell to another, through their nearest common ancestor
+    bool build_path(const Vec2D& from, const Vec2D& to, std::vector<Vec2D>& path);
+    // Reached cells from cell back to the root (cell first)
+    void trace_to_root(Vec2D cell, std::vector<Vec2D>& trail) const;
+
+    PathSearchContext context;
+    const World* world = nullptr;
+    uint64_t world_version = 0;
+    Vec2D root;
+    Vec2D target;
+    Vec2D closest;             // Reached cell with the lowest heuristic so far
+    int closest_h = 0;
+    bool finished = true;
+    PathStatus outcome = PathStatus::NO_PATH; // Valid once finished
+    std::vector<Vec2D> to_trail; // Scratch for build_path
+};
+
+#endif // BUDGETED_SEARCH_H
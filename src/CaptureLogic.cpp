@@ -4,10 +4,10 @@
 
 namespace CaptureLogic {
 
-Vec2D calculate_escape_position(const Sprite& prey, const Sprite& predator, const World& world) {
+Vec2D calculate_escape_position(const Vec2D& prey, const Vec2D& predator, const World& world) {
     // Calculate the direction vector from predator to prey
-    int dx = prey.position.x - predator.position.x;
-    int dy = prey.position.y - predator.position.y;
+    int dx = prey.x - predator.x;
+    int dy = prey.y - predator.y;
     
     // If dx or dy is zero, pick a random direction for that component
     int escape_dx = (dx == 0) ? (std::uniform_int_distribution<int>(0, 1)(gen) * 2 - 1) : ((dx > 0) ? 1 : -1);
@@ -16,8 +16,8 @@ Vec2D calculate_escape_position(const Sprite& prey, const Sprite& predator, cons
     // Move prey 2-3 spaces away to escape
     int escape_distance = std::uniform_int_distribution<int>(2, 3)(gen);
     Vec2D escape_pos = {
-        prey.position.x + escape_dx * escape_distance,
-        prey.position.y + escape_dy * escape_distance
+        prey.x + escape_dx * escape_distance,
+        prey.y + escape_dy * escape_distance
     };
     
     // Ensure escape position is within bounds and walkable
@@ -34,8 +34,8 @@ Vec2D calculate_escape_position(const Sprite& prey, const Sprite& predator, cons
                     if (x_off == 0 && y_off == 0) continue;
                     
                     Vec2D test_pos = {
-                        prey.position.x + x_off,
-                        prey.position.y + y_off
+                        prey.x + x_off,
+                        prey.y + y_off
                     };
                     
                     // Ensure within bounds
@@ -50,26 +50,29 @@ Vec2D calculate_escape_position(const Sprite& prey, const Sprite& predator, cons
         }
         
         // If we couldn't find a walkable position, just return the prey's current position
-        return prey.position;
+        return prey;
     }
     
     return escape_pos;
 }
 
-bool attempt_capture(Sprite& predator, Sprite& prey, const World& world,
-                    std::vector<std::pair<Vec2D, std::string>>& evasion_messages,
-                    int predator_index) {
+bool attempt_capture(SpriteStore& predators, size_t predator_index,
+                    SpriteStore& prey_sprites, size_t prey_index, const World& world,
+                    std::vector<std::pair<Vec2D, std::string>>& evasion_messages) {
     // Skip if predator is stunned
-    if (predator.isStunned) return false;
+    if (predators.stunned[predator_index]) return false;
     
     // Check distance between predator and prey
-    int dx = prey.position.x - predator.position.x;
-    int dy = prey.position.y - predator.position.y;
+    Vec2D& prey_position = prey_sprites.position[prey_index];
+    const Vec2D& predator_position = predators.position[predator_index];
+    int dx = prey_position.x - predator_position.x;
+    int dy = prey_position.y - predator_position.y;
     
     // If within capture distance (adjacent cells including diagonals)
     if (std::abs(dx) <= 1 && std::abs(dy) <= 1) {
         // Calculate dynamic evasion chance based on fear
-        float dynamicEvasionChance = prey.evasionChance + (prey.currentFear / prey.maxFear) * 0.15f; // Max 15% bonus from fear
+        const SpriteDetail& prey = prey_sprites.detail[prey_index];
+        float dynamicEvasionChance = prey.evasionChance + (prey_sprites.fear[prey_index] / prey.maxFear) * 0.15f; // Max 15% bonus from fear
         dynamicEvasionChance = std::min(dynamicEvasionChance, 0.9f); // Cap evasion at 90%
 
         // Check for evasion
@@ -77,16 +80,16 @@ bool attempt_capture(Sprite& predator, Sprite& prey, const World& world,
         
         if (evasion_roll <= dynamicEvasionChance) {
             // Evasion successful! Stun the predator
-            predator.isStunned = true;
-            predator.stunDuration = 2; // Stun for 2 frames
-            predator.currentState = Sprite::AIState::STUNNED;
+            predators.stunned[predator_index] = 1;
+            predators.stun_duration[predator_index] = 2; // Stun for 2 frames
+            predators.state[predator_index] = Sprite::AIState::STUNNED;
             
             // Calculate and apply escape position
-            Vec2D escape_pos = calculate_escape_position(prey, predator, world);
-            prey.position = escape_pos;
+            Vec2D escape_pos = calculate_escape_position(prey_position, predator_position, world);
+            prey_position = escape_pos;
             
             // Store message about evasion for display
-            evasion_messages.push_back({prey.position, "Prey escaped from Predator " + std::to_string(predator_index + 1)});
+            evasion_messages.push_back({prey_position, "Prey escaped from Predator " + std::to_string(predator_index + 1)});
             
             return false; // Prey escaped
         } else {
@@ -98,41 +101,122 @@ bool attempt_capture(Sprite& predator, Sprite& prey, const World& world,
     return false; // Not close enough to capture
 }
 
+namespace {
+
+using EvasionMessages = std::vector<std::pair<Vec2D, std::string>>;
+
+bool is_adjacent(const Vec2D& a, const Vec2D& b) {
+    return std::abs(a.x - b.x) <= 1 && std::abs(a.y - b.y) <= 1;
+}
+
+// Let the contenders (predator indices, ascending) try for the prey in turn. A prey that
+// evades to a new cell is tried at once by every unstunned predator next to that cell,
+// lowest index first, as find_contenders(position, out) lists them; this repeats until
+// the prey is caught or no predator is left next to it. Returns true if it was caught.
+template <typename FindContenders>
+bool resolve_prey(SpriteStore& predators, SpriteStore& prey_sprites, size_t prey, std::vector<int>& contenders,
+                  const World& world, EvasionMessages& evasion_messages, FindContenders&& find_contenders) {
+    const Vec2D& position = prey_sprites.position[prey];
+    for (;;) {
+        const Vec2D start = position;
+        for (int p_idx : contenders) {
+            const size_t messages_before = evasion_messages.size();
+            if (attempt_capture(predators, p_idx, prey_sprites, prey, world, evasion_messages)) {
+                return true;
+            }
+            if (evasion_messages.size() != messages_before && !(position == start)) {
+                break; // Escaped to another cell: the contenders there are different
+            }
+        }
+        if (position == start) {
+            return false;
+        }
+        find_contenders(position, contenders);
+        if (contenders.empty()) {
+            return false;
+        }
+    }
+}
+
+} // namespace
+
 std::pair<size_t, std::vector<std::pair<Vec2D, std::string>>> 
-process_captures(std::vector<Sprite>& predators, 
-                std::vector<Sprite>& prey_sprites,
+process_captures(SpriteStore& predators, 
+                SpriteStore& prey_sprites,
                 const World& world) {
-    size_t initial_prey_count = prey_sprites.size();
-    std::vector<size_t> indices_to_remove;
-    std::vector<std::pair<Vec2D, std::string>> evasion_messages;
-    
-    // Check each prey against each predator
+    std::vector<size_t> captured;
+    EvasionMessages evasion_messages;
+
+    // Predators hold still while captures are resolved (only their stun state changes)
+    SpatialHash predator_cells;
+    predator_cells.build(predators.position);
+    std::vector<int> nearby;
+    auto find_contenders = [&](const Vec2D& pos, std::vector<int>& out) {
+        predator_cells.within_square(pos, 1, nearby);
+        out.clear();
+        for (int p_idx : nearby) {
+            if (!predators.stunned[p_idx]) {
+                out.push_back(p_idx);
+            }
+        }
+    };
+
+    // Prey in order, each against the predators around it in order
+    std::vector<int> contenders;
     for (size_t i = 0; i < prey_sprites.size(); ++i) {
-        auto& prey = prey_sprites[i];
-        
-        // Check if any predator can capture this prey
+        find_contenders(prey_sprites.position[i], contenders);
+        if (!contenders.empty() &&
+            resolve_prey(predators, prey_sprites, i, contenders, world, evasion_messages, find_contenders)) {
+            captured.push_back(i);
+        }
+    }
+
+    prey_sprites.remove(captured); // One pass, keeping the rest in order
+    return {captured.size(), evasion_messages};
+}
+
+std::pair<size_t, std::vector<std::pair<Vec2D, std::string>>>
+process_captures_after_move(SpriteStore& predators,
+                            size_t mover,
+                            SpriteStore& prey_sprites,
+                            const SpatialHash& prey_index,
+                            const World& world) {
+    std::vector<size_t> captured;
+    EvasionMessages evasion_messages;
+    const Vec2D& predator_position = predators.position[mover];
+    if (predators.stunned[mover]) {
+        return {0, evasion_messages};
+    }
+
+    // Evasions are rare, so the predators next to an escaped prey are found by a scan
+    auto find_contenders = [&](const Vec2D& pos, std::vector<int>& out) {
+        out.clear();
         for (size_t p_idx = 0; p_idx < predators.size(); ++p_idx) {
-            auto& predator = predators[p_idx];
-            
-            if (attempt_capture(predator, prey, world, evasion_messages, p_idx)) {
-                // Prey was captured
-                indices_to_remove.push_back(i);
-                break; // This prey is captured, no need to check other predators
+            if (!predators.stunned[p_idx] && is_adjacent(predators.position[p_idx], pos)) {
+                out.push_back(static_cast<int>(p_idx));
             }
         }
-    }
-    
-    // Remove captured prey in reverse order to maintain valid indices
-    std::sort(indices_to_remove.begin(), indices_to_remove.end(), std::greater<size_t>());
-    for (size_t index : indices_to_remove) {
-        if (index < prey_sprites.size()) { // Safety check
-            prey_sprites.erase(prey_sprites.begin() + index);
+    };
+
+    std::vector<int> nearby;
+    prey_index.within_square(predator_position, 1, nearby);
+    std::vector<int> contenders;
+    for (int i : nearby) {
+        // An earlier prey's escape can have stunned the mover or moved this prey
+        if (predators.stunned[mover]) {
+            break;
+        }
+        if (!is_adjacent(prey_sprites.position[i], predator_position)) {
+            continue;
+        }
+        contenders.assign(1, static_cast<int>(mover));
+        if (resolve_prey(predators, prey_sprites, i, contenders, world, evasion_messages, find_contenders)) {
+            captured.push_back(i);
         }
     }
-    
-    // Return number of captures and evasion messages
-    size_t captures = initial_prey_count - prey_sprites.size();
-    return {captures, evasion_messages};
+
+    prey_sprites.remove(captured);
+    return {captured.size(), evasion_messages};
 }
 
 } // namespace CaptureLogic 
\ No newline at end of file
@@ -5,30 +5,42 @@
 #include <utility>
 #include <string>
 #include <random>
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "World.h"
+#include "SpatialHash.h"
 
 // External reference to the global random generator
 extern std::mt19937 gen;
 
 namespace CaptureLogic {
-    // Check for and process prey captures by predators
+    // Check for and process prey captures by predators, after the prey have moved: every
+    // prey is looked up against an index of predator cells, so only adjacent pairs are tried
     // Returns a pair containing:
     // - Number of prey captured
     // - Vector of evasion messages (position, message)
     std::pair<size_t, std::vector<std::pair<Vec2D, std::string>>> 
-    process_captures(std::vector<Sprite>& predators, 
-                    std::vector<Sprite>& prey_sprites,
+    process_captures(SpriteStore& predators, 
+                    SpriteStore& prey_sprites,
                     const World& world);
+
+    // Check for captures after predators[mover] alone has moved: only the prey within one
+    // cell of it are tried (found through prey_index, which must be built on prey_sprites).
+    // Everything else was settled by the previous check. Returns the same as process_captures
+    std::pair<size_t, std::vector<std::pair<Vec2D, std::string>>>
+    process_captures_after_move(SpriteStore& predators,
+                                size_t mover,
+                                SpriteStore& prey_sprites,
+                                const SpatialHash& prey_index,
+                                const World& world);
     
-    // Attempt to capture a specific prey with a specific predator
+    // Attempt to capture prey_sprites[prey_index] with predators[predator_index]
     // Returns true if prey was captured, false if prey evaded
-    bool attempt_capture(Sprite& predator, Sprite& prey, const World& world,
-                        std::vector<std::pair<Vec2D, std::string>>& evasion_messages,
-                        int predator_index);
+    bool attempt_capture(SpriteStore& predators, size_t predator_index,
+                        SpriteStore& prey_sprites, size_t prey_index, const World& world,
+                        std::vector<std::pair<Vec2D, std::string>>& evasion_messages);
     
     // Calculate escape position for prey that successfully evaded capture
-    Vec2D calculate_escape_position(const Sprite& prey, const Sprite& predator, const World& world);
+    Vec2D calculate_escape_position(const Vec2D& prey, const Vec2D& predator, const World& world);
 }
 
 #endif // CAPTURE_LOGIC_H 
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "ChunkedGrid.h"
+#include <bitset>
+
+void ChunkedBitGrid::resize(int new_width, int new_height) {
+    width = new_width;
+    height = new_height;
+    chunks_x = (width + CHUNK_MASK) >> CHUNK_SHIFT;
+    chunks_y = (height + CHUNK_MASK) >> CHUNK_SHIFT;
+    storage.reset(static_cast<size_t>(chunks_x) * chunks_y, 0);
+}
+
+void ChunkedBitGrid::clear() {
+    storage.reset(storage.chunk_count, 0);
+}
+
+void ChunkedBitGrid::attach(int new_width, int new_height, const int32_t* slots, const uint64_t* rows, size_t allocated) {
+    width = new_width;
+    height = new_height;
+    chunks_x = (width + CHUNK_MASK) >> CHUNK_SHIFT;
+    chunks_y = (height + CHUNK_MASK) >> CHUNK_SHIFT;
+    storage.attach(slots, rows, static_cast<size_t>(chunks_x) * chunks_y, allocated, 0);
+}
+
+void ChunkedBitGrid::set(int x, int y, bool value) {
+    if (!in_bounds(x, y)) {
+        return;
+    }
+    const int chunk = chunk_index(x, y);
+    // Clearing a bit in an empty chunk is a no-op, so only setting allocates
+    uint64_t* rows = value ? storage.writable_chunk(chunk) : storage.writable_existing_chunk(chunk);
+    if (!rows) {
+        return;
+    }
+    const uint64_t mask = uint64_t{1} << (x & CHUNK_MASK);
+    if (value) {
+        rows[y & CHUNK_MASK] |= mask;
+    } else {
+        rows[y & CHUNK_MASK] &= ~mask;
+    }
+}
+
+void ChunkedBitGrid::merge_chunk_rows(int chunk, const uint64_t* rows) {
+    if (!storage.is_allocated(chunk) &&
+        std::all_of(rows, rows + CHUNK_SIZE, [](uint64_t row) { return row == 0; })) {
+        return;
+    }
+    uint64_t* target = storage.writable_chunk(chunk);
+    for (int row = 0; row < CHUNK_SIZE; ++row) {
+        target[row] |= rows[row];
+    }
+}
+
+size_t ChunkedBitGrid::count_set() const {
+    size_t total = 0;
+    const uint64_t* end = storage.data + storage.allocated * CHUNK_SIZE;
+    for (const uint64_t* row = storage.data; row != end; ++row) {
+        total += std::bitset<64>(*row).count();
+    }
+    return total;
+}
@@ -0,0 +1,363 @@
+#ifndef CHUNKED_GRID_H
+#define CHUNKED_GRID_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#include <intrin.h> // For _BitScanForward64 / _BitScanReverse64
+#endif
+
+// World storage is split into fixed-size square chunks. A chunk is only
+// allocated once something is written into it, so large maps only pay for
+// the areas that actually hold obstacles or zones.
+const int CHUNK_SHIFT = 6;
+const int CHUNK_SIZE = 1 << CHUNK_SHIFT;          // 64 cells per side
+const int CHUNK_MASK = CHUNK_SIZE - 1;
+const int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;  // 4096 cells per chunk
+
+// Index of the lowest set bit (word must be non-zero)
+inline int lowest_set_bit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// Index of the highest set bit (word must be non-zero)
+inline int highest_set_bit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanReverse64(&index, word);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
+
+// Chunk table plus chunk payloads shared by the chunked grid types.
+// Lookups go through the slots/data views, which point either at the owned
+// vectors or at external read-only memory (e.g. a memory-mapped world file).
+// The first write to external storage copies it into owned memory.
+template <typename T, int ELEMENTS_PER_CHUNK>
+struct ChunkStorage {
+    // Views used by every lookup
+    const int32_t* slots = nullptr; // Per chunk: payload slot, or -1 if not allocated
+    const T* data = nullptr;        // ELEMENTS_PER_CHUNK values per allocated chunk
+    size_t chunk_count = 0;
+    size_t allocated = 0;
+    T fill = T();                   // Value of every element in an unallocated chunk
+
+    ChunkStorage() = default;
+    ChunkStorage(const ChunkStorage& other) { *this = other; }
+    ChunkStorage& operator=(const ChunkStorage& other) {
+        if (this != &other) {
+            chunk_count = other.chunk_count;
+            allocated = other.allocated;
+            fill = other.fill;
+            owned_slots = other.owned_slots;
+            owned_data = other.owned_data;
+            external = other.external;
+            if (external) {
+                slots = other.slots;
+                data = other.data;
+            } else {
+                refresh_views();
+            }
+        }
+        return *this;
+    }
+
+    // Drop every chunk and size the table for new_chunk_count chunks
+    void reset(size_t new_chunk_count, T new_fill) {
+        chunk_count = new_chunk_count;
+        fill = new_fill;
+        external = false;
+        owned_slots.assign(chunk_count, -1);
+        owned_data.clear();
+        allocated = 0;
+        refresh_views();
+    }
+
+    // Point the views at external memory; the caller keeps that memory alive
+    void attach(const int32_t* external_slots, const T* external_data,
+                size_t external_chunk_count, size_t external_allocated, T new_fill) {
+        owned_slots.clear();
+        owned_data.clear();
+        owned_slots.shrink_to_fit();
+        owned_data.shrink_to_fit();
+        external = true;
+        slots = external_slots;
+        data = external_data;
+        chunk_count = external_chunk_count;
+        allocated = external_allocated;
+        fill = new_fill;
+    }
+
+    bool is_external() const { return external; }
+
+    bool is_allocated(int chunk) const { return slots[chunk] >= 0; }
+
+    // Payload of an allocated chunk
+    const T* chunk_data(int chunk) const {
+        return data + static_cast<size_t>(slots[chunk]) * ELEMENTS_PER_CHUNK;
+    }
+
+    // Writable payload of a chunk, allocating it (filled with fill) if needed
+    T* writable_chunk(int chunk) {
+        make_owned();
+        int32_t& slot = owned_slots[chunk];
+        if (slot < 0) {
+            slot = static_cast<int32_t>(allocated++);
+            owned_data.resize(allocated * ELEMENTS_PER_CHUNK, fill);
+            refresh_views();
+        }
+        return owned_data.data() + static_cast<size_t>(slot) * ELEMENTS_PER_CHUNK;
+    }
+
+    // Writable payload of an already allocated chunk, or nullptr if it is not allocated
+    T* writable_existing_chunk(int chunk) {
+        if (!is_allocated(chunk)) {
+            return nullptr;
+        }
+        make_owned();
+        return owned_data.data() + static_cast<size_t>(owned_slots[chunk]) * ELEMENTS_PER_CHUNK;
+    }
+
+    // Drop chunks whose elements all equal fill and compact the payload storage
+    void release_uniform_chunks() {
+        make_owned();
+        std::vector<T> compacted;
+        compacted.reserve(owned_data.size());
+        for (auto& slot : owned_slots) {
+            if (slot < 0) continue;
+            const auto first = owned_data.begin() + static_cast<size_t>(slot) * ELEMENTS_PER_CHUNK;
+            const bool uniform = std::all_of(first, first + ELEMENTS_PER_CHUNK,
+                                             [this](const T& value) { return value == fill; });
+            if (uniform) {
+                slot = -1;
+            } else {
+                slot = static_cast<int32_t>(compacted.size() / ELEMENTS_PER_CHUNK);
+                compacted.insert(compacted.end(), first, first + ELEMENTS_PER_CHUNK);
+            }
+        }
+        owned_data.swap(compacted);
+        allocated = owned_data.size() / ELEMENTS_PER_CHUNK;
+        refresh_views();
+    }
+
+    // True if both storages hold the same chunk table and payloads
+    bool same_contents(const ChunkStorage& other) const {
+        return chunk_count == other.chunk_count && allocated == other.allocated &&
+               std::equal(slots, slots + chunk_count, other.slots) &&
+               std::equal(data, data + allocated * ELEMENTS_PER_CHUNK, other.data);
+    }
+
+    static size_t bytes_per_chunk() { return ELEMENTS_PER_CHUNK * sizeof(T); }
+
+    // Bytes used by the chunk table plus allocated chunks
+    size_t memory_bytes() const {
+        return chunk_count * sizeof(int32_t) + allocated * bytes_per_chunk();
+    }
+
+private:
+    std::vector<int32_t> owned_slots;
+    std::vector<T> owned_data;
+    bool external = false;
+
+    void refresh_views() {
+        slots = owned_slots.data();
+        data = owned_data.data();
+    }
+
+    // Copy-on-write: bring external storage into owned memory before modifying it
+    void make_owned() {
+        if (!external) {
+            return;
+        }
+        owned_slots.assign(slots, slots + chunk_count);
+        owned_data.assign(data, data + allocated * ELEMENTS_PER_CHUNK);
+        external = false;
+        refresh_views();
+    }
+};
+
+// Sparse bit grid made of CHUNK_SIZE x CHUNK_SIZE chunks.
+// Each allocated chunk stores one 64-bit word per row, so a lookup is a
+// chunk-table read followed by a shift and a mask. Unallocated chunks read as 0.
+struct ChunkedBitGrid {
+    // Data
+    int width = 0;
+    int height = 0;
+    int chunks_x = 0;
+    int chunks_y = 0;
+    ChunkStorage<uint64_t, CHUNK_SIZE> storage; // CHUNK_SIZE row words per allocated chunk
+
+    // Resize the grid and release every chunk (all bits clear)
+    void resize(int new_width, int new_height);
+
+    // Release every chunk, keeping the current dimensions
+    void clear();
+
+    // Use external chunk table and row words (e.g. a mapped world file) without copying
+    void attach(int new_width, int new_height, const int32_t* slots, const uint64_t* rows, size_t allocated);
+
+    bool in_bounds(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    int chunk_index(int x, int y) const {
+        return (y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT);
+    }
+
+    // Bit test without bounds checking (caller guarantees in_bounds)
+    bool is_set(int x, int y) const {
+        const int32_t slot = storage.slots[chunk_index(x, y)];
+        if (slot < 0) {
+            return false;
+        }
+        const uint64_t row = storage.data[static_cast<size_t>(slot) * CHUNK_SIZE + (y & CHUNK_MASK)];
+        return ((row >> (x & CHUNK_MASK)) & 1u) != 0;
+    }
+
+    // Set or clear a bit for an in-bounds cell (out-of-bounds is ignored).
+    // Setting a bit allocates its chunk; clearing never allocates.
+    void set(int x, int y, bool value);
+
+    bool is_chunk_allocated(int chunk) const { return storage.is_allocated(chunk); }
+
+    // Row word of an allocated chunk (bit i = cell chunk_x * CHUNK_SIZE + i)
+    uint64_t chunk_row(int chunk, int row) const {
+        return storage.chunk_data(chunk)[row];
+    }
+
+    // Bits of the 64 cells x..x+63 of row y (bit i = cell x + i); x may be negative.
+    // Cells outside the grid read as set, so scans stop at the map edge.
+    uint64_t row_bits(int x, int y) const {
+        if (y < 0 || y >= height) {
+            return ~uint64_t{0};
+        }
+        const int first_chunk_x = x >= 0 ? (x >> CHUNK_SHIFT) : -((CHUNK_MASK - x) >> CHUNK_SHIFT);
+        const int offset = x - first_chunk_x * CHUNK_SIZE;
+        const uint64_t low = chunk_row_bits(first_chunk_x, y) >> offset;
+        return offset == 0 ? low : low | (chunk_row_bits(first_chunk_x + 1, y) << (CHUNK_SIZE - offset));
+    }
+
+    // Row word of row y in chunk column chunk_x, with cells outside the grid set
+    uint64_t chunk_row_bits(int chunk_x, int y) const {
+        if (chunk_x < 0 || chunk_x >= chunks_x) {
+            return ~uint64_t{0};
+        }
+        const int chunk = (y >> CHUNK_SHIFT) * chunks_x + chunk_x;
+        uint64_t bits = is_chunk_allocated(chunk) ? chunk_row(chunk, y & CHUNK_MASK) : 0;
+        const int valid_columns = width - (chunk_x << CHUNK_SHIFT);
+        if (valid_columns < CHUNK_SIZE) {
+            bits |= ~uint64_t{0} << valid_columns;
+        }
+        return bits;
+    }
+
+    // OR CHUNK_SIZE row words into a chunk, allocating it only if any bit is set
+    void merge_chunk_rows(int chunk, const uint64_t* rows);
+
+    // Drop chunks whose bits are all clear and compact the storage
+    void release_empty_chunks() { storage.release_uniform_chunks(); }
+
+    // Number of set bits currently in the grid
+    size_t count_set() const;
+
+    size_t chunk_count() const { return storage.chunk_count; }
+    size_t allocated_chunk_count() const { return storage.allocated; }
+    static size_t bytes_per_chunk() { return decltype(storage)::bytes_per_chunk(); }
+
+    // Bytes used by the chunk table plus allocated chunks
+    size_t memory_bytes() const { return storage.memory_bytes(); }
+
+    // Calls fn(x, y) for every set bit, visiting only allocated chunks
+    template <typename Fn>
+    void for_each_set(Fn&& fn) const {
+        for (int cy = 0; cy < chunks_y; ++cy) {
+            for (int cx = 0; cx < chunks_x; ++cx) {
+                const int chunk = cy * chunks_x + cx;
+                if (!is_chunk_allocated(chunk)) continue;
+                for (int row = 0; row < CHUNK_SIZE; ++row) {
+                    uint64_t bits = chunk_row(chunk, row);
+                    while (bits) {
+                        const int bit = lowest_set_bit(bits);
+                        bits &= bits - 1;
+                        fn((cx << CHUNK_SHIFT) + bit, (cy << CHUNK_SHIFT) + row);
+                    }
+                }
+            }
+        }
+    }
+};
+
+// Sparse per-cell value field using the same chunk layout as ChunkedBitGrid.
+// Unallocated chunks read as empty_value(); writing any cell allocates its chunk.
+template <typename T>
+struct ChunkedField {
+    // Data
+    int width = 0;
+    int height = 0;
+    int chunks_x = 0;
+    int chunks_y = 0;
+    ChunkStorage<T, CHUNK_CELLS> storage; // CHUNK_CELLS values per allocated chunk, row-major
+
+    // Resize the field and release every chunk (all cells read as fill)
+    void resize(int new_width, int new_height, T fill) {
+        width = new_width;
+        height = new_height;
+        chunks_x = (width + CHUNK_MASK) >> CHUNK_SHIFT;
+        chunks_y = (height + CHUNK_MASK) >> CHUNK_SHIFT;
+        storage.reset(static_cast<size_t>(chunks_x) * chunks_y, fill);
+    }
+
+    // Release every chunk, keeping the current dimensions
+    void clear() {
+        storage.reset(storage.chunk_count, storage.fill);
+    }
+
+    // Use external chunk table and cells (e.g. a mapped world file) without copying
+    void attach(int new_width, int new_height, const int32_t* slots, const T* cells, size_t allocated, T fill) {
+        width = new_width;
+        height = new_height;
+        chunks_x = (width + CHUNK_MASK) >> CHUNK_SHIFT;
+        chunks_y = (height + CHUNK_MASK) >> CHUNK_SHIFT;
+        storage.attach(slots, cells, static_cast<size_t>(chunks_x) * chunks_y, allocated, fill);
+    }
+
+    bool in_bounds(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    T empty_value() const { return storage.fill; }
+
+    // Value lookup without bounds checking (caller guarantees in_bounds)
+    T get(int x, int y) const {
+        const int32_t slot = storage.slots[(y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT)];
+        if (slot < 0) {
+            return storage.fill;
+        }
+        return storage.data[static_cast<size_t>(slot) * CHUNK_CELLS + ((y & CHUNK_MASK) << CHUNK_SHIFT) + (x & CHUNK_MASK)];
+    }
+
+    // Store a value for an in-bounds cell, allocating its chunk on first write
+    void set(int x, int y, T value) {
+        T* cells = storage.writable_chunk((y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT));
+        cells[((y & CHUNK_MASK) << CHUNK_SHIFT) + (x & CHUNK_MASK)] = value;
+    }
+
+    size_t allocated_chunk_count() const { return storage.allocated; }
+    static size_t bytes_per_chunk() { return decltype(storage)::bytes_per_chunk(); }
+
+    // Bytes used by the chunk table plus allocated chunks
+    size_t memory_bytes() const { return storage.memory_bytes(); }
+};
+
+#endif // CHUNKED_GRID_H
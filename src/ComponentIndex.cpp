@@ -0,0 +1,304 @@
+#include "ComponentIndex.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+const uint32_t UNASSIGNED = 0xFFFFFFFF;
+
+// Union-find root with path halving
+template <typename Index>
+Index find_root(Index* parent, Index node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+// Join two sets, keeping the smaller index as root so labels do not depend on merge order
+template <typename Index>
+void unite(Index* parent, Index a, Index b) {
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a < b) {
+        parent[b] = a;
+    } else if (b < a) {
+        parent[a] = b;
+    }
+}
+
+} // namespace
+
+int ComponentIndex::label_chunk(const ChunkedBitGrid& grid, int chunk, uint16_t* labels) {
+    // A horizontal run of free cells [start, end] within one chunk row
+    struct Run {
+        uint8_t row;
+        uint8_t start;
+        uint8_t end;
+    };
+    const int MAX_RUNS = CHUNK_CELLS / 2; // Alternating free/blocked cells
+    Run runs[MAX_RUNS];
+    uint16_t parent[MAX_RUNS];
+
+    const int base_x = (chunk % grid.chunks_x) << CHUNK_SHIFT;
+    const int base_y = (chunk / grid.chunks_x) << CHUNK_SHIFT;
+    const int columns = std::min(CHUNK_SIZE, grid.width - base_x);
+    const int rows = std::min(CHUNK_SIZE, grid.height - base_y);
+    const uint64_t column_mask = columns == CHUNK_SIZE ? ~uint64_t{0} : (uint64_t{1} << columns) - 1;
+    const bool allocated = grid.is_chunk_allocated(chunk);
+
+    // Collect the runs row by row, joining each with the runs of the row above that
+    // touch it, diagonals included
+    int run_count = 0;
+    int previous_begin = 0;
+    int previous_end = 0;
+    for (int row = 0; row < rows; ++row) {
+        uint64_t free_cells = ~(allocated ? grid.chunk_row(chunk, row) : 0) & column_mask;
+        const int row_begin = run_count;
+        while (free_cells) {
+            const int start = lowest_set_bit(free_cells);
+            const uint64_t after_run = ~(free_cells >> start);
+            const int end = after_run ? start + lowest_set_bit(after_run) - 1 : CHUNK_SIZE - 1;
+            free_cells = end == CHUNK_SIZE - 1 ? 0 : free_cells & (~uint64_t{0} << (end + 1));
+
+            const uint16_t index = static_cast<uint16_t>(run_count++);
+            runs[index] = {static_cast<uint8_t>(row), static_cast<uint8_t>(start), static_cast<uint8_t>(end)};
+            parent[index] = index;
+            for (int above = previous_begin; above < previous_end; ++above) {
+                if (runs[above].start <= end + 1 && start <= runs[above].end + 1) {
+                    unite<uint16_t>(parent, static_cast<uint16_t>(above), index);
+                }
+            }
+        }
+        previous_begin = row_begin;
+        previous_end = run_count;
+    }
+
+    // Number the components in order of their first run
+    uint16_t component_of_root[MAX_RUNS];
+    int component_count = 0;
+    for (int i = 0; i < run_count; ++i) {
+        const uint16_t root = find_root<uint16_t>(parent, static_cast<uint16_t>(i));
+        if (root == i) {
+            component_of_root[i] = static_cast<uint16_t>(component_count++);
+        }
+    }
+
+    // Per-cell labels are only needed to tell several components apart
+    if (component_count > 1) {
+        std::fill(labels, labels + CHUNK_CELLS, uint16_t{0});
+        for (int i = 0; i < run_count; ++i) {
+            const Run& run = runs[i];
+            uint16_t* row_labels = labels + (run.row << CHUNK_SHIFT);
+            std::fill(row_labels + run.start, row_labels + run.end + 1,
+                      component_of_root[find_root<uint16_t>(parent, static_cast<uint16_t>(i))]);
+        }
+    }
+    return component_count;
+}
+
+void ComponentIndex::store_labels(int chunk, const uint16_t* labels, int count) {
+    if (count > 1) {
+        std::copy(labels, labels + CHUNK_CELLS, local_labels.storage.writable_chunk(chunk));
+    } else if (uint16_t* cells = local_labels.storage.writable_existing_chunk(chunk)) {
+        std::fill(cells, cells + CHUNK_CELLS, uint16_t{0});
+    }
+    chunk_component_count[chunk] = static_cast<uint16_t>(count);
+}
+
+void ComponentIndex::compute_links(const ChunkedBitGrid& grid, int chunk) {
+    std::vector<ComponentLink>& links = chunk_links[chunk];
+    links.clear();
+
+    const int cx = chunk % chunks_x;
+    const int cy = chunk / chunks_x;
+    const int base_x = cx << CHUNK_SHIFT;
+    const int base_y = cy << CHUNK_SHIFT;
+    const int last_x = base_x + CHUNK_MASK;
+    const int last_y = base_y + CHUNK_MASK;
+
+    auto is_free = [&](int x, int y) { return grid.in_bounds(x, y) && !grid.is_set(x, y); };
+    auto try_link = [&](int x, int y, int nx, int ny, uint8_t direction) {
+        if (is_free(x, y) && is_free(nx, ny)) {
+            links.push_back({local_labels.get(x, y), local_labels.get(nx, ny), direction});
+        }
+    };
+
+    const bool has_east = cx + 1 < chunks_x;
+    const bool has_south = cy + 1 < chunks_y;
+    if (has_east) {
+        // Cells of the east chunk's first column within the same chunk row
+        for (int y = base_y; y <= last_y; ++y) {
+            for (int ny = std::max(base_y, y - 1); ny <= std::min(last_y, y + 1); ++ny) {
+                try_link(last_x, y, last_x + 1, ny, 0);
+            }
+        }
+    }
+    if (has_south) {
+        for (int x = base_x; x <= last_x; ++x) {
+            for (int nx = std::max(base_x, x - 1); nx <= std::min(last_x, x + 1); ++nx) {
+                try_link(x, last_y, nx, last_y + 1, 1);
+            }
+        }
+    }
+    if (has_east && has_south) {
+        try_link(last_x, last_y, last_x + 1, last_y + 1, 2);
+    }
+    if (cx > 0 && has_south) {
+        try_link(base_x, last_y, base_x - 1, last_y + 1, 3);
+    }
+
+    std::sort(links.begin(), links.end());
+    links.erase(std::unique(links.begin(), links.end()), links.end());
+    links.shrink_to_fit(); // Usually one link per direction remains out of up to ~190 candidates
+}
+
+void ComponentIndex::join_components() {
+    const size_t chunk_count = chunk_component_count.size();
+    chunk_first_node.resize(chunk_count + 1);
+    chunk_first_node[0] = 0;
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        chunk_first_node[chunk + 1] = chunk_first_node[chunk] + chunk_component_count[chunk];
+    }
+
+    const uint32_t node_count = chunk_first_node[chunk_count];
+    std::vector<uint32_t> parent(node_count);
+    std::iota(parent.begin(), parent.end(), 0u);
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        for (const ComponentLink& link : chunk_links[chunk]) {
+            const int neighbor = static_cast<int>(chunk) + LINK_DIRECTIONS[link.direction][0] +
+                                 LINK_DIRECTIONS[link.direction][1] * chunks_x;
+            unite<uint32_t>(parent.data(), chunk_first_node[chunk] + link.local,
+                            chunk_first_node[neighbor] + link.neighbor_local);
+        }
+    }
+
+    // Dense global ids in node order
+    node_component.assign(node_count, UNASSIGNED);
+    component_count = 0;
+    for (uint32_t node = 0; node < node_count; ++node) {
+        const uint32_t root = find_root<uint32_t>(parent.data(), node);
+        if (node_component[root] == UNASSIGNED) {
+            node_component[root] = static_cast<uint32_t>(component_count++);
+        }
+        node_component[node] = node_component[root];
+    }
+}
+
+void ComponentIndex::build(const ChunkedBitGrid& grid, ThreadPool& pool) {
+    chunks_x = grid.chunks_x;
+    chunks_y = grid.chunks_y;
+    local_labels.resize(grid.width, grid.height, 0);
+
+    const size_t chunk_count = grid.chunk_count();
+    chunk_component_count.assign(chunk_count, 0);
+    chunk_links.assign(chunk_count, {});
+
+    // Chunks are labeled in parallel; only the few with several components keep
+    // their labels until they are stored (storage allocation is not thread-safe)
+    std::vector<std::vector<uint16_t>> split_chunk_labels(chunk_count);
+    pool.parallel_for(chunk_count, [&](size_t chunk) {
+        std::vector<uint16_t> labels(CHUNK_CELLS);
+        const int count = label_chunk(grid, static_cast<int>(chunk), labels.data());
+        chunk_component_count[chunk] = static_cast<uint16_t>(count);
+        if (count > 1) {
+            split_chunk_labels[chunk].swap(labels);
+        }
+    });
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        if (!split_chunk_labels[chunk].empty()) {
+            store_labels(static_cast<int>(chunk), split_chunk_labels[chunk].data(), chunk_component_count[chunk]);
+        }
+    }
+
+    pool.parallel_for(chunk_count, [&](size_t chunk) { compute_links(grid, static_cast<int>(chunk)); });
+    links_valid = true;
+    join_components();
+}
+
+void ComponentIndex::update_chunks(const ChunkedBitGrid& grid, const std::vector<int>& chunks) {
+    std::vector<uint16_t> labels(CHUNK_CELLS);
+    for (int chunk : chunks) {
+        store_labels(chunk, labels.data(), label_chunk(grid, chunk, labels.data()));
+    }
+
+    if (!links_valid) {
+        // Labels came from a world file without links: compute them all once
+        chunk_links.resize(chunk_component_count.size());
+        for (size_t chunk = 0; chunk < chunk_links.size(); ++chunk) {
+            compute_links(grid, static_cast<int>(chunk));
+        }
+        links_valid = true;
+    } else {
+        // A chunk's links are stored by itself and by its west, north-west, north and
+        // north-east neighbors, all of which may now point at changed labels
+        std::vector<int> relink;
+        for (int chunk : chunks) {
+            const int cx = chunk % chunks_x;
+            const int cy = chunk / chunks_x;
+            const int owners[5][2] = {{0, 0}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+            for (const auto& owner : owners) {
+                const int ox = cx + owner[0];
+                const int oy = cy + owner[1];
+                if (ox >= 0 && ox < chunks_x && oy >= 0) {
+                    relink.push_back(oy * chunks_x + ox);
+                }
+            }
+        }
+        std::sort(relink.begin(), relink.end());
+        relink.erase(std::unique(relink.begin(), relink.end()), relink.end());
+        for (int chunk : relink) {
+            compute_links(grid, chunk);
+        }
+    }
+
+    join_components();
+}
+
+bool ComponentIndex::attach_labels(int width, int height, const int32_t* label_slots, const uint16_t* label_cells,
+                                   size_t allocated, const uint16_t* counts, const uint32_t* components,
+                                   size_t node_count) {
+    local_labels.attach(width, height, label_slots, label_cells, allocated, 0);
+    chunks_x = local_labels.chunks_x;
+    chunks_y = local_labels.chunks_y;
+    const size_t chunk_count = local_labels.storage.chunk_count;
+    chunk_component_count.assign(counts, counts + chunk_count);
+    chunk_first_node.resize(chunk_count + 1);
+    chunk_first_node[0] = 0;
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        chunk_first_node[chunk + 1] = chunk_first_node[chunk] + chunk_component_count[chunk];
+    }
+    if (chunk_first_node[chunk_count] != node_count) {
+        return false;
+    }
+
+    // Every stored label must name one of its chunk's components
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        if (!local_labels.storage.is_allocated(static_cast<int>(chunk))) continue;
+        const uint16_t* cells = local_labels.storage.chunk_data(static_cast<int>(chunk));
+        const uint16_t largest = *std::max_element(cells, cells + CHUNK_CELLS);
+        if (largest != 0 && largest >= chunk_component_count[chunk]) {
+            return false;
+        }
+    }
+
+    node_component.assign(components, components + node_count);
+    component_count = node_count == 0 ? 0 : *std::max_element(node_component.begin(), node_component.end()) + 1;
+    chunk_links.assign(chunk_count, {});
+    links_valid = false;
+    return true;
+}
+
+size_t ComponentIndex::memory_bytes() const {
+    size_t link_bytes = chunk_links.size() * sizeof(std::vector<ComponentLink>);
+    for (const auto& links : chunk_links) {
+        link_bytes += links.capacity() * sizeof(ComponentLink);
+    }
+    return local_labels.memory_bytes() +
+           chunk_component_count.size() * sizeof(uint16_t) +
+           chunk_first_node.size() * sizeof(uint32_t) +
+           node_component.size() * sizeof(uint32_t) +
+           link_bytes;
+}
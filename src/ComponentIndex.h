@@ -0,0 +1,84 @@
+#ifndef COMPONENT_INDEX_H
+#define COMPONENT_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include "ChunkedGrid.h"
+
+class ThreadPool;
+
+// Connected-component labels for the walkable cells of a ChunkedBitGrid
+// (8-connected, the same moves find_path makes).
+//
+// Each chunk is labeled on its own from the runs of free cells in its row words;
+// the chunk-local components ("nodes") are then joined across chunk borders by a
+// small union-find over precomputed border links. Changing obstacles only relabels
+// the touched chunks and re-runs that union-find, never a search over cells.
+struct ComponentIndex {
+    // A border connection from a chunk to its east, south, south-east or south-west neighbor
+    struct ComponentLink {
+        uint16_t local;          // Component inside this chunk
+        uint16_t neighbor_local; // Component inside the neighbor chunk
+        uint8_t direction;       // Index into LINK_DIRECTIONS
+
+        bool operator<(const ComponentLink& other) const {
+            if (direction != other.direction) return direction < other.direction;
+            if (local != other.local) return local < other.local;
+            return neighbor_local < other.neighbor_local;
+        }
+        bool operator==(const ComponentLink& other) const {
+            return direction == other.direction && local == other.local && neighbor_local == other.neighbor_local;
+        }
+    };
+
+    // Neighbor chunk offsets links point to (each chunk pair is stored only once)
+    static constexpr int LINK_DIRECTIONS[4][2] = {{1, 0}, {0, 1}, {1, 1}, {-1, 1}};
+
+    // Data
+    int chunks_x = 0;
+    int chunks_y = 0;
+    ChunkedField<uint16_t> local_labels;            // Chunk-local component of each walkable cell; chunks with
+                                                    // at most one component stay unallocated (all 0)
+    std::vector<uint16_t> chunk_component_count;    // Number of local components per chunk
+    std::vector<uint32_t> chunk_first_node;         // Prefix sums of the counts (chunk_count + 1 entries)
+    std::vector<uint32_t> node_component;           // Global component id of every chunk-local component
+    std::vector<std::vector<ComponentLink>> chunk_links; // Border links per chunk (sorted, unique)
+    bool links_valid = false;                       // False after loading labels without links
+    size_t component_count = 0;
+
+    // Label every chunk of grid from scratch, one chunk per pool task
+    void build(const ChunkedBitGrid& grid, ThreadPool& pool);
+
+    // Relabel the given chunks after their obstacles changed and rejoin the components
+    void update_chunks(const ChunkedBitGrid& grid, const std::vector<int>& chunks);
+
+    // Global component of a walkable cell (caller guarantees the cell is walkable)
+    uint32_t component_at(int x, int y) const {
+        const int chunk = (y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT);
+        return node_component[chunk_first_node[chunk] + local_labels.get(x, y)];
+    }
+
+    // Use labels saved in a world file (label chunks stay in external memory) without
+    // border links; those are computed on the first update_chunks() call.
+    // Returns false if the tables are inconsistent.
+    bool attach_labels(int width, int height, const int32_t* label_slots, const uint16_t* label_cells,
+                       size_t allocated, const uint16_t* counts, const uint32_t* components, size_t node_count);
+
+    // Bytes used by labels, per-chunk tables and links
+    size_t memory_bytes() const;
+
+    // Label one chunk into labels (CHUNK_CELLS entries) and return its component count
+    static int label_chunk(const ChunkedBitGrid& grid, int chunk, uint16_t* labels);
+
+private:
+    // Store freshly computed labels for a chunk (count <= 1 keeps or makes it all 0)
+    void store_labels(int chunk, const uint16_t* labels, int count);
+
+    // Recompute the border links of one chunk from the current labels
+    void compute_links(const ChunkedBitGrid& grid, int chunk);
+
+    // Prefix sums, union-find over every link, and dense component ids
+    void join_components();
+};
+
+#endif // COMPONENT_INDEX_H
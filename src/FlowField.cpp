@@ -0,0 +1,116 @@
+#include "FlowField.h"
+#include "World.h"
+
+#include <algorithm> // For std::min, std::max
+
+void FlowField::reset(const Vec2D& target, const World& new_world, int radius) {
+    const int new_side = 2 * radius + 1;
+    if (new_side != side) {
+        side = new_side;
+        distances.assign(static_cast<size_t>(side) * side, UNREACHED);
+    } else {
+        for (const Vec2D& pos : frontier) {
+            cell(pos) = UNREACHED; // Only the cells the last field reached were written
+        }
+    }
+    world = &new_world;
+    target_cell = target;
+    origin = {target.x - radius, target.y - radius};
+    frontier.clear();
+    head = 0;
+    if (new_world.is_walkable(target)) {
+        cell(target) = 0;
+        frontier.push_back(target);
+    }
+}
+
+int FlowField::distance(const Vec2D& pos) {
+    if (!in_window(pos)) {
+        return -1;
+    }
+    // Moves are symmetric, so steps from the target are steps to it. A cell gets its
+    // final distance when it is first reached, so expand only until pos is.
+    while (cell(pos) == UNREACHED && head < frontier.size()) {
+        const Vec2D current = frontier[head++];
+        if (cell(current) + 1 >= UNREACHED) {
+            break; // Distances past 16 bits (only in huge windows)
+        }
+        const uint16_t next_distance = static_cast<uint16_t>(cell(current) + 1);
+        for (const Vec2D& offset : World::NEIGHBOR_OFFSETS) {
+            const Vec2D neighbor = {current.x + offset.x, current.y + offset.y};
+            if (in_window(neighbor) && cell(neighbor) == UNREACHED && world->is_walkable(neighbor)) {
+                cell(neighbor) = next_distance;
+                frontier.push_back(neighbor);
+            }
+        }
+    }
+    const uint16_t steps = cell(pos);
+    return steps == UNREACHED ? -1 : steps;
+}
+
+bool FlowField::route(const Vec2D& pos, std::vector<Vec2D>& path) {
+    path.clear();
+    int remaining = distance(pos);
+    if (remaining < 0) {
+        return false;
+    }
+
+    // Every cell one step closer was reached before pos, so the descent never stalls
+    path.reserve(static_cast<size_t>(remaining) + 1);
+    Vec2D current = pos;
+    path.push_back(current);
+    while (remaining > 0) {
+        for (const Vec2D& offset : World::NEIGHBOR_OFFSETS) {
+            const Vec2D neighbor = {current.x + offset.x, current.y + offset.y};
+            if (in_window(neighbor) && cell(neighbor) == remaining - 1) {
+                current = neighbor;
+                break;
+            }
+        }
+        remaining--;
+        path.push_back(current);
+    }
+    return true;
+}
+
+size_t FlowField::memory_bytes() const {
+    return distances.capacity() * sizeof(uint16_t) + frontier.capacity() * sizeof(Vec2D);
+}
+
+FlowFieldCache& FlowFieldCache::shared() {
+    static FlowFieldCache cache;
+    return cache;
+}
+
+void FlowFieldCache::begin_tick() {
+    for (std::unique_ptr<FlowField>& field : active) {
+        pool.push_back(std::move(field));
+    }
+    active.clear();
+    by_target.clear();
+}
+
+FlowField& FlowFieldCache::field_for(const Vec2D& target, const World& current) {
+    counters.lookups++;
+    if (world != &current || world_version != current.obstacle_version) {
+        begin_tick(); // Fields describe the obstacles they were built on
+        world = &current;
+        world_version = current.obstacle_version;
+    }
+
+    auto found = by_target.find(cell_key(target));
+    if (found != by_target.end()) {
+        return *found->second;
+    }
+
+    if (pool.empty()) {
+        pool.push_back(std::unique_ptr<FlowField>(new FlowField()));
+    }
+    active.push_back(std::move(pool.back()));
+    pool.pop_back();
+    FlowField& field = *active.back();
+    field.reset(target, current, std::max(1, radius));
+    by_target[cell_key(target)] = &field;
+    counters.fields_built++;
+    return field;
+}
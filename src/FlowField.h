@@ -0,0 +1,94 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "Vec2D.h"
+
+struct World;
+
+// Breadth-first distance field toward one target cell (8-connected unit-cost moves,
+// like find_path), limited to a square window around the target. The search only
+// grows as far as the cells asked about, so a field serving chasers 20 cells away
+// never visits the rest of the window.
+class FlowField {
+public:
+    static constexpr uint16_t UNREACHED = 0xFFFF;
+
+    // Start a new field toward target, covering cells up to radius steps away per axis
+    void reset(const Vec2D& target, const World& world, int radius);
+
+    // Steps from pos to the target, or -1 if pos cannot reach it inside the window
+    int distance(const Vec2D& pos);
+
+    // Path from pos down the gradient to the target (pos first, target last; same
+    // contract as find_path). Returns false (path empty) if distance(pos) is -1.
+    bool route(const Vec2D& pos, std::vector<Vec2D>& path);
+
+    const Vec2D& target() const { return target_cell; }
+    size_t reached_count() const { return frontier.size(); }
+    size_t memory_bytes() const;
+
+private:
+    bool in_window(const Vec2D& pos) const {
+        return pos.x >= origin.x && pos.x < origin.x + side && pos.y >= origin.y && pos.y < origin.y + side;
+    }
+    uint16_t& cell(const Vec2D& pos) { return distances[(pos.y - origin.y) * side + (pos.x - origin.x)]; }
+
+    const World* world = nullptr;
+    Vec2D target_cell;
+    Vec2D origin;                  // Top-left cell of the window
+    int side = 0;                  // Window width and height
+    std::vector<uint16_t> distances; // side * side, UNREACHED outside the cells in frontier
+    std::vector<Vec2D> frontier;   // Every reached cell in BFS order
+    size_t head = 0;               // Next cell of frontier to expand
+};
+
+// Per-tick flow fields shared by every chaser with the same target cell.
+//
+// field_for() builds a field the first time a target is asked for in a tick and
+// hands the same field to every later caller. begin_tick() returns the tick's fields
+// to a pool, and new fields reuse their memory. A field also only lives as long as
+// the world's obstacle_version it was built for.
+class FlowFieldCache {
+public:
+    static constexpr int DEFAULT_RADIUS = 96;
+
+    struct Stats {
+        uint64_t fields_built = 0; // Distinct targets per tick
+        uint64_t lookups = 0;      // field_for calls
+    };
+
+    // Start a new tick: every field built so far goes back to the pool
+    void begin_tick();
+
+    // This tick's field toward target
+    FlowField& field_for(const Vec2D& target, const World& world);
+
+    // Window radius of new fields; 0 turns flow fields off (enabled() is false)
+    void set_radius(int cells) { radius = cells; }
+    bool enabled() const { return radius > 0; }
+
+    const Stats& stats() const { return counters; }
+
+    // Cache used by the predators of the running simulation (off until set_radius)
+    static FlowFieldCache& shared();
+
+private:
+    static uint64_t cell_key(const Vec2D& cell) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cell.y)) << 32) | static_cast<uint32_t>(cell.x);
+    }
+
+    int radius = 0;
+    const World* world = nullptr;
+    uint64_t world_version = 0;
+    std::vector<std::unique_ptr<FlowField>> active; // Fields of the current tick
+    std::vector<std::unique_ptr<FlowField>> pool;   // Spare fields
+    std::unordered_map<uint64_t, FlowField*> by_target;
+    Stats counters;
+};
+
+#endif // FLOW_FIELD_H
@@ -2,9 +2,17 @@
 #include "AIController.h"
 #include "CaptureLogic.h"
 #include "Renderer.h"
+#include "GridRenderer.h"
+#include "MovementController.h"
+#include "SimulationSetup.h"
+#include "FlowField.h"
+#include "PathService.h"
+#include "SpatialHash.h"
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <random>
 #include <conio.h>  // For _kbhit() and _getch()
 
 // Rendering constants
@@ -14,6 +22,48 @@ const int FRAME_DELAY_MS = 100;
 static std::vector<std::string> previous_display_rows;
 static bool first_frame = true;
 
+// Dynamic wall scenario: a short wall segment appears and disappears every
+// DYNAMIC_WALLS steps somewhere in the visible part of the map
+const int DYNAMIC_WALL_LENGTH = 6;
+static std::vector<Vec2D> dynamic_wall;
+
+// Positions the AI searches for closest sprites, rebuilt whenever the indexed side moves
+static SpatialHash prey_index;
+static SpatialHash predator_index;
+
+static bool is_occupied(const Vec2D& pos, const SpriteStore& predators, const SpriteStore& prey_sprites) {
+    return std::find(predators.position.begin(), predators.position.end(), pos) != predators.position.end() ||
+           std::find(prey_sprites.position.begin(), prey_sprites.position.end(), pos) != prey_sprites.position.end();
+}
+
+static void update_dynamic_walls(World& world, const SpriteStore& predators,
+                                 const SpriteStore& prey_sprites, int current_step) {
+    static const int interval = SimulationSetup::get_dynamic_wall_interval();
+    if (interval <= 0 || current_step == 0 || current_step % interval != 0) {
+        return;
+    }
+
+    if (!dynamic_wall.empty()) {
+        world.set_obstacles(dynamic_wall, false);
+        dynamic_wall.clear();
+        return;
+    }
+
+    std::uniform_int_distribution<> x_dist(1, GridRenderer::get_view_width(world) - 2);
+    std::uniform_int_distribution<> y_dist(1, GridRenderer::get_view_height(world) - 2);
+    std::uniform_int_distribution<> orientation_dist(0, 1);
+    const Vec2D origin = {x_dist(gen), y_dist(gen)};
+    const Vec2D step = orientation_dist(gen) == 0 ? Vec2D{1, 0} : Vec2D{0, 1};
+    for (int i = 0; i < DYNAMIC_WALL_LENGTH; ++i) {
+        const Vec2D cell = {origin.x + step.x * i, origin.y + step.y * i};
+        // Only free cells become wall, so removing it later restores the map exactly
+        if (world.is_walkable(cell) && !world.is_in_safe_zone(cell) && !is_occupied(cell, predators, prey_sprites)) {
+            dynamic_wall.push_back(cell);
+        }
+    }
+    world.set_obstacles(dynamic_wall, true);
+}
+
 namespace GameLogic {
 
 bool handle_user_input(bool& show_paths) {
@@ -27,25 +77,46 @@ bool handle_user_input(bool& show_paths) {
     return false;
 }
 
-bool process_simulation_step(std::vector<Sprite>& predators,
-                            std::vector<Sprite>& prey_sprites,
+bool process_simulation_step(SpriteStore& predators,
+                            SpriteStore& prey_sprites,
                             World& world,
                             int current_step,
                             int max_steps) {
+    // Collect the searches queued last tick; workers read the world, so before it changes
+    PathService::shared().sync();
+
+    // Apply scheduled obstacle changes, then drop only the paths they actually block
+    update_dynamic_walls(world, predators, prey_sprites, current_step);
+    for (SpriteStore* sprites : {&predators, &prey_sprites}) {
+        for (size_t i = 0; i < sprites->size(); ++i) {
+            // Most ticks place no walls: check the version column before building a SpriteRef
+            if (sprites->route[i].pathWorldVersion != world.obstacle_version) {
+                SpriteRef sprite = (*sprites)[i];
+                MovementController::invalidate_path_if_blocked(sprite, world);
+            }
+        }
+    }
+    FlowFieldCache::shared().begin_tick(); // Prey moved last tick: last tick's chase fields are stale
+
     // Process predators first - they are the priority
-    for (auto& predator_sprite : predators) {
+    prey_index.build(prey_sprites.position); // Prey hold still until the predators are done
+    for (size_t p_idx = 0; p_idx < predators.size(); ++p_idx) {
         // Update each predator - the AI controller handles speed
-        AIController::update_sprite_ai(predator_sprite, predators, prey_sprites, world);
+        SpriteRef predator = predators[p_idx];
+        AIController::update_sprite_ai(predator, prey_sprites, prey_index, world);
         
-        // Check for captures after the move
-        auto [captures, evasion_messages] = CaptureLogic::process_captures(predators, prey_sprites, world);
+        // Check for captures after the move (only this predator changed anything)
+        auto [captures, evasion_messages] = CaptureLogic::process_captures_after_move(predators, p_idx, prey_sprites, prey_index, world);
+        if (captures > 0 || !evasion_messages.empty()) {
+            prey_index.build(prey_sprites.position); // Caught prey were removed, evading ones moved
+        }
         
         // If any captures or evasions occurred, render and show messages
         if (captures > 0 || !evasion_messages.empty()) {
             // Render to show the capture/evasion
             Renderer::render_to_console(predators, prey_sprites, world, current_step, max_steps, previous_display_rows, first_frame, false);
             
-            std::cout << "\033[" << world.height + 3 << ";1H"; // Position cursor below status line
+            std::cout << "\033[" << GridRenderer::get_view_height(world) + 3 << ";1H"; // Position cursor below status line
             
             if (captures > 0) {
                 std::cout << "Prey captured! " << captures << " prey caught. " << prey_sprites.size() << " remaining.\033[K" << std::endl;
@@ -64,6 +135,7 @@ bool process_simulation_step(std::vector<Sprite>& predators,
             }
         }
     }
+    PathService::shared().dispatch(world); // Replans queued by the predators run while the prey move
     
     // Exit early if all prey captured
     if (prey_sprites.empty()) {
@@ -71,8 +143,10 @@ bool process_simulation_step(std::vector<Sprite>& predators,
     }
     
     // Update prey after predators have moved
-    for (auto& prey_sprite : prey_sprites) {
-        AIController::update_sprite_ai(prey_sprite, predators, prey_sprites, world);
+    predator_index.build(predators.position);
+    for (size_t i = 0; i < prey_sprites.size(); ++i) {
+        SpriteRef prey_sprite = prey_sprites[i];
+        AIController::update_sprite_ai(prey_sprite, predators, predator_index, world);
     }
     
     // Check for final captures after prey have moved
@@ -81,7 +155,7 @@ bool process_simulation_step(std::vector<Sprite>& predators,
     if (captures > 0 || !evasion_messages.empty()) {
         // Render to show the capture/evasion
         Renderer::render_to_console(predators, prey_sprites, world, current_step, max_steps, previous_display_rows, first_frame, false);
-        std::cout << "\033[" << world.height + 3 << ";1H"; // Position cursor below status line
+        std::cout << "\033[" << GridRenderer::get_view_height(world) + 3 << ";1H"; // Position cursor below status line
         
         if (captures > 0) {
             std::cout << "Prey captured after prey movement!\033[K" << std::endl;
@@ -107,8 +181,8 @@ bool process_simulation_step(std::vector<Sprite>& predators,
     return true; // Continue simulation
 }
 
-int run_simulation(std::vector<Sprite>& predators, 
-                  std::vector<Sprite>& prey_sprites,
+int run_simulation(SpriteStore& predators, 
+                  SpriteStore& prey_sprites,
                   World& world, 
                   int max_steps) {
     int current_step = 0;
@@ -136,6 +210,7 @@ int run_simulation(std::vector<Sprite>& predators,
         std::this_thread::sleep_for(std::chrono::milliseconds(FRAME_DELAY_MS));
         current_step++;
     }
+    PathService::shared().sync();
     
     // Show cursor again
     std::cout << "\033[?25h" << std::flush;
@@ -3,21 +3,21 @@
 
 #include <vector>
 #include <string>
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "World.h"
 
 namespace GameLogic {
     // Core game loop for predator-prey simulation
     // Returns number of steps completed
-    int run_simulation(std::vector<Sprite>& predators, 
-                       std::vector<Sprite>& prey_sprites,
+    int run_simulation(SpriteStore& predators, 
+                       SpriteStore& prey_sprites,
                        World& world, 
                        int max_steps);
     
     // Process a single simulation step
     // Returns true if simulation should continue, false if it should end
-    bool process_simulation_step(std::vector<Sprite>& predators,
-                                std::vector<Sprite>& prey_sprites,
+    bool process_simulation_step(SpriteStore& predators,
+                                SpriteStore& prey_sprites,
                                 World& world,
                                 int current_step,
                                 int max_steps);
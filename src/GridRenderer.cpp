@@ -1,5 +1,7 @@
 #include "GridRenderer.h"
+#include "PathfindingHelpers.h"
 #include <iostream>
+#include <algorithm>
 
 // ANSI escape codes
 const std::string ANSI_MOVE_CURSOR_TO_START = "\033[H";
@@ -20,40 +22,77 @@ namespace GridRenderer {
 
 const char pathChar = '.';
 
+int get_view_width(const World& world) {
+    return std::min(world.width, MAX_VIEW_WIDTH);
+}
+
+int get_view_height(const World& world) {
+    return std::min(world.height, MAX_VIEW_HEIGHT);
+}
+
 std::vector<std::string> prepare_display_grid(
-    const std::vector<Sprite>& predators,
-    const std::vector<Sprite>& prey_sprites,
+    const SpriteStore& predators,
+    const SpriteStore& prey_sprites,
     const World& world,
     bool show_paths
 ) {
-    // Initialize display rows with exactly world.width chars per row
-    std::vector<std::string> current_display_rows(world.height);
-    
-    // Create a basic grid of spaces
-    for (int r = 0; r < world.height; ++r) {
-        current_display_rows[r] = std::string(world.width, ' ');
-    }
+    const int view_width = get_view_width(world);
+    const int view_height = get_view_height(world);
+    auto in_view = [&](const Vec2D& pos) {
+        return pos.x >= 0 && pos.x < view_width && pos.y >= 0 && pos.y < view_height;
+    };
+
+    // Initialize display rows with exactly view_width chars per row (a grid of spaces)
+    std::vector<std::string> current_display_rows(view_height, std::string(view_width, ' '));
     
-    // Add obstacles first (no color codes yet, just character placement)
-    for (int r = 0; r < world.height; ++r) {
-        for (int c = 0; c < world.width; ++c) {
-            if (world.obstacles.count({c, r})) {
-                current_display_rows[r][c] = world.obstacleChar;
-            } else if (world.is_in_safe_zone({c,r})) { // Check after obstacles
-                current_display_rows[r][c] = world.safeZoneChar;
+    // Paint the set bits of a chunked layer onto empty display cells.
+    // Only allocated chunks overlapping the view are visited, one row word at a time.
+    auto paint_layer = [&](const ChunkedBitGrid& layer, char ch) {
+        const int view_chunks_x = std::min(layer.chunks_x, (view_width + CHUNK_MASK) >> CHUNK_SHIFT);
+        const int view_chunks_y = std::min(layer.chunks_y, (view_height + CHUNK_MASK) >> CHUNK_SHIFT);
+        for (int cy = 0; cy < view_chunks_y; ++cy) {
+            for (int cx = 0; cx < view_chunks_x; ++cx) {
+                const int chunk = cy * layer.chunks_x + cx;
+                if (!layer.is_chunk_allocated(chunk)) continue;
+
+                for (int row = 0; row < CHUNK_SIZE; ++row) {
+                    const int r = (cy << CHUNK_SHIFT) + row;
+                    if (r >= view_height) break;
+                    uint64_t bits = layer.chunk_row(chunk, row);
+                    while (bits) {
+                        const int c = (cx << CHUNK_SHIFT) + lowest_set_bit(bits);
+                        bits &= bits - 1;
+                        if (c >= view_width) break;
+                        if (current_display_rows[r][c] == ' ') {
+                            current_display_rows[r][c] = ch;
+                        }
+                    }
+                }
             }
         }
-    }
+    };
+
+    // Add obstacles first (no color codes yet, just character placement),
+    // then safe zones, which must not overwrite obstacles
+    paint_layer(world.grid, world.obstacleChar);
+    paint_layer(world.safe_zone_mask, world.safeZoneChar);
 
     // Draw Paths (if enabled) - Draw AFTER obstacles/zones but BEFORE sprites
     if (show_paths) {
-        auto draw_path = [&](const std::vector<Sprite>& sprites) {
-            for (const auto& sprite : sprites) {
-                if (!sprite.currentPath.empty()) {
-                    for (size_t i = 0; i < sprite.currentPath.size(); ++i) {
-                        const Vec2D& pos = sprite.currentPath[i];
+        std::vector<Vec2D> expanded_path; // Every step of a waypoint path
+        auto draw_path = [&](const SpriteStore& sprites) {
+            for (const SpriteRoute& route : sprites.route) {
+                const std::vector<Vec2D>* steps = &route.currentPath;
+                if (route.pathIsWaypoints) {
+                    expanded_path.clear();
+                    PathfindingHelpers::expand_waypoints(route.currentPath, expanded_path);
+                    steps = &expanded_path;
+                }
+                if (!steps->empty()) {
+                    for (size_t i = 0; i < steps->size(); ++i) {
+                        const Vec2D& pos = (*steps)[i];
                         // Check bounds and ensure we don't overwrite obstacles or existing sprites
-                        if (pos.y >= 0 && pos.y < world.height && pos.x >= 0 && pos.x < world.width) {
+                        if (in_view(pos)) {
                             if (current_display_rows[pos.y][pos.x] == ' ' || current_display_rows[pos.y][pos.x] == world.safeZoneChar) {
                                 // Only draw path on empty space or safe zones
                                 current_display_rows[pos.y][pos.x] = pathChar;
@@ -68,22 +107,21 @@ std::vector<std::string> prepare_display_grid(
     }
 
     // Add prey next (character placement only)
-    for (const auto& prey : prey_sprites) {
-        if (prey.position.y >= 0 && prey.position.y < world.height && 
-            prey.position.x >= 0 && prey.position.x < world.width) {
-            if (!world.obstacles.count(prey.position)) {
-                current_display_rows[prey.position.y][prey.position.x] = prey.displayChar;
+    for (size_t i = 0; i < prey_sprites.size(); ++i) {
+        const Vec2D& pos = prey_sprites.position[i];
+        if (in_view(pos)) {
+            if (!world.is_obstacle(pos)) {
+                current_display_rows[pos.y][pos.x] = prey_sprites.look[i].displayChar;
             }
         }
     }
 
     // Add predators last (character placement only)
     for (size_t i = 0; i < predators.size(); ++i) {
-        const auto& predator = predators[i];
-        if (predator.position.y >= 0 && predator.position.y < world.height && 
-            predator.position.x >= 0 && predator.position.x < world.width) {
+        const Vec2D& pos = predators.position[i];
+        if (in_view(pos)) {
             char predator_num = static_cast<char>('1' + i); // Convert index to character 1, 2, 3...
-            current_display_rows[predator.position.y][predator.position.x] = predator_num;
+            current_display_rows[pos.y][pos.x] = predator_num;
         }
     }
     
@@ -92,8 +130,8 @@ std::vector<std::string> prepare_display_grid(
 
 void draw_grid_to_console(
     const std::vector<std::string>& current_display_rows,
-    const std::vector<Sprite>& predators,
-    const std::vector<Sprite>& prey_sprites,
+    const SpriteStore& predators,
+    const SpriteStore& prey_sprites,
     const World& world,
     bool& first_frame
 ) {
@@ -112,14 +150,26 @@ void draw_grid_to_console(
         std::cout << ANSI_MOVE_CURSOR_TO_START << std::flush;
     }
     
+    const int view_width = get_view_width(world);
+    const int view_height = get_view_height(world);
+
+    // The first prey (in store order) on each cell of the view, -1 if none
+    std::vector<int> prey_at(static_cast<size_t>(view_width) * view_height, -1);
+    for (size_t i = prey_sprites.size(); i-- > 0;) {
+        const Vec2D& pos = prey_sprites.position[i];
+        if (pos.x >= 0 && pos.x < view_width && pos.y >= 0 && pos.y < view_height) {
+            prey_at[static_cast<size_t>(pos.y) * view_width + pos.x] = static_cast<int>(i);
+        }
+    }
+
     // Draw top border
-    std::cout << "+" << std::string(world.width, '-') << "+" << std::endl;
+    std::cout << "+" << std::string(view_width, '-') << "+" << std::endl;
     
     // Draw rows with borders and apply colors
-    for (int r = 0; r < world.height; ++r) {
+    for (int r = 0; r < view_height; ++r) {
         std::cout << "|";
         // Print each character with appropriate color
-        for (int c = 0; c < world.width; ++c) {
+        for (int c = 0; c < view_width; ++c) {
             char ch_on_grid = current_display_rows[r][c];
             std::string current_color = Color::RESET;
             char char_to_print = ch_on_grid;
@@ -137,16 +187,10 @@ void draw_grid_to_console(
                 color_set = true;
             } else if (ch_on_grid == 'Y') { // Prey
                 // Find the prey sprite at this location
-                const Sprite* current_prey = nullptr;
-                for (const auto& p_sprite : prey_sprites) {
-                    if (p_sprite.position.x == c && p_sprite.position.y == r) {
-                        current_prey = &p_sprite;
-                        break;
-                    }
-                }
-                if (current_prey) {
-                    if (current_prey->currentState == Sprite::AIState::FLEEING) {
-                        if (current_prey->currentFear > current_prey->maxFear * 0.75f) {
+                const int current_prey = prey_at[static_cast<size_t>(r) * view_width + c];
+                if (current_prey >= 0) {
+                    if (prey_sprites.state[current_prey] == Sprite::AIState::FLEEING) {
+                        if (prey_sprites.fear[current_prey] > prey_sprites.detail[current_prey].maxFear * 0.75f) {
                             current_color = ColorExt::BRIGHT_YELLOW;
                             char_to_print = '!';
                         } else {
@@ -165,12 +209,11 @@ void draw_grid_to_console(
             } else if (ch_on_grid >= '1' && ch_on_grid <= '9') { // Predator
                 int pred_idx = ch_on_grid - '1';
                 if (pred_idx < static_cast<int>(predators.size())) {
-                    const auto& predator = predators[pred_idx];
                     char_to_print = ch_on_grid; // Default to predator number
 
-                    switch (predator.currentState) {
+                    switch (predators.state[pred_idx]) {
                         case Sprite::AIState::SEEKING:
-                            current_color = (predator.currentStamina > 0) ? ColorExt::BRIGHT_RED : Color::RED;
+                            current_color = (predators.stamina[pred_idx] > 0) ? ColorExt::BRIGHT_RED : Color::RED;
                             break;
                         case Sprite::AIState::RESTING:
                             current_color = Color::CYAN;
@@ -205,7 +248,7 @@ void draw_grid_to_console(
     }
     
     // Draw bottom border
-    std::cout << "+" << std::string(world.width, '-') << "+" << std::endl;
+    std::cout << "+" << std::string(view_width, '-') << "+" << std::endl;
 }
 
 } // namespace GridRenderer 
\ No newline at end of file
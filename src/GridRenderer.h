@@ -3,15 +3,23 @@
 
 #include <vector>
 #include <string>
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "World.h"
 
 namespace GridRenderer {
+    // Console viewport limits - worlds larger than this show their top-left corner
+    const int MAX_VIEW_WIDTH = 120;
+    const int MAX_VIEW_HEIGHT = 40;
+
+    // Size of the rendered area for a given world (world size clamped to the viewport limits)
+    int get_view_width(const World& world);
+    int get_view_height(const World& world);
+
     // Initialize the display grid with all characters that will be displayed
     // Returns a vector of strings representing the grid with characters (without colors)
     std::vector<std::string> prepare_display_grid(
-        const std::vector<Sprite>& predators,
-        const std::vector<Sprite>& prey_sprites,
+        const SpriteStore& predators,
+        const SpriteStore& prey_sprites,
         const World& world,
         bool show_paths
     );
@@ -19,8 +27,8 @@ namespace GridRenderer {
     // Draw the grid to the console with borders and appropriate colors
     void draw_grid_to_console(
         const std::vector<std::string>& current_display_rows,
-        const std::vector<Sprite>& predators,
-        const std::vector<Sprite>& prey_sprites,
+        const SpriteStore& predators,
+        const SpriteStore& prey_sprites,
         const World& world,
         bool& first_frame
     );
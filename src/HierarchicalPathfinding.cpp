@@ -0,0 +1,179 @@
+#include "Pathfinding.h"
+#include "PathHierarchy.h"
+
+#include <algorithm> // For std::push_heap, std::pop_heap, std::reverse, std::max
+#include <cstdlib>   // For std::abs
+
+// HPA* query: a best-first search over the entrances of world.path_hierarchy, joined
+// to the start and goal cells through in-cluster distances, followed by refinement of
+// the first few abstract edges into cells with a regular A* search.
+
+namespace {
+
+// Scratch memory for the entrance-graph search, reused by every query on a thread
+struct AbstractSearch {
+    struct Entry {
+        int f;
+        int h;
+        int g;
+        uint32_t node;
+        int32_t cluster; // -1 for the start and goal nodes
+        int32_t index;   // Entrance index inside cluster
+    };
+
+    static bool after(const Entry& a, const Entry& b) {
+        return a.f != b.f ? a.f > b.f : a.h > b.h;
+    }
+
+    std::vector<uint32_t> stamp; // Generation that last reached each node
+    std::vector<int> g;
+    std::vector<uint32_t> parent;
+    std::vector<Vec2D> cell;
+    uint32_t generation = 0;
+    std::vector<Entry> heap;
+    std::vector<uint16_t> start_costs;
+    std::vector<uint16_t> goal_costs;
+    std::vector<Vec2D> waypoints;
+    std::vector<Vec2D> segment;
+
+    void begin(size_t node_count) {
+        if (stamp.size() != node_count) {
+            stamp.assign(node_count, 0);
+            g.resize(node_count);
+            parent.resize(node_count);
+            cell.resize(node_count);
+        }
+        generation++;
+        if (generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        heap.clear();
+    }
+
+    // Record a cheaper way to reach node and queue it
+    void relax(uint32_t node, int32_t cluster, int32_t index, int cost, const Vec2D& pos, uint32_t from,
+               const Vec2D& goal) {
+        if (stamp[node] == generation && g[node] <= cost) {
+            return;
+        }
+        stamp[node] = generation;
+        g[node] = cost;
+        parent[node] = from;
+        cell[node] = pos;
+        const int h = std::max(std::abs(pos.x - goal.x), std::abs(pos.y - goal.y));
+        heap.push_back({cost + h, h, cost, node, cluster, index});
+        std::push_heap(heap.begin(), heap.end(), after);
+    }
+};
+
+} // namespace
+
+bool find_path_hierarchical(
+    const Vec2D& start,
+    const Vec2D& goal,
+    const World& world,
+    std::vector<Vec2D>& path,
+    int refine_steps
+) {
+    path.clear();
+    if (!world.is_reachable(start, goal)) {
+        return false;
+    }
+
+    const PathHierarchy& hierarchy = world.path_hierarchy;
+    if (!hierarchy.built || !world.is_walkable(start) ||
+        (std::abs((start.x >> CHUNK_SHIFT) - (goal.x >> CHUNK_SHIFT)) <= 1 &&
+         std::abs((start.y >> CHUNK_SHIFT) - (goal.y >> CHUNK_SHIFT)) <= 1)) {
+        return find_path_astar(start, goal, world, path); // Nearby goals gain nothing from the hierarchy
+    }
+
+    thread_local AbstractSearch search;
+    const uint32_t node_count = static_cast<uint32_t>(hierarchy.node_count());
+    const uint32_t start_node = node_count;
+    const uint32_t goal_node = node_count + 1;
+    search.begin(node_count + 2);
+
+    const int start_cluster = hierarchy.cluster_of(start.x, start.y);
+    const int goal_cluster = hierarchy.cluster_of(goal.x, goal.y);
+    hierarchy.entrance_distances(world.grid, start_cluster, start, search.start_costs);
+    hierarchy.entrance_distances(world.grid, goal_cluster, goal, search.goal_costs);
+
+    search.relax(start_node, -1, -1, 0, start, start_node, goal);
+    bool found = false;
+    while (!search.heap.empty()) {
+        std::pop_heap(search.heap.begin(), search.heap.end(), AbstractSearch::after);
+        const AbstractSearch::Entry entry = search.heap.back();
+        search.heap.pop_back();
+        if (entry.g > search.g[entry.node]) {
+            continue; // Superseded by a cheaper entry
+        }
+        if (entry.node == goal_node) {
+            found = true;
+            break;
+        }
+
+        if (entry.node == start_node) {
+            const PathHierarchy::Cluster& cluster = hierarchy.clusters[start_cluster];
+            for (size_t j = 0; j < cluster.entrances.size(); ++j) {
+                if (search.start_costs[j] != PathHierarchy::NO_ROUTE) {
+                    search.relax(hierarchy.cluster_first_node[start_cluster] + static_cast<uint32_t>(j),
+                                 start_cluster, static_cast<int32_t>(j), search.start_costs[j],
+                                 cluster.entrances[j], start_node, goal);
+                }
+            }
+            continue;
+        }
+
+        const PathHierarchy::Cluster& cluster = hierarchy.clusters[entry.cluster];
+        const size_t count = cluster.entrances.size();
+        const size_t i = static_cast<size_t>(entry.index);
+        if (entry.cluster == goal_cluster && search.goal_costs[i] != PathHierarchy::NO_ROUTE) {
+            search.relax(goal_node, -1, -1, entry.g + search.goal_costs[i], goal, entry.node, goal);
+        }
+        for (size_t j = 0; j < count; ++j) {
+            const uint16_t cost = cluster.costs[i * count + j];
+            if (j != i && cost != PathHierarchy::NO_ROUTE) {
+                search.relax(hierarchy.cluster_first_node[entry.cluster] + static_cast<uint32_t>(j), entry.cluster,
+                             static_cast<int32_t>(j), entry.g + cost, cluster.entrances[j], entry.node, goal);
+            }
+        }
+        for (uint32_t p = cluster.partner_begin[i]; p < cluster.partner_begin[i + 1]; ++p) {
+            const Vec2D& partner = cluster.partners[p];
+            const int partner_cluster = hierarchy.cluster_of(partner.x, partner.y);
+            const int j = hierarchy.entrance_index(partner_cluster, partner);
+            search.relax(hierarchy.cluster_first_node[partner_cluster] + static_cast<uint32_t>(j), partner_cluster,
+                         j, entry.g + 1, partner, entry.node, goal);
+        }
+    }
+    if (!found) {
+        // The grid connects start and goal only through diagonal border moves
+        return find_path_astar(start, goal, world, path);
+    }
+
+    search.waypoints.clear();
+    for (uint32_t node = goal_node; node != start_node; node = search.parent[node]) {
+        search.waypoints.push_back(search.cell[node]);
+    }
+    std::reverse(search.waypoints.begin(), search.waypoints.end());
+
+    // Refine abstract edges in order until the route is long enough to walk for a while
+    path.push_back(start);
+    for (const Vec2D& waypoint : search.waypoints) {
+        const Vec2D from = path.back();
+        const int distance = std::max(std::abs(waypoint.x - from.x), std::abs(waypoint.y - from.y));
+        if (distance == 0) {
+            continue; // The start itself is an entrance
+        } else if (distance == 1) {
+            path.push_back(waypoint); // A border crossing
+        } else if (find_path<PathPolicies::ChebyshevHeuristic>(from, waypoint, world, search.segment)) {
+            path.insert(path.end(), search.segment.begin() + 1, search.segment.end());
+        } else {
+            return find_path_astar(start, goal, world, path);
+        }
+        if (static_cast<int>(path.size()) - 1 >= refine_steps) {
+            break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,407 @@
+#include "IncrementalPlanner.h"
+#include "Pathfinding.h"
+#include "PathfindingHelpers.h"
+
+#include <algorithm> // For std::min, std::max, std::reverse
+#include <cstdlib>   // For std::abs
+
+// The root's g offset grows each time the plan is reused; start over before it could
+// push finite keys anywhere near INFINITE_COST
+static constexpr int32_t MAX_REUSED_OFFSET = 1 << 28;
+
+// Queued cells left behind by a long chase are re-keyed on every goal move; past this
+// many a fresh search is cheaper (a search split over several budgeted calls toward the
+// same goal keeps its queue)
+static constexpr size_t MAX_REUSED_QUEUE = 16384;
+
+static int chebyshev_distance(const Vec2D& a, const Vec2D& b) {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
+
+IncrementalPlanner::Cell& IncrementalPlanner::touch(int x, int y) {
+    std::unique_ptr<Page>& page = pages[(y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT)];
+    if (!page) {
+        page.reset(new Page());
+    }
+    Cell& cell = page->cells[((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK)];
+    if (cell.stamp != generation) {
+        cell = {generation, INFINITE_COST, INFINITE_COST, NOT_QUEUED};
+        touched_min_x = std::min(touched_min_x, x);
+        touched_min_y = std::min(touched_min_y, y);
+        touched_max_x = std::max(touched_max_x, x);
+        touched_max_y = std::max(touched_max_y, y);
+    }
+    return cell;
+}
+
+const IncrementalPlanner::Cell* IncrementalPlanner::find(int x, int y) const {
+    const Page* page = pages[(y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT)].get();
+    if (!page) {
+        return nullptr;
+    }
+    const Cell& cell = page->cells[((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK)];
+    return cell.stamp == generation ? &cell : nullptr;
+}
+
+int IncrementalPlanner::heuristic(const Vec2D& pos) const {
+    return chebyshev_distance(pos, goal); // Admissible and consistent for unit-cost 8-connected moves
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calculate_key(const Vec2D& pos, const Cell& cell) const {
+    const int32_t cost = std::min(cell.g, cell.rhs);
+    if (cost >= INFINITE_COST) {
+        return {INT_MAX, INT_MAX};
+    }
+    // Ties go to underconsistent cells (their old distance may still be holding up a
+    // neighbor's), then to the cell nearest the goal as in find_path
+    const int h = heuristic(pos);
+    return {cost + h, cell.g < cell.rhs ? -1 : h};
+}
+
+void IncrementalPlanner::reset() {
+    generation++;
+    if (generation == 0) {
+        for (std::unique_ptr<Page>& page : pages) {
+            page.reset();
+        }
+        generation = 1;
+    }
+    queue.clear();
+    touched_min_x = touched_min_y = INT_MAX;
+    touched_max_x = touched_max_y = -1;
+}
+
+void IncrementalPlanner::start_over(const Vec2D& start, const Vec2D& new_goal, const World& new_world) {
+    if (world != &new_world || pages.size() != new_world.grid.chunk_count()) {
+        pages.clear();
+        pages.resize(new_world.grid.chunk_count());
+        chunks_x = new_world.grid.chunks_x;
+    }
+    world = &new_world;
+    world_version = new_world.obstacle_version;
+    reset();
+    root = start;
+    goal = new_goal;
+    Cell& root_cell = touch(start.x, start.y);
+    root_cell.rhs = 0;
+    queue_set(start, root_cell, calculate_key(start, root_cell));
+    resets++;
+}
+
+void IncrementalPlanner::update_cell(const Vec2D& pos) {
+    if (pos == root) {
+        return; // The root's rhs is fixed
+    }
+    int32_t rhs = INFINITE_COST;
+    if (world->is_walkable(pos)) {
+        for (const Vec2D& offset : World::NEIGHBOR_OFFSETS) {
+            const int x = pos.x + offset.x;
+            const int y = pos.y + offset.y;
+            if (!world->grid.in_bounds(x, y)) {
+                continue;
+            }
+            const Cell* cell = find(x, y);
+            if (cell && cell->g + 1 < rhs && !world->grid.is_set(x, y)) {
+                rhs = cell->g + 1;
+            }
+        }
+    }
+
+    if (rhs == INFINITE_COST && !find(pos.x, pos.y)) {
+        return; // Unreached and still unreachable: nothing to record
+    }
+    Cell& cell = touch(pos.x, pos.y);
+    cell.rhs = rhs;
+    if (cell.g != cell.rhs) {
+        queue_set(pos, cell, calculate_key(pos, cell));
+    } else if (cell.heap_index != NOT_QUEUED) {
+        queue_remove(cell);
+    }
+}
+
+bool IncrementalPlanner::apply_obstacle_changes(const World& current) {
+    // Only cells the search has reached (and their neighbors) can hold stale values
+    const int min_x = touched_min_x - 1;
+    const int min_y = touched_min_y - 1;
+    const int max_x = touched_max_x + 1;
+    const int max_y = touched_max_y + 1;
+    const bool logged = current.for_each_change_since(world_version, [&](const DirtyRegion& region) {
+        if (!region.intersects(min_x, min_y, max_x, max_y)) {
+            return;
+        }
+        // The changed cells and the ring around them (whose best neighbor may have changed)
+        const int x0 = std::max({region.min_x - 1, min_x, 0});
+        const int y0 = std::max({region.min_y - 1, min_y, 0});
+        const int x1 = std::min({region.max_x + 1, max_x, current.width - 1});
+        const int y1 = std::min({region.max_y + 1, max_y, current.height - 1});
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                update_cell({x, y});
+            }
+        }
+    });
+    world_version = current.obstacle_version;
+    return logged;
+}
+
+PathStatus IncrementalPlanner::compute_shortest_path(size_t max_expansions) {
+    for (;;) {
+        const Cell* goal_cell = find(goal.x, goal.y);
+        const Key goal_key = goal_cell ? calculate_key(goal, *goal_cell) : Key{INT_MAX, INT_MAX};
+        const bool goal_consistent = goal_cell && goal_cell->g == goal_cell->rhs;
+        if (queue.empty()) {
+            return goal_consistent && goal_cell->g < INFINITE_COST ? PathStatus::FOUND : PathStatus::NO_PATH;
+        }
+        if (!(queue.front().key < goal_key) && goal_consistent) {
+            return goal_cell->g < INFINITE_COST ? PathStatus::FOUND : PathStatus::NO_PATH;
+        }
+        if (expanded >= max_expansions) {
+            return PathStatus::PARTIAL;
+        }
+
+        const QueueEntry top = queue.front();
+        Cell& cell = *top.cell;
+        const Key current_key = calculate_key(top.pos, cell);
+        if (top.key < current_key) {
+            queue_set(top.pos, cell, current_key); // Queued before a goal move; re-queue with the real key
+            continue;
+        }
+        expanded++;
+        queue_remove(cell);
+
+        if (cell.g > cell.rhs) {
+            // Overconsistent: settle it and offer neighbors the shorter route
+            cell.g = cell.rhs;
+            const int h = heuristic(top.pos);
+            if (h < closest_h) {
+                closest = top.pos;
+                closest_h = h;
+            }
+            const int32_t offered = cell.g + 1;
+            for (const Vec2D& offset : World::NEIGHBOR_OFFSETS) {
+                const Vec2D neighbor = {top.pos.x + offset.x, top.pos.y + offset.y};
+                if (neighbor == root || !world->is_walkable(neighbor)) {
+                    continue;
+                }
+                Cell& next = touch(neighbor.x, neighbor.y);
+                if (offered < next.rhs) {
+                    next.rhs = offered;
+                    if (next.g != next.rhs) {
+                        queue_set(neighbor, next, calculate_key(neighbor, next));
+                    } else if (next.heap_index != NOT_QUEUED) {
+                        queue_remove(next);
+                    }
+                }
+            }
+        } else {
+            // Underconsistent: its old distance is gone; re-evaluate it and everything that used it
+            const int32_t old_offer = cell.g + 1;
+            cell.g = INFINITE_COST;
+            update_cell(top.pos);
+            for (const Vec2D& offset : World::NEIGHBOR_OFFSETS) {
+                const Vec2D neighbor = {top.pos.x + offset.x, top.pos.y + offset.y};
+                if (!world->grid.in_bounds(neighbor.x, neighbor.y)) {
+                    continue;
+                }
+                const Cell* next = find(neighbor.x, neighbor.y);
+                if (next && next->rhs == old_offer) {
+                    update_cell(neighbor);
+                }
+            }
+        }
+    }
+}
+
+bool IncrementalPlanner::plan(const Vec2D& start, const Vec2D& new_goal, const World& current,
+                              std::vector<Vec2D>& path) {
+    return plan(start, new_goal, current, path, SIZE_MAX) == PathStatus::FOUND;
+}
+
+PathStatus IncrementalPlanner::plan(const Vec2D& start, const Vec2D& new_goal, const World& current,
+                                    std::vector<Vec2D>& path, size_t max_expansions) {
+    path.clear();
+    expanded = 0;
+    // No path starts on a blocked cell (find_path fails there too)
+    if (!current.is_walkable(start) || !current.is_reachable(start, new_goal)) {
+        return PathStatus::NO_PATH;
+    }
+
+    bool fresh = world != &current || pages.size() != current.grid.chunk_count() ||
+                 (queue.size() > MAX_REUSED_QUEUE && new_goal != goal);
+    if (!fresh && start != root) {
+        // Re-root at start, keeping its current distance as the fixed root value: every
+        // cell whose best route already runs through start stays consistent as it is
+        const Cell* start_cell = find(start.x, start.y);
+        const int32_t base = start_cell ? std::min(start_cell->g, start_cell->rhs) : INFINITE_COST;
+        if (base > MAX_REUSED_OFFSET) {
+            fresh = true; // Never reached (or the offset grew too large)
+        } else {
+            const Vec2D old_root = root;
+            root = start;
+            Cell& root_cell = touch(start.x, start.y);
+            root_cell.rhs = base;
+            if (root_cell.g != root_cell.rhs) {
+                queue_set(start, root_cell, calculate_key(start, root_cell));
+            } else if (root_cell.heap_index != NOT_QUEUED) {
+                queue_remove(root_cell);
+            }
+            update_cell(old_root);
+        }
+    }
+    if (!fresh) {
+        fresh = !apply_obstacle_changes(current);
+    }
+    if (!fresh && new_goal != goal) {
+        // Every key depends on the goal through h: recompute them and restore the heap
+        goal = new_goal;
+        for (QueueEntry& entry : queue) {
+            entry.key = calculate_key(entry.pos, *entry.cell);
+        }
+        for (size_t i = queue.size() / 2; i-- > 0;) {
+            sift_down(i);
+        }
+    }
+    if (fresh) {
+        start_over(start, new_goal, current);
+    }
+
+    PathStatus status = run_search(current, path, max_expansions);
+    if (status == PathStatus::NO_PATH && !fresh) {
+        start_over(start, new_goal, current); // Reused state went wrong somewhere; plan from scratch
+        status = run_search(current, path, max_expansions);
+    }
+    if (status == PathStatus::NO_PATH) {
+        // Fall back to a plain search with what is left of the budget
+        status = find_path_budgeted(start, new_goal, current, path, max_expansions - std::min(expanded, max_expansions));
+        if (status == PathStatus::FOUND && path.empty()) {
+            status = PathStatus::NO_PATH;
+        }
+    }
+    return status;
+}
+
+PathStatus IncrementalPlanner::run_search(const World& current, std::vector<Vec2D>& path, size_t max_expansions) {
+    closest = root;
+    closest_h = heuristic(root);
+    const PathStatus status = compute_shortest_path(max_expansions);
+    if (status == PathStatus::FOUND) {
+        return extract_path(current, goal, path) ? PathStatus::FOUND : PathStatus::NO_PATH;
+    }
+    if (status == PathStatus::PARTIAL) {
+        const Cell* cell = find(closest.x, closest.y);
+        if (!cell || cell->g != cell->rhs || !extract_path(current, closest, path)) {
+            path.clear(); // The closest cell was raised again later in the same call
+        }
+    }
+    return status;
+}
+
+bool IncrementalPlanner::extract_path(const World& current, const Vec2D& end, std::vector<Vec2D>& path) const {
+    // Walk back from end through neighbors one step closer to the root
+    path.clear();
+    Vec2D pos = end;
+    int32_t cost = find(pos.x, pos.y)->g;
+    path.push_back(pos);
+    while (pos != root) {
+        const Vec2D from = pos;
+        for (const Vec2D& offset : World::NEIGHBOR_OFFSETS) {
+            const Vec2D neighbor = {from.x + offset.x, from.y + offset.y};
+            if (!current.is_walkable(neighbor)) {
+                continue;
+            }
+            const Cell* cell = find(neighbor.x, neighbor.y);
+            if (cell && cell->g == cost - 1 && cell->rhs == cell->g) {
+                pos = neighbor;
+                break;
+            }
+        }
+        if (pos == from) {
+            path.clear();
+            return false;
+        }
+        cost--;
+        path.push_back(pos);
+    }
+    std::reverse(path.begin(), path.end());
+    if (!PathfindingHelpers::validate_and_repair_path(path, current)) {
+        path.clear();
+        return false;
+    }
+    return true;
+}
+
+size_t IncrementalPlanner::memory_bytes() const {
+    size_t bytes = pages.capacity() * sizeof(std::unique_ptr<Page>) + queue.capacity() * sizeof(QueueEntry);
+    for (const std::unique_ptr<Page>& page : pages) {
+        if (page) {
+            bytes += sizeof(Page);
+        }
+    }
+    return bytes;
+}
+
+void IncrementalPlanner::place(size_t index, const QueueEntry& entry) {
+    queue[index] = entry;
+    entry.cell->heap_index = static_cast<int32_t>(index);
+}
+
+void IncrementalPlanner::sift_up(size_t index) {
+    const QueueEntry entry = queue[index];
+    while (index > 0) {
+        const size_t parent = (index - 1) / 2;
+        if (!(entry.key < queue[parent].key)) {
+            break;
+        }
+        place(index, queue[parent]);
+        index = parent;
+    }
+    place(index, entry);
+}
+
+void IncrementalPlanner::sift_down(size_t index) {
+    const QueueEntry entry = queue[index];
+    const size_t count = queue.size();
+    for (;;) {
+        size_t child = index * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && queue[child + 1].key < queue[child].key) {
+            child++;
+        }
+        if (!(queue[child].key < entry.key)) {
+            break;
+        }
+        place(index, queue[child]);
+        index = child;
+    }
+    place(index, entry);
+}
+
+void IncrementalPlanner::queue_set(const Vec2D& pos, Cell& cell, const Key& key) {
+    if (cell.heap_index == NOT_QUEUED) {
+        queue.push_back({key, pos, &cell});
+        sift_up(queue.size() - 1);
+        return;
+    }
+    const size_t index = static_cast<size_t>(cell.heap_index);
+    const bool decreased = key < queue[index].key;
+    queue[index].key = key;
+    if (decreased) {
+        sift_up(index);
+    } else {
+        sift_down(index);
+    }
+}
+
+void IncrementalPlanner::queue_remove(Cell& cell) {
+    const size_t index = static_cast<size_t>(cell.heap_index);
+    cell.heap_index = NOT_QUEUED;
+    const QueueEntry last = queue.back();
+    queue.pop_back();
+    if (index < queue.size()) {
+        place(index, last);
+        sift_up(index);
+        sift_down(static_cast<size_t>(last.cell->heap_index));
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef INCREMENTAL_PLANNER_H
+#define INCREMENTAL_PLANNER_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <climits>
+#include "Vec2D.h"
+#include "ChunkedGrid.h"
+#include "Pathfinding.h" // For PathStatus
+
+struct World;
+
+// Incremental replanner for one chaser following a moving target (LPA* / D* Lite
+// style, same 8-connected unit-cost moves as find_path; paths are shortest paths).
+//
+// The search is rooted at the chaser and keeps its g / rhs values between calls:
+// - the target moving only changes the heuristic: the queued keys are recomputed and
+//   the search continues from where it stopped;
+// - the chaser moving along its path re-roots the search at the new cell: the part of
+//   the search tree below that cell stays valid and only the cells that were reached
+//   through the old root are re-evaluated;
+// - obstacle edits since the last call (World's dirty-region log) update only the
+//   cells they cover and whatever depended on them.
+// The plan is reset when the chaser leaves the explored area, the world changes
+// identity, or the dirty-region log no longer reaches back far enough.
+class IncrementalPlanner {
+public:
+    // Path from start to goal into path (same contract as find_path). Returns false
+    // (path empty) if goal cannot be reached.
+    bool plan(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+
+    // plan() expanding at most max_expansions cells. When the budget runs out first the
+    // result is PARTIAL: path leads to the settled cell nearest the goal (or is empty if
+    // none can be traced), and the unfinished search is kept, so the next call carries on
+    // from it after the usual start, goal and obstacle updates.
+    PathStatus plan(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path,
+                    size_t max_expansions);
+
+    // Forget all search state (the next plan() starts from scratch)
+    void reset();
+
+    // Cells expanded by the last plan() call, and plans that started from scratch
+    size_t expanded_count() const { return expanded; }
+    size_t reset_count() const { return resets; }
+
+    // Bytes held by pages and the queue
+    size_t memory_bytes() const;
+
+private:
+    static constexpr int32_t INFINITE_COST = INT_MAX / 4; // Unreached; INFINITE_COST + step costs cannot overflow
+    static constexpr int32_t NOT_QUEUED = -1;
+
+    struct Cell {
+        uint32_t stamp;     // Generation that last initialized this cell
+        int32_t g;
+        int32_t rhs;        // One-step lookahead: min over neighbors of g + 1 (fixed at the root)
+        int32_t heap_index; // Position in the queue, or NOT_QUEUED
+    };
+    struct Page {
+        Cell cells[CHUNK_CELLS];
+    };
+    struct Key {
+        int32_t primary;   // min(g, rhs) + h
+        int32_t secondary; // -1 if underconsistent, else h
+        bool operator<(const Key& other) const {
+            return primary != other.primary ? primary < other.primary : secondary < other.secondary;
+        }
+    };
+    struct QueueEntry {
+        Key key;
+        Vec2D pos;
+        Cell* cell;
+    };
+
+    Cell& touch(int x, int y);
+    const Cell* find(int x, int y) const; // Null if the cell was not touched this generation
+    int heuristic(const Vec2D& pos) const;
+    Key calculate_key(const Vec2D& pos, const Cell& cell) const;
+    void start_over(const Vec2D& start, const Vec2D& goal, const World& world);
+    bool apply_obstacle_changes(const World& world);
+    void update_cell(const Vec2D& pos);
+    PathStatus compute_shortest_path(size_t max_expansions);
+    PathStatus run_search(const World& current, std::vector<Vec2D>& path, size_t max_expansions);
+    bool extract_path(const World& current, const Vec2D& end, std::vector<Vec2D>& path) const; // Root to end
+
+    // Indexed min-heap with arbitrary updates
+    void queue_set(const Vec2D& pos, Cell& cell, const Key& key);
+    void queue_remove(Cell& cell);
+    void place(size_t index, const QueueEntry& entry);
+    void sift_up(size_t index);
+    void sift_down(size_t index);
+
+    const World* world = nullptr;
+    uint64_t world_version = 0;
+    std::vector<std::unique_ptr<Page>> pages; // Per chunk, null until touched
+    int chunks_x = 0;
+    uint32_t generation = 0;
+    std::vector<QueueEntry> queue;
+    Vec2D root;
+    Vec2D goal;
+    Vec2D closest;     // Cell settled by the current plan() call with the lowest heuristic
+    int closest_h = 0;
+    int touched_min_x = INT_MAX, touched_min_y = INT_MAX; // Bounding box of cells touched this generation
+    int touched_max_x = -1, touched_max_y = -1;
+    size_t expanded = 0;
+    size_t resets = 0;
+};
+
+#endif // INCREMENTAL_PLANNER_H
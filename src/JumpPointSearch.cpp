@@ -0,0 +1,230 @@
+#include "Pathfinding.h"
+#include "PathSearchContext.h"
+
+#include <algorithm> // For std::reverse, std::max
+#include <cstdlib>   // For std::abs
+
+// Jump Point Search (Harabor & Grastien) for the same moves find_path_astar makes:
+// eight neighbors, unit cost, diagonal steps allowed past blocked corners.
+// Instead of pushing every neighbor, each expansion scans straight and diagonal
+// lines ("jumps") and only opens the cells where a shortest path may have to turn.
+// The path between two jump points is always a straight or diagonal line, so the
+// cell-by-cell path is rebuilt from the parent directions and jump lengths.
+
+// Index into World::NEIGHBOR_OFFSETS for a unit direction
+static uint8_t direction_index(int dx, int dy) {
+    for (uint8_t dir = 0; dir < 8; ++dir) {
+        if (World::NEIGHBOR_OFFSETS[dir].x == dx && World::NEIGHBOR_OFFSETS[dir].y == dy) {
+            return dir;
+        }
+    }
+    return PathSearchContext::NO_PARENT;
+}
+
+// Cost of a straight or diagonal segment (and an admissible estimate for any pair):
+// with unit-cost diagonals the distance is the larger axis difference
+static int chebyshev_distance(const Vec2D& a, const Vec2D& b) {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
+
+// Horizontal jump along row y, 63 cells per step using the grid's row words.
+// A cell is a jump point when the row above or below is blocked there and open at
+// the next cell in the scan direction.
+static bool jump_horizontal(const World& world, int x, int y, int dx, const Vec2D& goal,
+                            Vec2D& jump_point, int& steps) {
+    const ChunkedBitGrid& grid = world.grid;
+    const int scan_cells = CHUNK_SIZE - 1; // The last bit's next cell lies outside the word
+    int next = x + dx;                     // First cell to check
+    while (true) {
+        // Window of 64 cells; bit i is cell window_x + i
+        const int window_x = dx > 0 ? next : next - scan_cells;
+        const uint64_t blocked = grid.row_bits(window_x, y);
+        const uint64_t above = grid.row_bits(window_x, y - 1);
+        const uint64_t below = grid.row_bits(window_x, y + 1);
+        uint64_t forced;
+        uint64_t scanned; // Bits of the cells this step is responsible for
+        if (dx > 0) {
+            forced = (above & ~(above >> 1)) | (below & ~(below >> 1));
+            scanned = ~uint64_t{0} >> 1;
+        } else {
+            forced = (above & ~(above << 1)) | (below & ~(below << 1));
+            scanned = ~uint64_t{0} << 1;
+        }
+        uint64_t stop = (blocked | forced) & scanned;
+        if (goal.y == y && goal.x >= window_x && goal.x < window_x + CHUNK_SIZE) {
+            stop |= (uint64_t{1} << (goal.x - window_x)) & scanned;
+        }
+
+        if (stop) {
+            const int bit = dx > 0 ? lowest_set_bit(stop) : highest_set_bit(stop);
+            if (blocked & (uint64_t{1} << bit)) {
+                return false; // Obstacle or map edge before any jump point
+            }
+            jump_point = {window_x + bit, y};
+            steps = std::abs(jump_point.x - x);
+            return true;
+        }
+        next += dx * scan_cells;
+    }
+}
+
+// Vertical jump along column x. Each row is read as one word holding columns x - 1,
+// x and x + 1 (bits 0, 1, 2), so a step costs one row lookup instead of five cell checks.
+static bool jump_vertical(const World& world, int x, int y, int dy, const Vec2D& goal,
+                          Vec2D& jump_point, int& steps) {
+    const ChunkedBitGrid& grid = world.grid;
+    const uint64_t center = 2, sides = 5;
+    uint64_t row = grid.row_bits(x - 1, y + dy);
+    for (int cy = y + dy;; cy += dy) {
+        if (row & center) {
+            return false; // Obstacle or map edge
+        }
+        const uint64_t next_row = grid.row_bits(x - 1, cy + dy);
+        // A side blocked here and open in the next row forces a turn
+        if ((x == goal.x && cy == goal.y) || (row & ~next_row & sides)) {
+            jump_point = {x, cy};
+            steps = std::abs(cy - y);
+            return true;
+        }
+        row = next_row;
+    }
+}
+
+// Walk from (x, y) in direction (dx, dy) until reaching a jump point: the goal, a cell
+// with a forced neighbor, or (for diagonals) a cell whose straight scans find one.
+// Returns false if the line runs into an obstacle or the map edge first.
+// Straight directions use the word-level scans above.
+static bool jump(const World& world, int x, int y, int dx, int dy, const Vec2D& goal,
+                 Vec2D& jump_point, int& steps) {
+    if (dy == 0) {
+        return jump_horizontal(world, x, y, dx, goal, jump_point, steps);
+    }
+    if (dx == 0) {
+        return jump_vertical(world, x, y, dy, goal, jump_point, steps);
+    }
+
+    auto free = [&](int cx, int cy) { return world.is_walkable(cy, cx); };
+    steps = 0;
+    while (true) {
+        x += dx;
+        y += dy;
+        steps++;
+        if (!free(x, y)) {
+            return false;
+        }
+        if (x == goal.x && y == goal.y) {
+            break;
+        }
+
+        // A blocked cell behind either side forces a turn
+        if ((!free(x - dx, y) && free(x - dx, y + dy)) || (!free(x, y - dy) && free(x + dx, y - dy))) {
+            break;
+        }
+        // So does a straight continuation that reaches a jump point
+        Vec2D unused_point;
+        int unused_steps = 0;
+        if (jump_horizontal(world, x, y, dx, goal, unused_point, unused_steps) ||
+            jump_vertical(world, x, y, dy, goal, unused_point, unused_steps)) {
+            break;
+        }
+    }
+    jump_point = {x, y};
+    return true;
+}
+
+bool find_path_jps(
+    const Vec2D& start,
+    const Vec2D& goal,
+    const World& world,
+    std::vector<Vec2D>& path
+) {
+    path.clear();
+    if (!world.is_reachable(start, goal)) {
+        return false;
+    }
+
+    PathSearchContext& search = PathSearchContext::for_this_thread();
+    search.begin(world);
+
+    PathSearchContext::Node& start_node = search.touch(start.x, start.y);
+    start_node.g = 0;
+    const int start_h = chebyshev_distance(start, goal);
+    search.push_or_decrease(start, start_node, start_h, start_h);
+
+    auto free = [&](int x, int y) { return world.is_walkable(y, x); };
+
+    while (!search.open_empty()) {
+        const Vec2D current = search.pop();
+
+        if (current == goal) {
+            // Unroll every jump back into single steps
+            Vec2D trace_back_node = goal;
+            while (trace_back_node != start) {
+                const PathSearchContext::Node& node = search.touch(trace_back_node.x, trace_back_node.y);
+                const Vec2D offset = World::NEIGHBOR_OFFSETS[node.parent_dir];
+                for (int step = 0; step < node.parent_steps; ++step) {
+                    path.push_back(trace_back_node);
+                    trace_back_node = {trace_back_node.x - offset.x, trace_back_node.y - offset.y};
+                }
+            }
+            path.push_back(start);
+            std::reverse(path.begin(), path.end());
+
+            if (PathfindingHelpers::validate_and_repair_path(path, world)) {
+                return true;
+            }
+            path.clear();
+            return false;
+        }
+
+        const PathSearchContext::Node& current_node = search.touch(current.x, current.y);
+        const int current_g = current_node.g;
+
+        // Directions worth scanning: all eight from the start, otherwise the natural
+        // continuations of the arrival direction plus any forced turns
+        Vec2D directions[8];
+        int direction_count = 0;
+        if (current_node.parent_dir == PathSearchContext::NO_PARENT) {
+            for (const auto& offset : World::NEIGHBOR_OFFSETS) {
+                directions[direction_count++] = offset;
+            }
+        } else {
+            const int dx = World::NEIGHBOR_OFFSETS[current_node.parent_dir].x;
+            const int dy = World::NEIGHBOR_OFFSETS[current_node.parent_dir].y;
+            if (dx != 0 && dy != 0) {
+                directions[direction_count++] = {dx, 0};
+                directions[direction_count++] = {0, dy};
+                directions[direction_count++] = {dx, dy};
+                if (!free(current.x - dx, current.y)) directions[direction_count++] = {-dx, dy};
+                if (!free(current.x, current.y - dy)) directions[direction_count++] = {dx, -dy};
+            } else if (dx != 0) {
+                directions[direction_count++] = {dx, 0};
+                if (!free(current.x, current.y + 1)) directions[direction_count++] = {dx, 1};
+                if (!free(current.x, current.y - 1)) directions[direction_count++] = {dx, -1};
+            } else {
+                directions[direction_count++] = {0, dy};
+                if (!free(current.x + 1, current.y)) directions[direction_count++] = {1, dy};
+                if (!free(current.x - 1, current.y)) directions[direction_count++] = {-1, dy};
+            }
+        }
+
+        for (int i = 0; i < direction_count; ++i) {
+            Vec2D jump_point;
+            int steps = 0;
+            if (!jump(world, current.x, current.y, directions[i].x, directions[i].y, goal, jump_point, steps)) {
+                continue;
+            }
+
+            PathSearchContext::Node& neighbor = search.touch(jump_point.x, jump_point.y);
+            const int tentative_g_cost = current_g + steps;
+            if (tentative_g_cost < neighbor.g) {
+                neighbor.g = tentative_g_cost;
+                neighbor.parent_dir = direction_index(directions[i].x, directions[i].y);
+                neighbor.parent_steps = static_cast<uint16_t>(steps);
+                const int h_cost = chebyshev_distance(jump_point, goal);
+                search.push_or_decrease(jump_point, neighbor, tentative_g_cost + h_cost, h_cost);
+            }
+        }
+    }
+    return false; // Goal not reachable
+}
@@ -0,0 +1,226 @@
+#include "PathfindingHelpers.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cstdlib>   // For std::abs
+
+// Kernel selection: the SIMD kernel is AVX2 (8 gathered row words per step) when the
+// compiler targets it (/arch:AVX2, -mavx2), else SSE2 (4 per step) on any x86-64 build.
+// Defining LOS_KERNEL_SCALAR leaves both out.
+#if !defined(LOS_KERNEL_SCALAR) && defined(__AVX2__)
+#include <immintrin.h>
+#define LOS_KERNEL_AVX2
+#elif !defined(LOS_KERNEL_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define LOS_KERNEL_SSE2
+#endif
+
+// A ray from the origin to (dx, dy) covers at most one run of cells per row, so it is
+// tested as (row, column mask) pairs against a window of row words around the origin:
+// the ray is clear if no row word shares a bit with its mask. Window column dx + R
+// holds cell from.x + dx, window row dy + R holds row from.y + dy (R = LOS_BATCH_RADIUS,
+// so a row fits in 31 bits). The cells are those line_cell gives, i.e. exactly the ones
+// has_line_of_sight tests.
+
+namespace PathfindingHelpers {
+
+namespace {
+
+const int R = LOS_BATCH_RADIUS;
+const int SPAN = 2 * R + 1;
+const size_t PAIR_BLOCK = 8; // Pairs per ray are padded to a multiple of this (one AVX2 step)
+
+struct RayTable {
+    std::vector<uint32_t> masks; // Column bits of each pair
+    std::vector<int32_t> rows;   // Window row of each pair
+    uint32_t first[SPAN * SPAN]; // First pair of the ray to (dx, dy), at (dy + R) * SPAN + dx + R
+    uint8_t pairs[SPAN * SPAN];  // Pairs in that ray, padded with empty masks on the origin row
+
+    RayTable() {
+        for (int dy = -R; dy <= R; ++dy) {
+            for (int dx = -R; dx <= R; ++dx) {
+                uint32_t row_masks[SPAN] = {};
+                const Vec2D target = {dx, dy};
+                const int steps = std::max(std::abs(dx), std::abs(dy));
+                for (int step = 0; step <= steps; ++step) {
+                    const Vec2D cell = line_cell({0, 0}, target, step);
+                    row_masks[cell.y + R] |= uint32_t{1} << (cell.x + R);
+                }
+                const int ray = (dy + R) * SPAN + dx + R;
+                first[ray] = static_cast<uint32_t>(masks.size());
+                for (int row = 0; row < SPAN; ++row) {
+                    if (row_masks[row] != 0) {
+                        masks.push_back(row_masks[row]);
+                        rows.push_back(row);
+                    }
+                }
+                while ((masks.size() - first[ray]) % PAIR_BLOCK != 0) {
+                    masks.push_back(0);
+                    rows.push_back(R);
+                }
+                pairs[ray] = static_cast<uint8_t>(masks.size() - first[ray]);
+            }
+        }
+    }
+};
+
+const RayTable& ray_table() {
+    static const RayTable table; // Built once, on first use
+    return table;
+}
+
+bool ray_clear_scalar(const uint32_t* window, const uint32_t* masks, const int32_t* rows, size_t pairs) {
+    for (size_t block = 0; block < pairs; block += PAIR_BLOCK) {
+        uint32_t blocked = 0;
+        for (size_t i = block; i < block + PAIR_BLOCK; ++i) {
+            blocked |= window[rows[i]] & masks[i];
+        }
+        if (blocked != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(LOS_KERNEL_AVX2)
+bool ray_clear_simd(const uint32_t* window, const uint32_t* masks, const int32_t* rows, size_t pairs) {
+    for (size_t block = 0; block < pairs; block += PAIR_BLOCK) {
+        const __m256i row_index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows + block));
+        const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(window), row_index, 4);
+        const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + block));
+        if (!_mm256_testz_si256(words, mask)) {
+            return false;
+        }
+    }
+    return true;
+}
+#elif defined(LOS_KERNEL_SSE2)
+bool ray_clear_simd(const uint32_t* window, const uint32_t* masks, const int32_t* rows, size_t pairs) {
+    const __m128i zero = _mm_setzero_si128();
+    for (size_t block = 0; block < pairs; block += PAIR_BLOCK) {
+        const int32_t* index = rows + block;
+        const __m128i low = _mm_set_epi32(static_cast<int>(window[index[3]]), static_cast<int>(window[index[2]]),
+                                          static_cast<int>(window[index[1]]), static_cast<int>(window[index[0]]));
+        const __m128i high = _mm_set_epi32(static_cast<int>(window[index[7]]), static_cast<int>(window[index[6]]),
+                                           static_cast<int>(window[index[5]]), static_cast<int>(window[index[4]]));
+        const __m128i blocked =
+            _mm_or_si128(_mm_and_si128(low, _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + block))),
+                         _mm_and_si128(high, _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + block + 4))));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(blocked, zero)) != 0xFFFF) {
+            return false;
+        }
+    }
+    return true;
+}
+#else
+bool ray_clear_simd(const uint32_t* window, const uint32_t* masks, const int32_t* rows, size_t pairs) {
+    return ray_clear_scalar(window, masks, rows, pairs);
+}
+#endif
+
+} // namespace
+
+LosKernel default_los_kernel() {
+#if defined(LOS_KERNEL_AVX2) || defined(LOS_KERNEL_SSE2)
+    return LosKernel::SIMD;
+#else
+    return LosKernel::SCALAR;
+#endif
+}
+
+const char* los_kernel_name(LosKernel kernel) {
+    if (kernel == LosKernel::SCALAR) {
+        return "scalar";
+    }
+#if defined(LOS_KERNEL_AVX2)
+    return "avx2";
+#elif defined(LOS_KERNEL_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+size_t has_line_of_sight_many(
+    const Vec2D& from,
+    const Vec2D* targets,
+    size_t count,
+    const World& world,
+    uint8_t* visible,
+    LosKernel kernel
+) {
+    const RayTable& table = ray_table();
+
+    // Only the rows the in-radius rays reach (the origin row is always one)
+    int min_dy = 0;
+    int max_dy = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const int dx = targets[i].x - from.x;
+        const int dy = targets[i].y - from.y;
+        if (dx >= -R && dx <= R && dy >= -R && dy <= R) {
+            min_dy = std::min(min_dy, dy);
+            max_dy = std::max(max_dy, dy);
+        }
+    }
+    uint32_t window[SPAN];
+    for (int dy = min_dy; dy <= max_dy; ++dy) {
+        // Cells outside the grid read as set, as has_line_of_sight treats them
+        window[dy + R] = static_cast<uint32_t>(world.grid.row_bits(from.x - R, from.y + dy));
+    }
+
+    size_t visible_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const int dx = targets[i].x - from.x;
+        const int dy = targets[i].y - from.y;
+        bool clear;
+        if (dx >= -R && dx <= R && dy >= -R && dy <= R) {
+            const int ray = (dy + R) * SPAN + dx + R;
+            const uint32_t* masks = table.masks.data() + table.first[ray];
+            const int32_t* rows = table.rows.data() + table.first[ray];
+            clear = kernel == LosKernel::SIMD ? ray_clear_simd(window, masks, rows, table.pairs[ray])
+                                              : ray_clear_scalar(window, masks, rows, table.pairs[ray]);
+        } else {
+            clear = has_line_of_sight(from, targets[i], world);
+        }
+        visible[i] = clear ? 1 : 0;
+        visible_count += clear ? 1 : 0;
+    }
+    return visible_count;
+}
+
+size_t can_see_many(
+    const Vec2D& from,
+    const Vec2D* targets,
+    size_t count,
+    const World& world,
+    uint8_t* visible
+) {
+    if (!world.grid.in_bounds(from.x, from.y)) {
+        return has_line_of_sight_many(from, targets, count, world, visible);
+    }
+    thread_local std::vector<Vec2D> far_targets;
+    thread_local std::vector<size_t> far_index;
+    thread_local std::vector<uint8_t> far_visible;
+    far_targets.clear();
+    far_index.clear();
+
+    size_t visible_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (VisibilityCache::in_range(from, targets[i])) {
+            visible[i] = world.visibility.is_visible(world, from, targets[i]) ? 1 : 0;
+            visible_count += visible[i];
+        } else {
+            far_targets.push_back(targets[i]);
+            far_index.push_back(i);
+        }
+    }
+    if (!far_targets.empty()) {
+        far_visible.resize(far_targets.size());
+        visible_count += has_line_of_sight_many(from, far_targets.data(), far_targets.size(), world, far_visible.data());
+        for (size_t i = 0; i < far_targets.size(); ++i) {
+            visible[far_index[i]] = far_visible[i];
+        }
+    }
+    return visible_count;
+}
+
+} // namespace PathfindingHelpers
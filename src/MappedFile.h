@@ -0,0 +1,36 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file.
+// The mapped bytes stay valid until close() or destruction.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map the file at path; returns false if it cannot be opened or mapped
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return mapped_data != nullptr; }
+    const unsigned char* data() const { return mapped_data; }
+    size_t size() const { return mapped_size; }
+
+private:
+    const unsigned char* mapped_data = nullptr;
+    size_t mapped_size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+};
+
+#endif // MAPPED_FILE_H
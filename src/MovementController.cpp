@@ -1,4 +1,5 @@
 #include "MovementController.h"
+#include "PathfindingHelpers.h"
 #include <algorithm>
 #include <random>
 #include <cmath>
@@ -12,7 +13,7 @@ const int WANDER_TRAIL_LENGTH = 8;
 
 namespace MovementController {
 
-int calculate_effective_speed(Sprite& sprite) {
+int calculate_effective_speed(SpriteRef& sprite) {
     int effective_speed = sprite.speed;
     
     if (sprite.type == Sprite::Type::PREDATOR) {
@@ -40,7 +41,7 @@ int calculate_effective_speed(Sprite& sprite) {
     return effective_speed;
 }
 
-std::vector<Vec2D> get_valid_moves(const Sprite& sprite, const World& world, int effective_speed) {
+std::vector<Vec2D> get_valid_moves(const SpriteRef& sprite, const World& world, int effective_speed) {
     std::vector<Vec2D> move_options_base;
     std::vector<Vec2D> valid_move_choices;
     
@@ -88,10 +89,39 @@ std::vector<Vec2D> get_valid_moves(const Sprite& sprite, const World& world, int
     return valid_move_choices;
 }
 
-Vec2D follow_path(Sprite& sprite, const World& world) {
+bool next_waypoint_step(const SpriteRef& sprite, const Vec2D& from, int& target_waypoint, Vec2D& next) {
+    const std::vector<Vec2D>& waypoints = sprite.currentPath;
+    while (target_waypoint < static_cast<int>(waypoints.size()) && waypoints[target_waypoint] == from) {
+        target_waypoint++;
+    }
+    if (target_waypoint <= 0 || target_waypoint >= static_cast<int>(waypoints.size())) {
+        return false;
+    }
+    const Vec2D& segment_start = waypoints[target_waypoint - 1];
+    const Vec2D& segment_end = waypoints[target_waypoint];
+    const int along = std::max(std::abs(from.x - segment_start.x), std::abs(from.y - segment_start.y));
+    if (PathfindingHelpers::line_cell(segment_start, segment_end, along) != from) {
+        return false;
+    }
+    next = PathfindingHelpers::line_cell(segment_start, segment_end, along + 1);
+    return true;
+}
+
+Vec2D follow_path(SpriteRef& sprite, const World& world) {
     Vec2D target_pos = sprite.position;
     
-    if (!sprite.currentPath.empty() && sprite.pathFollowStep < sprite.currentPath.size()) {
+    if (sprite.pathIsWaypoints && !sprite.currentPath.empty()) {
+        // Step along the line toward the next waypoint; stepping off it or into a wall ends the path
+        Vec2D next_step;
+        if (next_waypoint_step(sprite, sprite.position, sprite.pathFollowStep, next_step) &&
+            world.is_walkable(next_step)) {
+            target_pos = next_step;
+        }
+        if (target_pos == sprite.position || target_pos == sprite.currentPath.back()) {
+            sprite.currentPath.clear();
+            sprite.turnsSincePathReplan = 0;
+        }
+    } else if (!sprite.currentPath.empty() && sprite.pathFollowStep < sprite.currentPath.size()) {
         Vec2D next_step = sprite.currentPath[sprite.pathFollowStep];
         if (world.is_walkable(next_step)) {
             target_pos = next_step;
@@ -113,7 +143,43 @@ Vec2D follow_path(Sprite& sprite, const World& world) {
     return target_pos;
 }
 
-void move_randomly(Sprite& sprite, const World& world) {
+// Patch the steps of a blocked path still ahead of the sprite with local detours
+// (validate_and_repair_path); the steps already walked are left as they are
+static bool repair_path_ahead(SpriteRef& sprite, const World& world) {
+    thread_local std::vector<Vec2D> ahead;
+    const size_t first = static_cast<size_t>(std::max(0, sprite.pathFollowStep - 1)); // Last step reached
+    if (first >= sprite.currentPath.size()) {
+        return false;
+    }
+    ahead.assign(sprite.currentPath.begin() + first, sprite.currentPath.end());
+    if (!PathfindingHelpers::validate_and_repair_path(ahead, world)) {
+        return false;
+    }
+    sprite.currentPath.resize(first);
+    sprite.currentPath.insert(sprite.currentPath.end(), ahead.begin(), ahead.end());
+    return true;
+}
+
+void invalidate_path_if_blocked(SpriteRef& sprite, const World& world) {
+    if (sprite.pathWorldVersion == world.obstacle_version) {
+        return;
+    }
+    // Waypoint paths re-check the lines still ahead (from the one being walked)
+    const bool blocked = sprite.pathIsWaypoints
+        ? !PathfindingHelpers::validate_waypoint_path(sprite.currentPath, world,
+                                                      static_cast<size_t>(std::max(0, sprite.pathFollowStep - 1)))
+        : world.is_path_blocked_since(sprite.currentPath, static_cast<size_t>(sprite.pathFollowStep), sprite.pathWorldVersion);
+    // Step paths get a local detour around the new obstacles before being dropped
+    if (!sprite.currentPath.empty() && blocked && (sprite.pathIsWaypoints || !repair_path_ahead(sprite, world))) {
+        sprite.currentPath.clear();
+        sprite.pathFollowStep = 0;
+        sprite.turnsSincePathReplan = 0;
+        sprite.is_heading_to_safe_zone = false;
+    }
+    sprite.pathWorldVersion = world.obstacle_version;
+}
+
+void move_randomly(SpriteRef& sprite, const World& world) {
     // If sprite is stunned, handle stunned state and return
     if (sprite.isStunned) {
         sprite.stunDuration--;
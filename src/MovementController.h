@@ -1,22 +1,31 @@
 #ifndef MOVEMENT_CONTROLLER_H
 #define MOVEMENT_CONTROLLER_H
 
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "World.h"
 #include "Vec2D.h"
 
 namespace MovementController {
     // Move a sprite randomly, respecting movement rules and sprite state
-    void move_randomly(Sprite& sprite, const World& world);
+    void move_randomly(SpriteRef& sprite, const World& world);
     
     // Move a sprite along a path
-    Vec2D follow_path(Sprite& sprite, const World& world);
+    Vec2D follow_path(SpriteRef& sprite, const World& world);
     
+    // Next cell after from on a waypoint path (sprite.pathIsWaypoints), moving
+    // target_waypoint past waypoints already reached. False at the end of the path or
+    // if from is not on the line toward target_waypoint.
+    bool next_waypoint_step(const SpriteRef& sprite, const Vec2D& from, int& target_waypoint, Vec2D& next);
+
+    // Drop the sprite's remaining path if obstacles placed since it was last checked
+    // now block one of its steps; paths that only pass near changed cells are kept
+    void invalidate_path_if_blocked(SpriteRef& sprite, const World& world);
+
     // Calculate effective speed for a sprite based on type, state, and stamina
-    int calculate_effective_speed(Sprite& sprite);
+    int calculate_effective_speed(SpriteRef& sprite);
     
     // Find valid moves for a sprite from its current position
-    std::vector<Vec2D> get_valid_moves(const Sprite& sprite, const World& world, int effective_speed);
+    std::vector<Vec2D> get_valid_moves(const SpriteRef& sprite, const World& world, int effective_speed);
 }
 
 #endif // MOVEMENT_CONTROLLER_H 
\ No newline at end of file
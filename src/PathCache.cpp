@@ -0,0 +1,132 @@
+#include "PathCache.h"
+#include "Pathfinding.h"
+
+#include <algorithm> // For std::find
+#include <iterator>  // For std::prev
+
+PathCache::PathCache(size_t max_entries) : capacity(max_entries) {}
+
+PathCache& PathCache::shared() {
+    static PathCache cache;
+    return cache;
+}
+
+void PathCache::erase(EntryList::iterator entry) {
+    by_start_goal.erase(entry->key);
+    auto range = by_goal.equal_range(cell_key(entry->goal));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == entry) {
+            by_goal.erase(it);
+            break;
+        }
+    }
+    entries.erase(entry);
+}
+
+bool PathCache::lookup(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path) {
+    auto exact = by_start_goal.find(start_goal_key(start, goal));
+    if (exact != by_start_goal.end()) {
+        const EntryList::iterator entry = exact->second;
+        if (entry->world == &world && entry->version == world.obstacle_version) {
+            path.assign(entry->path.begin(), entry->path.end());
+            entries.splice(entries.begin(), entries, entry);
+            counters.hits++;
+            return true;
+        }
+        erase(entry);
+        counters.stale++;
+    }
+
+    // Any current path to the same goal that passes through start
+    auto range = by_goal.equal_range(cell_key(goal));
+    for (auto it = range.first; it != range.second; ++it) {
+        const EntryList::iterator entry = it->second;
+        if (entry->world != &world || entry->version != world.obstacle_version) {
+            continue; // Stale entries are dropped when they are looked up exactly or evicted
+        }
+        auto on_path = std::find(entry->path.begin(), entry->path.end(), start);
+        if (on_path != entry->path.end()) {
+            path.assign(on_path, entry->path.end());
+            entries.splice(entries.begin(), entries, entry);
+            counters.suffix_hits++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PathCache::trim() {
+    while (entries.size() > capacity) {
+        erase(std::prev(entries.end()));
+        counters.evictions++;
+    }
+}
+
+void PathCache::set_capacity(size_t max_entries) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = max_entries;
+    trim();
+}
+
+bool PathCache::find_path(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path) {
+    if (find_cached(start, goal, world, path)) {
+        return true;
+    }
+
+    // Search without holding the lock; failed searches and routes that stop short are not cached
+    if (!::find_path(start, goal, world, path)) {
+        return false;
+    }
+    store(start, goal, world, path);
+    return true;
+}
+
+bool PathCache::find_cached(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) {
+        return false;
+    }
+    if (lookup(start, goal, world, path)) {
+        return true;
+    }
+    counters.misses++;
+    return false;
+}
+
+void PathCache::store(const Vec2D& start, const Vec2D& goal, const World& world, const std::vector<Vec2D>& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0 || path.empty() || path.back() != goal) {
+        return; // Only whole routes: a suffix hit on a partial one (HPA*'s first stretch) would stop short
+    }
+    const uint64_t key = start_goal_key(start, goal);
+    auto existing = by_start_goal.find(key);
+    if (existing != by_start_goal.end()) {
+        erase(existing->second); // Another thread cached the same query meanwhile
+    }
+    entries.push_front({key, &world, world.obstacle_version, goal, path});
+    by_start_goal[key] = entries.begin();
+    by_goal.insert({cell_key(goal), entries.begin()});
+    trim();
+}
+
+PathCache::Stats PathCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void PathCache::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters = Stats();
+}
+
+void PathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    by_start_goal.clear();
+    by_goal.clear();
+}
+
+size_t PathCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
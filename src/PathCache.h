@@ -0,0 +1,90 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include "Vec2D.h"
+
+struct World;
+
+// Bounded LRU cache of find_path results for one world.
+//
+// Entries are keyed by (start cell, goal cell) and remember the world and its
+// obstacle_version when they were computed; an entry from an older version is a
+// miss and gets dropped. A query whose start lies on a cached path to the same goal
+// reuses that path's tail ("suffix hit"), which is what a sprite replanning along
+// the path it is already following asks for.
+//
+// Thread-safe: lookups and inserts take an internal lock (searches on a miss run
+// outside it).
+class PathCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    struct Stats {
+        uint64_t hits = 0;        // Exact (start, goal) matches
+        uint64_t suffix_hits = 0; // Start found on a cached path to the same goal
+        uint64_t misses = 0;      // Searches run
+        uint64_t evictions = 0;   // Entries dropped for space
+        uint64_t stale = 0;       // Entries dropped because the obstacles changed
+    };
+
+    explicit PathCache(size_t max_entries = DEFAULT_CAPACITY);
+
+    // find_path(start, goal, world, path) through the cache (same contract)
+    bool find_path(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+
+    // The two halves of find_path, for callers that run their own search on a miss:
+    // find_cached fills path from an exact or suffix match (counting a hit or a miss),
+    // store caches a complete path from start to goal (one that does not end at goal is ignored)
+    bool find_cached(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+    void store(const Vec2D& start, const Vec2D& goal, const World& world, const std::vector<Vec2D>& path);
+
+    // Entry limit; 0 turns the cache off (find_path then just searches)
+    void set_capacity(size_t max_entries);
+
+    Stats stats() const;
+    void reset_stats();
+    void clear();
+    size_t size() const;
+
+    // Cache used by the predators of the running simulation
+    static PathCache& shared();
+
+private:
+    struct Entry {
+        uint64_t key;
+        const World* world;
+        uint64_t version;
+        Vec2D goal;
+        std::vector<Vec2D> path;
+    };
+    using EntryList = std::list<Entry>;
+
+    // Cells fit in 16 bits per axis (World::MAX_DIMENSION is 16384)
+    static uint64_t cell_key(const Vec2D& cell) {
+        return (static_cast<uint64_t>(cell.y & 0xFFFF) << 16) | static_cast<uint64_t>(cell.x & 0xFFFF);
+    }
+    static uint64_t start_goal_key(const Vec2D& start, const Vec2D& goal) {
+        return (cell_key(goal) << 32) | cell_key(start);
+    }
+
+    // Remove an entry from the list and both indexes (lock held)
+    void erase(EntryList::iterator entry);
+    // Fill path from an exact or suffix match (lock held)
+    bool lookup(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+    void trim(); // Evict least recently used entries beyond capacity (lock held)
+
+    size_t capacity;
+    EntryList entries; // Most recently used first
+    std::unordered_map<uint64_t, EntryList::iterator> by_start_goal;   // Key: start and goal cells
+    std::unordered_multimap<uint64_t, EntryList::iterator> by_goal;    // Key: goal cell
+    Stats counters;
+    mutable std::mutex mutex;
+};
+
+#endif // PATH_CACHE_H
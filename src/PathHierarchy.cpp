@@ -0,0 +1,246 @@
+#include "PathHierarchy.h"
+#include "ThreadPool.h"
+
+#include <algorithm> // For std::sort, std::lower_bound, std::min
+
+// Order of entrances inside a cluster
+static bool cell_before(const Vec2D& a, const Vec2D& b) {
+    return a.y != b.y ? a.y < b.y : a.x < b.x;
+}
+
+// Crossings for one run [first, last] of cells free on both sides of a border;
+// make(i) builds the crossing at position i along the border
+template <typename MakeCrossing>
+static void add_run_crossings(int first, int last, std::vector<PathHierarchy::Crossing>& crossings,
+                              MakeCrossing&& make) {
+    if (last - first + 1 < PathHierarchy::MAX_SINGLE_CROSSING_RUN) {
+        crossings.push_back(make((first + last) / 2));
+    } else {
+        crossings.push_back(make(first));
+        crossings.push_back(make(last));
+    }
+}
+
+void PathHierarchy::compute_crossings(const ChunkedBitGrid& grid, int chunk) {
+    const int cx = chunk % chunks_x;
+    const int cy = chunk / chunks_x;
+    const int x0 = cx << CHUNK_SHIFT;
+    const int y0 = cy << CHUNK_SHIFT;
+    const int x1 = std::min(x0 + CHUNK_SIZE, width) - 1;
+    const int y1 = std::min(y0 + CHUNK_SIZE, height) - 1;
+    auto free = [&](int x, int y) { return !grid.is_set(x, y); };
+
+    std::vector<Crossing>& east = east_crossings[chunk];
+    east.clear();
+    if (cx + 1 < chunks_x) {
+        int run_start = -1;
+        for (int y = y0; y <= y1 + 1; ++y) {
+            const bool open = y <= y1 && free(x1, y) && free(x1 + 1, y);
+            if (open && run_start < 0) {
+                run_start = y;
+            } else if (!open && run_start >= 0) {
+                add_run_crossings(run_start, y - 1, east, [&](int i) { return Crossing{{x1, i}, {x1 + 1, i}}; });
+                run_start = -1;
+            }
+        }
+    }
+
+    std::vector<Crossing>& south = south_crossings[chunk];
+    south.clear();
+    if (cy + 1 < chunks_y) {
+        // Columns free in both border rows, as one word (cells past the grid edge read as blocked)
+        uint64_t open = ~(grid.chunk_row_bits(cx, y1) | grid.chunk_row_bits(cx, y1 + 1));
+        while (open) {
+            const int first = lowest_set_bit(open);
+            const uint64_t from_first = open >> first;
+            const int length = ~from_first ? lowest_set_bit(~from_first) : CHUNK_SIZE - first;
+            add_run_crossings(x0 + first, x0 + first + length - 1, south,
+                              [&](int i) { return Crossing{{i, y1}, {i, y1 + 1}}; });
+            open = length + first >= CHUNK_SIZE ? 0 : open & (~uint64_t{0} << (first + length));
+        }
+    }
+    east.shrink_to_fit();
+    south.shrink_to_fit();
+}
+
+void PathHierarchy::entrance_distances(const ChunkedBitGrid& grid, int cluster, const Vec2D& from,
+                                       std::vector<uint16_t>& distances) const {
+    // Breadth-first search on whole rows: each level grows the frontier by one step in
+    // all eight directions with shifts and ORs over the cluster's 64 row words
+    const int cx = cluster % chunks_x;
+    const int cy = cluster / chunks_x;
+    const int x0 = cx << CHUNK_SHIFT;
+    const int y0 = cy << CHUNK_SHIFT;
+    const int rows = std::min(CHUNK_SIZE, height - y0);
+
+    uint64_t open[CHUNK_SIZE + 2] = {};     // Free cells; one blocked guard row on each side
+    uint64_t visited[CHUNK_SIZE + 2] = {};
+    uint64_t frontier[CHUNK_SIZE + 2] = {};
+    uint64_t next[CHUNK_SIZE + 2] = {};
+    for (int row = 0; row < rows; ++row) {
+        open[row + 1] = ~grid.chunk_row_bits(cx, y0 + row);
+    }
+    frontier[from.y - y0 + 1] = uint64_t{1} << (from.x - x0);
+    visited[from.y - y0 + 1] = frontier[from.y - y0 + 1];
+
+    const std::vector<Vec2D>& entrances = clusters[cluster].entrances;
+    distances.assign(entrances.size(), NO_ROUTE);
+    size_t remaining = entrances.size();
+    for (int level = 0; remaining > 0; ++level) {
+        for (size_t i = 0; i < entrances.size(); ++i) {
+            if (distances[i] == NO_ROUTE &&
+                (frontier[entrances[i].y - y0 + 1] >> (entrances[i].x - x0) & 1)) {
+                distances[i] = static_cast<uint16_t>(level);
+                remaining--;
+            }
+        }
+
+        uint64_t grown = 0;
+        for (int row = 1; row <= rows; ++row) {
+            uint64_t spread = frontier[row - 1] | frontier[row] | frontier[row + 1];
+            spread |= (spread << 1) | (spread >> 1);
+            next[row] = spread & open[row] & ~visited[row];
+            grown |= next[row];
+        }
+        if (!grown) {
+            break; // Every entrance still unresolved is unreachable inside the cluster
+        }
+        for (int row = 1; row <= rows; ++row) {
+            visited[row] |= next[row];
+            frontier[row] = next[row];
+        }
+    }
+}
+
+void PathHierarchy::rebuild_cluster(const ChunkedBitGrid& grid, int chunk) {
+    const int cx = chunk % chunks_x;
+    const int cy = chunk / chunks_x;
+
+    // Every crossing touching this cluster, as (entrance, partner) pairs
+    std::vector<Crossing> touching(east_crossings[chunk].begin(), east_crossings[chunk].end());
+    touching.insert(touching.end(), south_crossings[chunk].begin(), south_crossings[chunk].end());
+    if (cx > 0) {
+        for (const Crossing& crossing : east_crossings[chunk - 1]) {
+            touching.push_back({crossing.outside, crossing.inside});
+        }
+    }
+    if (cy > 0) {
+        for (const Crossing& crossing : south_crossings[chunk - chunks_x]) {
+            touching.push_back({crossing.outside, crossing.inside});
+        }
+    }
+    std::sort(touching.begin(), touching.end(), [](const Crossing& a, const Crossing& b) {
+        return a.inside != b.inside ? cell_before(a.inside, b.inside) : cell_before(a.outside, b.outside);
+    });
+
+    Cluster& cluster = clusters[chunk];
+    cluster.entrances.clear();
+    cluster.partner_begin.clear();
+    cluster.partners.clear();
+    for (const Crossing& crossing : touching) {
+        if (cluster.entrances.empty() || cluster.entrances.back() != crossing.inside) {
+            cluster.entrances.push_back(crossing.inside);
+            cluster.partner_begin.push_back(static_cast<uint32_t>(cluster.partners.size()));
+        }
+        cluster.partners.push_back(crossing.outside);
+    }
+    cluster.partner_begin.push_back(static_cast<uint32_t>(cluster.partners.size()));
+
+    const size_t count = cluster.entrances.size();
+    cluster.costs.assign(count * count, NO_ROUTE);
+    std::vector<uint16_t> distances;
+    for (size_t i = 0; i < count; ++i) {
+        entrance_distances(grid, chunk, cluster.entrances[i], distances);
+        std::copy(distances.begin(), distances.end(), cluster.costs.begin() + i * count);
+    }
+
+    cluster.entrances.shrink_to_fit();
+    cluster.partner_begin.shrink_to_fit();
+    cluster.partners.shrink_to_fit();
+}
+
+void PathHierarchy::update_node_offsets() {
+    cluster_first_node.resize(clusters.size() + 1);
+    cluster_first_node[0] = 0;
+    for (size_t chunk = 0; chunk < clusters.size(); ++chunk) {
+        cluster_first_node[chunk + 1] =
+            cluster_first_node[chunk] + static_cast<uint32_t>(clusters[chunk].entrances.size());
+    }
+}
+
+void PathHierarchy::build(const ChunkedBitGrid& grid, ThreadPool& pool) {
+    width = grid.width;
+    height = grid.height;
+    chunks_x = grid.chunks_x;
+    chunks_y = grid.chunks_y;
+
+    const size_t chunk_count = grid.chunk_count();
+    east_crossings.assign(chunk_count, {});
+    south_crossings.assign(chunk_count, {});
+    clusters.assign(chunk_count, {});
+
+    // A chunk only writes its own crossings, then its own cluster
+    pool.parallel_for(chunk_count, [&](size_t chunk) { compute_crossings(grid, static_cast<int>(chunk)); });
+    pool.parallel_for(chunk_count, [&](size_t chunk) { rebuild_cluster(grid, static_cast<int>(chunk)); });
+    update_node_offsets();
+    built = true;
+}
+
+void PathHierarchy::update_chunks(const ChunkedBitGrid& grid, const std::vector<int>& chunks) {
+    // A chunk's cells lie on the borders owned by itself and by its west and north
+    // neighbors. The changed chunks always need new distances; a neighbor only does
+    // if the crossings on the border it shares with them actually changed.
+    std::vector<int> owners;
+    std::vector<int> affected(chunks.begin(), chunks.end());
+    for (int chunk : chunks) {
+        owners.push_back(chunk);
+        if (chunk % chunks_x > 0) owners.push_back(chunk - 1);
+        if (chunk / chunks_x > 0) owners.push_back(chunk - chunks_x);
+    }
+    std::sort(owners.begin(), owners.end());
+    owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+
+    auto same = [](const std::vector<Crossing>& a, const std::vector<Crossing>& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Crossing& x, const Crossing& y) {
+            return x.inside == y.inside && x.outside == y.outside;
+        });
+    };
+    for (int chunk : owners) {
+        const std::vector<Crossing> old_east = east_crossings[chunk];
+        const std::vector<Crossing> old_south = south_crossings[chunk];
+        compute_crossings(grid, chunk);
+        if (!same(old_east, east_crossings[chunk])) {
+            affected.push_back(chunk);
+            affected.push_back(chunk + 1);
+        }
+        if (!same(old_south, south_crossings[chunk])) {
+            affected.push_back(chunk);
+            affected.push_back(chunk + chunks_x);
+        }
+    }
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+
+    for (int chunk : affected) {
+        rebuild_cluster(grid, chunk);
+    }
+    update_node_offsets();
+}
+
+int PathHierarchy::entrance_index(int cluster, const Vec2D& cell) const {
+    const std::vector<Vec2D>& entrances = clusters[cluster].entrances;
+    auto it = std::lower_bound(entrances.begin(), entrances.end(), cell, cell_before);
+    return (it != entrances.end() && *it == cell) ? static_cast<int>(it - entrances.begin()) : -1;
+}
+
+size_t PathHierarchy::memory_bytes() const {
+    size_t bytes = (east_crossings.capacity() + south_crossings.capacity()) * sizeof(std::vector<Crossing>) +
+                   clusters.capacity() * sizeof(Cluster) + cluster_first_node.capacity() * sizeof(uint32_t);
+    for (size_t chunk = 0; chunk < clusters.size(); ++chunk) {
+        const Cluster& cluster = clusters[chunk];
+        bytes += (east_crossings[chunk].capacity() + south_crossings[chunk].capacity()) * sizeof(Crossing) +
+                 cluster.entrances.capacity() * sizeof(Vec2D) + cluster.partner_begin.capacity() * sizeof(uint32_t) +
+                 cluster.partners.capacity() * sizeof(Vec2D) + cluster.costs.capacity() * sizeof(uint16_t);
+    }
+    return bytes;
+}
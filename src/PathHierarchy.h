@@ -0,0 +1,79 @@
+#ifndef PATH_HIERARCHY_H
+#define PATH_HIERARCHY_H
+
+#include <vector>
+#include <cstdint>
+#include "Vec2D.h"
+#include "ChunkedGrid.h"
+
+class ThreadPool;
+
+// Abstract graph for hierarchical pathfinding (HPA*) over a ChunkedBitGrid.
+//
+// Every CHUNK_SIZE x CHUNK_SIZE chunk is a cluster. Along each border between two
+// clusters, every run of cells that are free on both sides gets a crossing: one in
+// the middle of short runs, one at each end of long ones. The border cells of these
+// crossings are the cluster's entrances, and the cluster stores the walking distance
+// (8-connected, unit cost, inside the cluster only) between every pair of them.
+// A search then runs over entrances instead of cells, and only the part of the route
+// about to be walked is refined into cells (see find_path_hierarchical).
+//
+// Moves that cross a border only diagonally get no crossing, so the abstract graph
+// can miss a connection the grid has; callers fall back to a flat search then.
+struct PathHierarchy {
+    static constexpr int MAX_SINGLE_CROSSING_RUN = 6; // Runs at least this long get two crossings
+    static constexpr uint16_t NO_ROUTE = 0xFFFF;     // Distance between entrances with no route inside the cluster
+    static constexpr int DEFAULT_REFINE_STEPS = 32;  // Cells of the route find_path_hierarchical refines by default
+
+    // Two neighboring free cells on either side of a border
+    struct Crossing {
+        Vec2D inside;  // Cell in the chunk that owns the crossing
+        Vec2D outside; // Cell in its east or south neighbor
+    };
+
+    struct Cluster {
+        std::vector<Vec2D> entrances;        // Sorted by (y, x)
+        std::vector<uint32_t> partner_begin; // entrances.size() + 1 offsets into partners
+        std::vector<Vec2D> partners;         // Entrances of neighboring clusters one step away
+        std::vector<uint16_t> costs;         // entrances.size()^2 steps, row-major, NO_ROUTE if unreachable
+    };
+
+    // Data
+    bool built = false;
+    int width = 0;
+    int height = 0;
+    int chunks_x = 0;
+    int chunks_y = 0;
+    std::vector<std::vector<Crossing>> east_crossings;  // Per chunk: crossings into the east neighbor
+    std::vector<std::vector<Crossing>> south_crossings; // Per chunk: crossings into the south neighbor
+    std::vector<Cluster> clusters;
+    std::vector<uint32_t> cluster_first_node; // Prefix sums of the entrance counts (chunk_count + 1 entries)
+
+    // Find the crossings and entrance distances of every cluster, one chunk per pool task
+    void build(const ChunkedBitGrid& grid, ThreadPool& pool);
+
+    // Recompute what the given chunks' obstacle changes can affect: the crossings on
+    // their borders and the clusters on either side of those borders
+    void update_chunks(const ChunkedBitGrid& grid, const std::vector<int>& chunks);
+
+    int cluster_of(int x, int y) const { return (y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT); }
+    size_t node_count() const { return cluster_first_node.empty() ? 0 : cluster_first_node.back(); }
+
+    // Index of cell among the cluster's entrances, or -1
+    int entrance_index(int cluster, const Vec2D& cell) const;
+
+    // Steps from a free cell inside cluster to each of its entrances (NO_ROUTE if
+    // unreachable without leaving the cluster); distances gets one entry per entrance
+    void entrance_distances(const ChunkedBitGrid& grid, int cluster, const Vec2D& from,
+                            std::vector<uint16_t>& distances) const;
+
+    // Bytes used by crossings and clusters
+    size_t memory_bytes() const;
+
+private:
+    void compute_crossings(const ChunkedBitGrid& grid, int chunk);
+    void rebuild_cluster(const ChunkedBitGrid& grid, int chunk);
+    void update_node_offsets();
+};
+
+#endif // PATH_HIERARCHY_H
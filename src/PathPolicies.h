@@ -0,0 +1,93 @@
+#ifndef PATH_POLICIES_H
+#define PATH_POLICIES_H
+
+#include <cstdint>
+#include <algorithm> // For std::max, std::min
+#include "Vec2D.h"
+#include "World.h"
+
+// Compile-time policies for the find_path<Heuristic, MoveCost, Neighborhood> template.
+//
+// MoveCost:     STRAIGHT / DIAGONAL step costs (integers, so g stays exact)
+// Heuristic:    estimate<MoveCost>(dx, dy) for absolute axis differences, in cost units
+// Neighborhood: DIRECTION_COUNT leading entries of World::NEIGHBOR_OFFSETS (straight
+//               moves come first) and can_step() for extra rules beyond a walkable target
+//
+// Every member is static and inline, so each instantiation compiles to one search
+// loop with no per-expansion dispatch.
+namespace PathPolicies {
+
+    // --- Move costs ---
+
+    // Every move costs one step (how sprites actually move)
+    struct UnitCost {
+        static constexpr int STRAIGHT = 1;
+        static constexpr int DIAGONAL = 1;
+    };
+
+    // Diagonals cost about sqrt(2) times a straight move (10 / 14)
+    struct OctileCost {
+        static constexpr int STRAIGHT = 10;
+        static constexpr int DIAGONAL = 14;
+    };
+
+    // --- Heuristics ---
+
+    // dx + dy straight moves: inadmissible once diagonals are allowed, but greedy and
+    // cheap (the original find_path behavior)
+    struct ManhattanHeuristic {
+        template <typename MoveCost>
+        static int estimate(int dx, int dy) { return MoveCost::STRAIGHT * (dx + dy); }
+    };
+
+    // Diagonal moves for the shorter axis, straight moves for the rest: exact on an
+    // empty grid, so admissible for any 8-connected cost model
+    struct OctileHeuristic {
+        template <typename MoveCost>
+        static int estimate(int dx, int dy) {
+            return MoveCost::STRAIGHT * std::max(dx, dy) +
+                   (MoveCost::DIAGONAL - MoveCost::STRAIGHT) * std::min(dx, dy);
+        }
+    };
+
+    // The larger axis difference: admissible whenever a diagonal costs at least as much
+    // as a straight move (equals OctileHeuristic under UnitCost)
+    struct ChebyshevHeuristic {
+        template <typename MoveCost>
+        static int estimate(int dx, int dy) { return MoveCost::STRAIGHT * std::max(dx, dy); }
+    };
+
+    // --- Neighborhoods ---
+
+    // All eight neighbors, diagonals allowed past blocked corners (the simulation's moves)
+    struct EightConnected {
+        static constexpr uint8_t DIRECTION_COUNT = 8;
+        static bool can_step(const World&, const Vec2D&, uint8_t) { return true; }
+    };
+
+    // All eight neighbors, but a diagonal needs both orthogonal cells it passes free
+    struct EightConnectedNoCornerCutting {
+        static constexpr uint8_t DIRECTION_COUNT = 8;
+        static bool can_step(const World& world, const Vec2D& from, uint8_t dir) {
+            const Vec2D& offset = World::NEIGHBOR_OFFSETS[dir];
+            return dir < 4 || (world.is_walkable(from.y, from.x + offset.x) &&
+                               world.is_walkable(from.y + offset.y, from.x));
+        }
+    };
+
+    // Straight moves only
+    struct FourConnected {
+        static constexpr uint8_t DIRECTION_COUNT = 4;
+        static bool can_step(const World&, const Vec2D&, uint8_t) { return true; }
+    };
+
+    // --- Step filters (find_path_to_any) ---
+
+    // Every move allowed
+    struct AnyStep {
+        bool operator()(const Vec2D&, const Vec2D&) const { return true; }
+    };
+
+} // namespace PathPolicies
+
+#endif // PATH_POLICIES_H
@@ -0,0 +1,113 @@
+#include "PathSearchContext.h"
+#include "World.h"
+
+PathSearchContext& PathSearchContext::for_this_thread() {
+    thread_local PathSearchContext context;
+    return context;
+}
+
+void PathSearchContext::begin(const World& world) {
+    const int world_chunks_x = world.grid.chunks_x;
+    const int world_chunks_y = world.grid.chunks_y;
+    if (world_chunks_x != chunks_x || world_chunks_y != chunks_y || allocated_pages > MAX_RETAINED_PAGES) {
+        // Different world size, or a huge earlier search: start over with an empty page table
+        pages.clear();
+        pages.resize(static_cast<size_t>(world_chunks_x) * world_chunks_y);
+        allocated_pages = 0;
+        chunks_x = world_chunks_x;
+        chunks_y = world_chunks_y;
+    }
+
+    generation++;
+    if (generation == 0) {
+        // Stamp wrapped around: old stamps could match again, so reset every node once
+        for (auto& page : pages) {
+            if (page) {
+                for (Node& node : page->nodes) {
+                    node.stamp = 0;
+                }
+            }
+        }
+        generation = 1;
+    }
+
+    heap.clear();
+    expanded = 0;
+}
+
+PathSearchContext::Page* PathSearchContext::allocate_page(int chunk) {
+    pages[chunk].reset(new Page());
+    allocated_pages++;
+    return pages[chunk].get();
+}
+
+void PathSearchContext::place(size_t index, const HeapEntry& entry) {
+    heap[index] = entry;
+    touch(entry.pos.x, entry.pos.y).heap_index = static_cast<int32_t>(index);
+}
+
+void PathSearchContext::sift_up(size_t index) {
+    const HeapEntry entry = heap[index];
+    while (index > 0) {
+        const size_t parent = (index - 1) / 2;
+        if (!before(entry, heap[parent])) {
+            break;
+        }
+        place(index, heap[parent]);
+        index = parent;
+    }
+    place(index, entry);
+}
+
+void PathSearchContext::sift_down(size_t index) {
+    const HeapEntry entry = heap[index];
+    const size_t count = heap.size();
+    while (true) {
+        size_t child = index * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && before(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!before(heap[child], entry)) {
+            break;
+        }
+        place(index, heap[child]);
+        index = child;
+    }
+    place(index, entry);
+}
+
+void PathSearchContext::push_or_decrease(const Vec2D& pos, Node& node, int f, int h) {
+    // A closed node whose cost improved is simply opened again
+    node.closed = false;
+    if (node.heap_index == NOT_IN_HEAP) {
+        heap.push_back({f, h, pos});
+        sift_up(heap.size() - 1);
+    } else {
+        heap[node.heap_index] = {f, h, pos};
+        sift_up(static_cast<size_t>(node.heap_index));
+    }
+}
+
+Vec2D PathSearchContext::pop() {
+    const Vec2D top = heap.front().pos;
+    Node& node = touch(top.x, top.y);
+    node.heap_index = NOT_IN_HEAP;
+    node.closed = true;
+
+    const HeapEntry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        sift_down(0);
+    }
+    expanded++;
+    return top;
+}
+
+size_t PathSearchContext::memory_bytes() const {
+    return allocated_pages * sizeof(Page) + pages.capacity() * sizeof(pages[0]) +
+           heap.capacity() * sizeof(HeapEntry);
+}
@@ -0,0 +1,117 @@
+#ifndef PATH_SEARCH_CONTEXT_H
+#define PATH_SEARCH_CONTEXT_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <climits>
+#include "Vec2D.h"
+#include "ChunkedGrid.h"
+
+struct World;
+
+// Reusable scratch memory for grid searches (A* and friends).
+//
+// Per-cell search state lives in flat pages, one per CHUNK_SIZE x CHUNK_SIZE chunk,
+// allocated the first time a search touches that chunk and kept for later searches.
+// Every node carries the generation of the search that last wrote it, so starting
+// a new search is just a counter increment: nodes with an older stamp read as fresh.
+// The open set is an indexed binary heap that supports decrease-key, so each cell
+// sits in the heap at most once.
+//
+// Use for_this_thread() to get the calling thread's context; once its pages and
+// heap have grown to fit a query, repeating similar queries allocates nothing.
+class PathSearchContext {
+public:
+    static constexpr uint8_t NO_PARENT = 0xFF;      // parent_dir of the start node
+    static constexpr int32_t NOT_IN_HEAP = -1;      // heap_index of unopened and closed nodes
+    static constexpr size_t MAX_RETAINED_PAGES = 1024; // About 64 MB; beyond this pages are freed between searches
+
+    struct Node {
+        uint32_t stamp;       // Generation of the search that last initialized this node
+        int32_t g;            // Cost from the start, INT_MAX until reached
+        int32_t heap_index;   // Position in the open heap, or NOT_IN_HEAP
+        uint8_t parent_dir;   // Index into World::NEIGHBOR_OFFSETS of the step that reached this node
+        bool closed;          // Expanded by the current search
+        uint16_t parent_steps; // Steps along parent_dir from the parent (1 for A*, jump length for JPS)
+    };
+
+    // The calling thread's context
+    static PathSearchContext& for_this_thread();
+
+    // Start a new search over world (invalidates every node and empties the open set)
+    void begin(const World& world);
+
+    // Node for a cell, initialized on its first touch during the current search
+    // (caller guarantees the cell is in bounds)
+    Node& touch(int x, int y) {
+        const int chunk = (y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT);
+        Page* page = pages[chunk].get();
+        if (!page) {
+            page = allocate_page(chunk);
+        }
+        Node& node = page->nodes[((y & CHUNK_MASK) << CHUNK_SHIFT) + (x & CHUNK_MASK)];
+        if (node.stamp != generation) {
+            node = {generation, INT_MAX, NOT_IN_HEAP, NO_PARENT, false, 0};
+        }
+        return node;
+    }
+
+    // Node for a cell if the current search has touched it, else nullptr
+    const Node* find(int x, int y) const {
+        const Page* page = pages[(y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT)].get();
+        if (!page) {
+            return nullptr;
+        }
+        const Node& node = page->nodes[((y & CHUNK_MASK) << CHUNK_SHIFT) + (x & CHUNK_MASK)];
+        return node.stamp == generation ? &node : nullptr;
+    }
+
+    // Open set ordered by f, then h (lower h first on ties)
+    bool open_empty() const { return heap.empty(); }
+
+    // Insert pos with the given keys, or lower its keys if it is already open
+    void push_or_decrease(const Vec2D& pos, Node& node, int f, int h);
+
+    // Remove and return the open cell with the smallest keys, marking it closed
+    Vec2D pop();
+
+    // Smallest f in the open set (open set must not be empty)
+    int open_min_f() const { return heap.front().f; }
+    size_t open_size() const { return heap.size(); }
+
+    // Nodes popped since begin()
+    size_t expanded_count() const { return expanded; }
+
+    // Bytes held by pages and the heap
+    size_t memory_bytes() const;
+
+private:
+    struct Page {
+        Node nodes[CHUNK_CELLS];
+    };
+    struct HeapEntry {
+        int f;
+        int h;
+        Vec2D pos;
+    };
+
+    static bool before(const HeapEntry& a, const HeapEntry& b) {
+        return a.f != b.f ? a.f < b.f : a.h < b.h;
+    }
+
+    Page* allocate_page(int chunk);
+    void place(size_t index, const HeapEntry& entry); // Store entry at index and update its node
+    void sift_up(size_t index);
+    void sift_down(size_t index);
+
+    std::vector<std::unique_ptr<Page>> pages; // Per chunk, null until first touched
+    size_t allocated_pages = 0;
+    int chunks_x = 0;
+    int chunks_y = 0;
+    uint32_t generation = 0;
+    std::vector<HeapEntry> heap;
+    size_t expanded = 0;
+};
+
+#endif // PATH_SEARCH_CONTEXT_H
@@ -0,0 +1,102 @@
+#include "PathService.h"
+#include "ThreadPool.h"
+#include "World.h"
+
+PathService::PathService() = default;
+
+PathService::~PathService() {
+    sync(); // Searches still running hold references to their tickets
+}
+
+PathService& PathService::shared() {
+    static PathService service;
+    return service;
+}
+
+void PathService::set_thread_count(size_t threads) {
+    sync();
+    pool.reset(threads > 0 ? new ThreadPool(threads) : nullptr);
+}
+
+size_t PathService::thread_count() const {
+    return pool ? pool->size() : 0;
+}
+
+std::shared_ptr<PathService::Ticket> PathService::request(const Vec2D& start, const Vec2D& goal, const World& world,
+                                                          Search search) {
+    counters.requests++;
+    std::shared_ptr<Ticket> ticket = std::make_shared<Ticket>();
+    ticket->start = start;
+    ticket->goal = goal;
+
+    if (!pool) {
+        ticket->status = search(world, ticket->path);
+        ticket->world_version = world.obstacle_version;
+        ticket->ready = true;
+        counters.searches++;
+        return ticket;
+    }
+
+    const uint64_t key = start_goal_key(start, goal);
+    auto existing = by_key.find(key);
+    if (existing != by_key.end()) {
+        queued[existing->second].tickets.push_back(ticket);
+        counters.shared++;
+        return ticket;
+    }
+    by_key[key] = queued.size();
+    queued.push_back({std::move(search), {ticket}});
+    return ticket;
+}
+
+void PathService::dispatch(const World& world) {
+    if (!pool) {
+        return;
+    }
+    sync(); // Normally a no-op: the previous tick's searches were collected at the start of this one
+
+    running.swap(queued);
+    queued.clear();
+    by_key.clear();
+    for (Job& job : running) {
+        bool wanted = false;
+        for (const std::shared_ptr<Ticket>& ticket : job.tickets) {
+            wanted = wanted || ticket.use_count() > 1;
+        }
+        if (!wanted) {
+            job.tickets.clear();
+            counters.dropped++;
+            continue;
+        }
+        counters.searches++;
+        Job* task = &job; // running is not resized until sync() has waited for every task
+        const World* searched = &world;
+        pool->submit([task, searched]() {
+            Ticket& ticket = *task->tickets.front();
+            ticket.status = task->search(*searched, ticket.path);
+            ticket.world_version = searched->obstacle_version;
+        });
+    }
+}
+
+void PathService::sync() {
+    if (!pool || running.empty()) {
+        return;
+    }
+    pool->wait_idle();
+    for (Job& job : running) {
+        if (job.tickets.empty()) {
+            continue;
+        }
+        const Ticket& result = *job.tickets.front();
+        for (const std::shared_ptr<Ticket>& ticket : job.tickets) {
+            if (ticket.get() != &result) {
+                ticket->path = result.path;
+                ticket->status = result.status;
+                ticket->world_version = result.world_version;
+            }
+            ticket->ready = true;
+        }
+    }
+    running.clear();
+}
@@ -0,0 +1,92 @@
+#ifndef PATH_SERVICE_H
+#define PATH_SERVICE_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "Vec2D.h"
+#include "Pathfinding.h" // For PathStatus
+
+class ThreadPool;
+
+// Result of a PathService search, shared by the requester and the service
+struct PathTicket {
+    Vec2D start;
+    Vec2D goal;
+    std::vector<Vec2D> path;
+    PathStatus status = PathStatus::NO_PATH;
+    uint64_t world_version = 0; // World::obstacle_version the search ran on
+    bool ready = false;         // path, status and world_version are only valid once set
+    bool waypoints = false;     // Set by the requester if its search returns waypoints, not every step
+};
+
+// Path searches run by a worker pool off the simulation thread, delivered one tick later.
+//
+// During a tick, callers queue searches with request() and keep the returned ticket.
+// dispatch() hands the tick's searches to the workers. sync() waits for them and marks
+// every ticket ready. The simulation calls dispatch() once the predators have moved and
+// sync() at the start of the next tick, before the world changes, so the world must not
+// be edited between the two. Requests with the same start and goal in one tick share a
+// single search. A ticket nobody holds any more by dispatch() time is dropped unsearched.
+//
+// With no worker threads (the default), request() runs the search at once and the
+// ticket comes back ready.
+class PathService {
+public:
+    using Ticket = PathTicket;
+
+    // Fills path from start to goal; runs on a worker, so it may only touch state no
+    // other thread uses meanwhile (the world is read-only until sync())
+    using Search = std::function<PathStatus(const World& world, std::vector<Vec2D>& path)>;
+
+    struct Stats {
+        uint64_t requests = 0; // request() calls
+        uint64_t searches = 0; // Searches run (requests minus shared and dropped ones)
+        uint64_t shared = 0;   // Requests answered by another request's search in the same tick
+        uint64_t dropped = 0;  // Searches skipped because every requester let go of its ticket
+    };
+
+    PathService();
+    ~PathService();
+
+    // Queue search from start to goal for this tick
+    std::shared_ptr<Ticket> request(const Vec2D& start, const Vec2D& goal, const World& world, Search search);
+
+    // Hand this tick's searches to the workers (no-op without workers)
+    void dispatch(const World& world);
+
+    // Wait for the dispatched searches and mark their tickets ready
+    void sync();
+
+    // Worker threads; 0 runs every search inline in request()
+    void set_thread_count(size_t threads);
+    size_t thread_count() const;
+    bool enabled() const { return thread_count() > 0; }
+
+    const Stats& stats() const { return counters; }
+
+    // Service used by the predators of the running simulation (inline until set_thread_count)
+    static PathService& shared();
+
+private:
+    struct Job {
+        Search search;
+        std::vector<std::shared_ptr<Ticket>> tickets; // The first one receives the search's result
+    };
+
+    static uint64_t start_goal_key(const Vec2D& start, const Vec2D& goal) {
+        return (static_cast<uint64_t>(goal.y & 0xFFFF) << 48) | (static_cast<uint64_t>(goal.x & 0xFFFF) << 32) |
+               (static_cast<uint64_t>(start.y & 0xFFFF) << 16) | static_cast<uint64_t>(start.x & 0xFFFF);
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<Job> queued;                        // Requested this tick
+    std::unordered_map<uint64_t, size_t> by_key;    // start_goal_key -> index into queued
+    std::vector<Job> running;                       // Dispatched, not yet synced
+    Stats counters;
+};
+
+#endif // PATH_SERVICE_H
@@ -2,41 +2,93 @@
 #define PATHFINDING_H
 
 #include <vector>
-#include <unordered_set> // For passing obstacles
+#include <string>
 #include "Vec2D.h"       // For Vec2D struct
+#include "World.h"       // For the walkability grid
 #include "PathfindingHelpers.h" // For distance and line of sight functions
+#include "AStarSearch.h" // For the policy-based find_path template
 
-// --- A* Pathfinding Data Structures ---
-struct AStarNode {
-    Vec2D pos;      // Current position
-    Vec2D parent;   // Position of the node we came from
-    int gCost;      // Cost from start node to this node
-    int hCost;      // Heuristic cost estimate from this node to goal
-    int fCost() const { return gCost + hCost; } // Total estimated cost
-
-    // Needed for priority queue ordering (min-heap based on fCost)
-    bool operator>(const AStarNode& other) const {
-        if (fCost() != other.fCost()) {
-             return fCost() > other.fCost();
-        }
-        return hCost > other.hCost;
-    }
-    bool operator==(const AStarNode& other) const {
-        return pos == other.pos;
-    }
+// --- Search engines ---
+
+// Algorithm behind find_path, selectable at runtime (PATH_ENGINE environment variable)
+enum class PathEngine {
+    ASTAR,           // A* over all eight neighbors of every expanded cell (Manhattan heuristic)
+    ASTAR_CHEBYSHEV, // A* with the admissible Chebyshev heuristic: fewest steps
+    ASTAR_OCTILE,    // A* with octile costs and heuristic: shortest geometric length
+    JPS,             // Jump Point Search: expands only jump points, same 8-connected unit-cost moves
+    HPA,             // Hierarchical: entrance graph first, then only the next stretch in cells
+    BIDIRECTIONAL,   // A* from both ends (Chebyshev heuristic) meeting in the middle: fewest steps
+    THETA            // Theta*: any-angle lines between waypoints, near-shortest geometric length
+};
+
+// Engine used by find_path from now on (thread-safe)
+void set_active_path_engine(PathEngine engine);
+PathEngine get_active_path_engine();
+
+// Name used by PATH_ENGINE ("astar", "astar-chebyshev", "astar-octile", "jps", "hpa", "bidirectional", "theta") and the reverse lookup
+const char* path_engine_name(PathEngine engine);
+bool parse_path_engine(const std::string& name, PathEngine& engine);
+
+// Individual engines with the find_path contract below
+// (find_path_astar is find_path<PathPolicies::ManhattanHeuristic>)
+bool find_path_astar(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+bool find_path_jps(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+
+// Bidirectional A*: searches from start and from goal at once, always growing the side
+// with the smaller open set, and joins the frontiers. Paths are shortest paths.
+bool find_path_bidirectional(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+// Cells both halves of the calling thread's last find_path_bidirectional expanded
+size_t bidirectional_expanded_count();
+
+// Theta*: any-angle path as waypoints, start first and goal last, with a clear
+// has_line_of_sight line between each pair (PathfindingHelpers::line_cell gives its
+// cells). Predators follow these directly; false (waypoints empty) if there is no path.
+bool find_waypoints_theta(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& waypoints);
+// The same route with every step, for the find_path contract
+bool find_path_theta(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path);
+
+// Outcome of a search with an expansion budget (find_path_budgeted, BudgetedSearch,
+// IncrementalPlanner)
+enum class PathStatus {
+    FOUND,   // path runs from start to goal
+    PARTIAL, // Budget ran out first: path runs from start to the reached cell nearest the goal
+    NO_PATH  // goal cannot be reached (path empty)
 };
 
+// A* (Chebyshev heuristic, fewest steps) that expands at most max_expansions cells, so
+// one call never costs more than the budget allows. A PARTIAL path heads toward the
+// reached cell with the lowest heuristic; see BudgetedSearch to continue the search later.
+PathStatus find_path_budgeted(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path,
+                              size_t max_expansions);
+
+// HPA* over world.path_hierarchy: searches the entrance graph, then refines only the
+// first refine_steps cells of the route (finishing the abstract edge they end in), so
+// path may stop short of goal; callers replan as they walk it. Falls back to
+// find_path_astar when the hierarchy is not built, the goal is at most one cluster
+// away, or the entrance graph misses a connection the grid has.
+bool find_path_hierarchical(const Vec2D& start, const Vec2D& goal, const World& world, std::vector<Vec2D>& path,
+                            int refine_steps = PathHierarchy::DEFAULT_REFINE_STEPS);
+
 // --- A* Pathfinding Function Declarations ---
 
-// Finds a path from start to goal using A* algorithm.
+// Finds a path from start to goal using the active engine (A* by default).
 // Returns a vector of Vec2D points representing the path (including start, excluding goal if goal is the last step taken from).
 // Returns an empty vector if no path is found.
 std::vector<Vec2D> find_path(
     const Vec2D& start,
     const Vec2D& goal,
-    const std::unordered_set<Vec2D>& obstacles,
-    int world_width,
-    int world_height
+    const World& world
+);
+
+// Same search, writing into path (cleared first) so its capacity is reused.
+// Search state comes from the calling thread's PathSearchContext, so repeated
+// queries do not allocate once the context and path have grown large enough.
+// Returns false (with path empty) if no path is found.
+bool find_path(
+    const Vec2D& start,
+    const Vec2D& goal,
+    const World& world,
+    std::vector<Vec2D>& path
 );
 
 // For backward compatibility - delegates to PathfindingHelpers
@@ -51,11 +103,9 @@ inline int squared_distance(const Vec2D& p1, const Vec2D& p2) {
 inline bool has_line_of_sight(
     const Vec2D& start,
     const Vec2D& end,
-    const std::unordered_set<Vec2D>& obstacles,
-    int world_width,
-    int world_height
+    const World& world
 ) {
-    return PathfindingHelpers::has_line_of_sight(start, end, obstacles, world_width, world_height);
+    return PathfindingHelpers::has_line_of_sight(start, end, world);
 }
 
 #endif // PATHFINDING_H 
\ No newline at end of file
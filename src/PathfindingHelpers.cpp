@@ -1,5 +1,8 @@
 #include "PathfindingHelpers.h"
+#include "PathSearchContext.h"
 #include <cmath>
+#include <algorithm> // For std::max, std::swap
+#include <cstdlib>   // For std::abs
 
 namespace PathfindingHelpers {
 
@@ -16,10 +19,9 @@ int manhattan_distance(const Vec2D& a, const Vec2D& b) {
 bool has_line_of_sight(
     const Vec2D& from, 
     const Vec2D& to, 
-    const std::unordered_set<Vec2D>& obstacles,
-    int width,
-    int height
+    const World& world
 ) {
+
     // Simple Bresenham's algorithm for line tracing
     int x0 = from.x;
     int y0 = from.y;
@@ -47,13 +49,8 @@ bool has_line_of_sight(
     for (int x = x0; x <= x1; x++) {
         Vec2D p = steep ? Vec2D{y, x} : Vec2D{x, y};
         
-        // Check bounds
-        if (p.x < 0 || p.x >= width || p.y < 0 || p.y >= height) {
-            return false;
-        }
-        
-        // Check if point is obstacle
-        if (obstacles.count(p) > 0) {
+        // Check bounds and obstacle bit in one grid test
+        if (!world.is_walkable(p)) {
             return false;
         }
         
@@ -67,38 +64,166 @@ bool has_line_of_sight(
     return true;
 }
 
-bool validate_and_repair_path(
-    std::vector<Vec2D>& path, 
-    const std::unordered_set<Vec2D>& obstacles, 
-    int width, 
-    int height
+bool can_see(
+    const Vec2D& from,
+    const Vec2D& to,
+    const World& world
+) {
+    if (!VisibilityCache::in_range(from, to) || !world.grid.in_bounds(from.x, from.y)) {
+        return has_line_of_sight(from, to, world);
+    }
+    return world.visibility.is_visible(world, from, to);
+}
+
+Vec2D line_cell(const Vec2D& from, const Vec2D& to, int index) {
+    // Same orientation as has_line_of_sight, which always scans the major axis upward,
+    // so both trace the same cells whichever end the line is walked from
+    int x0 = from.x;
+    int y0 = from.y;
+    int x1 = to.x;
+    int y1 = to.y;
+
+    const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    const int dx_signed = x1 - x0;
+    if (dx_signed < 0) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        index = -dx_signed - index; // Counted from the other end
+    }
+
+    const int dx = x1 - x0;
+    const int dy = std::abs(y1 - y0);
+    // has_line_of_sight's error term starts at dx / 2 and moves y once it drops below 0
+    const int y_steps = dx > 0 ? (index * dy - dx / 2 + dx - 1) / dx : 0;
+    const int x = x0 + index;
+    const int y = y0 + (y0 < y1 ? y_steps : -y_steps);
+    return steep ? Vec2D{y, x} : Vec2D{x, y};
+}
+
+bool validate_waypoint_path(
+    const std::vector<Vec2D>& waypoints,
+    const World& world,
+    size_t first
 ) {
-    if (path.empty()) {
+    if (first >= waypoints.size() || !world.is_walkable(waypoints[first])) {
         return false;
     }
-    
-    // Verify that each step in the path is walkable
-    for (size_t i = 0; i < path.size(); ++i) {
-        // Check path bounds
-        if (path[i].x < 0 || path[i].x >= width || path[i].y < 0 || path[i].y >= height) {
-            // Path contains out-of-bounds coordinates
+    for (size_t i = first + 1; i < waypoints.size(); ++i) {
+        if (!has_line_of_sight(waypoints[i - 1], waypoints[i], world)) {
             return false;
         }
-        
-        // Check if step is an obstacle
-        if (obstacles.count(path[i]) > 0) {
-            // Path contains an obstacle - discard this path
-            return false;
+    }
+    return true;
+}
+
+void expand_waypoints(const std::vector<Vec2D>& waypoints, std::vector<Vec2D>& path) {
+    if (waypoints.empty()) {
+        return;
+    }
+    path.push_back(waypoints.front());
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        const Vec2D& from = waypoints[i - 1];
+        const Vec2D& to = waypoints[i];
+        const int steps = std::max(std::abs(to.x - from.x), std::abs(to.y - from.y));
+        for (int step = 1; step <= steps; ++step) {
+            path.push_back(line_cell(from, to, step));
         }
-        
-        // Check that consecutive steps are adjacent
-        if (i > 0) {
-            int dx = std::abs(path[i].x - path[i-1].x);
-            int dy = std::abs(path[i].y - path[i-1].y);
-            if (dx > 1 || dy > 1) {
-                // Gap in path - discard this path
-                return false;
+    }
+}
+
+// Detour from path[anchor] back onto the path past a blocked step or gap at path[broken],
+// found by A* (Chebyshev, unit steps) in the thread's repair context. Any of the next
+// REPAIR_REJOIN_CELLS walkable cells of the path may be rejoined; the detour replaces
+// the steps in between. False if none is reached within REPAIR_MAX_EXPANSIONS.
+static bool splice_detour(std::vector<Vec2D>& path, size_t anchor, size_t broken, const World& world) {
+    thread_local PathSearchContext repair;
+    thread_local std::vector<Vec2D> detour;
+
+    // Rejoin cells: path indices after the break whose cells are walkable
+    size_t rejoin[REPAIR_REJOIN_CELLS];
+    size_t rejoin_count = 0;
+    for (size_t i = broken; i < path.size() && rejoin_count < REPAIR_REJOIN_CELLS; ++i) {
+        if (world.is_walkable(path[i])) {
+            rejoin[rejoin_count++] = i;
+        }
+    }
+    if (rejoin_count == 0) {
+        return false; // The path ends inside the obstacle
+    }
+    const Vec2D& target = path[rejoin[0]];
+    auto estimate = [&target](const Vec2D& pos) {
+        return std::max(std::abs(pos.x - target.x), std::abs(pos.y - target.y));
+    };
+
+    const Vec2D start = path[anchor];
+    repair.begin(world);
+    PathSearchContext::Node& start_node = repair.touch(start.x, start.y);
+    start_node.g = 0;
+    repair.push_or_decrease(start, start_node, estimate(start), estimate(start));
+
+    while (!repair.open_empty() && repair.expanded_count() < REPAIR_MAX_EXPANSIONS) {
+        const Vec2D current = repair.pop();
+        size_t joined = 0;
+        while (joined < rejoin_count && path[rejoin[joined]] != current) {
+            joined++;
+        }
+        if (joined < rejoin_count) {
+            detour.clear();
+            for (Vec2D cell = current; cell != start;) {
+                detour.push_back(cell);
+                const Vec2D& step = World::NEIGHBOR_OFFSETS[repair.find(cell.x, cell.y)->parent_dir];
+                cell = {cell.x - step.x, cell.y - step.y};
+            }
+            // path[anchor + 1 .. rejoin] becomes the detour (which ends at the rejoined cell)
+            const size_t end = rejoin[joined] + 1;
+            path.erase(path.begin() + anchor + 1, path.begin() + end);
+            path.insert(path.begin() + anchor + 1, detour.rbegin(), detour.rend());
+            return true;
+        }
+
+        const int current_g = repair.touch(current.x, current.y).g;
+        for (uint8_t dir = 0; dir < 8; ++dir) {
+            const Vec2D neighbor_pos = {current.x + World::NEIGHBOR_OFFSETS[dir].x,
+                                        current.y + World::NEIGHBOR_OFFSETS[dir].y};
+            if (!world.is_walkable(neighbor_pos)) {
+                continue;
             }
+            PathSearchContext::Node& neighbor = repair.touch(neighbor_pos.x, neighbor_pos.y);
+            if (current_g + 1 < neighbor.g) {
+                neighbor.g = current_g + 1;
+                neighbor.parent_dir = dir;
+                neighbor.parent_steps = 1;
+                const int h_cost = estimate(neighbor_pos);
+                repair.push_or_decrease(neighbor_pos, neighbor, neighbor.g + h_cost, h_cost);
+            }
+        }
+    }
+    return false;
+}
+
+bool validate_and_repair_path(
+    std::vector<Vec2D>& path, 
+    const World& world
+) {
+
+    if (path.empty() || !world.is_walkable(path[0])) {
+        return false; // Nothing to repair from
+    }
+    
+    // Verify that each step is walkable and adjacent to the one before
+    for (size_t i = 1; i < path.size(); ++i) {
+        const int dx = std::abs(path[i].x - path[i-1].x);
+        const int dy = std::abs(path[i].y - path[i-1].y);
+        if (world.is_walkable(path[i]) && dx <= 1 && dy <= 1) {
+            continue;
+        }
+        // Blocked step or gap: detour from the last good step, then carry on checking after it
+        if (!splice_detour(path, i - 1, i, world)) {
+            return false;
         }
     }
     
@@ -2,16 +2,25 @@
 #define PATHFINDING_HELPERS_H
 
 #include "Vec2D.h"
+#include "World.h"
 #include <vector>
-#include <unordered_set>
+#include <cstdint>
+#include <cstddef>
 
 namespace PathfindingHelpers {
-    // Validate and repair a path if possible, return false if invalid
+    // Local repair limits: cells a detour search may expand, and path cells past a
+    // break it may rejoin
+    const size_t REPAIR_MAX_EXPANSIONS = 256;
+    const size_t REPAIR_REJOIN_CELLS = 8;
+
+    // Check that every step is walkable and 8-adjacent to the one before. Each blocked
+    // step or gap is patched with a short detour from the step before it back onto
+    // the path (at most REPAIR_MAX_EXPANSIONS cells searched per break); the rest of
+    // the path is kept. Returns false if a break cannot be patched that way (or the
+    // first step is blocked), leaving path partly repaired: callers then replan.
     bool validate_and_repair_path(
         std::vector<Vec2D>& path, 
-        const std::unordered_set<Vec2D>& obstacles, 
-        int width, 
-        int height
+        const World& world
     );
     
     // Calculate squared distance between two points (faster than Manhattan for some comparisons)
@@ -24,10 +33,66 @@ namespace PathfindingHelpers {
     bool has_line_of_sight(
         const Vec2D& from, 
         const Vec2D& to, 
-        const std::unordered_set<Vec2D>& obstacles,
-        int width,
-        int height
+        const World& world
+    );
+
+    // Sight check for the AI: within VisibilityCache::RADIUS it answers from the world's
+    // cached field of view (symmetric shadowcasting, so a sees b exactly when b sees a),
+    // further away it falls back to has_line_of_sight. Both ends must be walkable.
+    // Simulation thread only (the cache fills as it is queried).
+    bool can_see(
+        const Vec2D& from,
+        const Vec2D& to,
+        const World& world
+    );
+
+    // Batched has_line_of_sight from one cell to many (LineOfSightBatch.cpp): visible[i]
+    // is 1 if targets[i] is in sight, with exactly has_line_of_sight's answer. Targets
+    // within LOS_BATCH_RADIUS (Chebyshev) are traced in one pass over the grid rows
+    // around from, using precomputed per-ray word masks; farther ones fall back to
+    // has_line_of_sight. Returns the number of visible targets. Thread-safe.
+    const int LOS_BATCH_RADIUS = 15;
+
+    // Kernels for the in-radius rays. SCALAR is always built; SIMD is the AVX2 (gathers)
+    // or SSE2 one the compiler targets, and the default. Building with LOS_KERNEL_SCALAR
+    // defined (or for a target with neither) leaves SIMD out: it then runs SCALAR too.
+    enum class LosKernel { SCALAR, SIMD };
+    LosKernel default_los_kernel();
+    const char* los_kernel_name(LosKernel kernel); // "scalar", "avx2" or "sse2"
+
+    size_t has_line_of_sight_many(
+        const Vec2D& from,
+        const Vec2D* targets,
+        size_t count,
+        const World& world,
+        uint8_t* visible,
+        LosKernel kernel = default_los_kernel()
     );
+
+    // can_see for many targets: the cached field of view where it reaches, one
+    // has_line_of_sight_many batch for the rest. Same thread rule as can_see.
+    size_t can_see_many(
+        const Vec2D& from,
+        const Vec2D* targets,
+        size_t count,
+        const World& world,
+        uint8_t* visible
+    );
+
+    // Cell index steps from `from` along the line has_line_of_sight(from, to) traces
+    // (0 is from, chebyshev(from, to) is to). Consecutive cells are 8-adjacent.
+    Vec2D line_cell(const Vec2D& from, const Vec2D& to, int index);
+
+    // Waypoint path (e.g. from find_waypoints_theta): every waypoint walkable and the
+    // line between each pair, starting at waypoint first, clear
+    bool validate_waypoint_path(
+        const std::vector<Vec2D>& waypoints,
+        const World& world,
+        size_t first = 0
+    );
+
+    // Every step of a waypoint path, appended to path (the first waypoint included)
+    void expand_waypoints(const std::vector<Vec2D>& waypoints, std::vector<Vec2D>& path);
 }
 
 #endif // PATHFINDING_HELPERS_H 
\ No newline at end of file
@@ -1,8 +1,15 @@
 #include "PredatorAI.h"
 #include "MovementController.h"
 #include "Pathfinding.h"
+#include "PathCache.h"
+#include "IncrementalPlanner.h"
+#include "BudgetedSearch.h"
+#include "PathService.h"
+#include "FlowField.h"
 #include <random>
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 
 // Use the same random generator as main.cpp for consistency
 extern std::mt19937 gen;
@@ -15,16 +22,20 @@ const int REPLAN_PATH_INTERVAL = 2;
 const int STUCK_THRESHOLD = 3;
 const int POSITION_HISTORY_SIZE = 5;
 const size_t MAX_TRACKED_PREDATORS = 10;
+const size_t DEFAULT_PATH_EXPANSION_BUDGET = 4096;
 
 // Static data for stuck detection
 static std::vector<Vec2D> position_history[MAX_TRACKED_PREDATORS];
 static int stuck_counters[MAX_TRACKED_PREDATORS] = {0};
 static bool initialized = false;
 
+static bool incremental_replanning = true;
+static size_t path_expansion_budget = DEFAULT_PATH_EXPANSION_BUDGET;
+
 // Forward declaration of helper function
-static const Sprite* find_closest_prey(const Sprite& predator, const std::vector<Sprite>& all_prey, int& dist_to_closest);
+static int find_closest_prey(const SpriteRef& predator, const SpatialHash& prey_index, int& dist_to_closest);
 
-bool detect_and_resolve_stuck(Sprite& predator, const std::vector<Sprite>& all_predators, const World& world) {
+bool detect_and_resolve_stuck(SpriteRef& predator, const World& world) {
     // Initialize the position history tracking if needed
     if (!initialized) {
         for (size_t i = 0; i < MAX_TRACKED_PREDATORS; ++i) {
@@ -33,18 +44,10 @@ bool detect_and_resolve_stuck(Sprite& predator, const std::vector<Sprite>& all_p
         initialized = true;
     }
     
-    // Find this predator's index in the all_predators list
-    int predator_index = -1;
-    for (size_t i = 0; i < all_predators.size() && i < MAX_TRACKED_PREDATORS; ++i) {
-        if (&predator == &all_predators[i]) {
-            predator_index = static_cast<int>(i);
-            break;
-        }
-    }
-    
-    if (predator_index < 0 || predator_index >= static_cast<int>(MAX_TRACKED_PREDATORS)) {
+    if (predator.index >= MAX_TRACKED_PREDATORS) {
         return false; // Couldn't track this predator, assume not stuck
     }
+    const int predator_index = static_cast<int>(predator.index);
     
     // Update position history
     std::rotate(position_history[predator_index].begin(), 
@@ -149,12 +152,12 @@ bool detect_and_resolve_stuck(Sprite& predator, const std::vector<Sprite>& all_p
     return false;
 }
 
-void handle_state_transitions(Sprite& predator, const Sprite* target_prey, 
+void handle_state_transitions(SpriteRef& predator, const Vec2D* target_prey, 
                              bool prey_in_sight, Sprite::AIState previous_state) {
     if (predator.currentState == Sprite::AIState::WANDERING) {
         if (prey_in_sight) { 
             predator.currentState = Sprite::AIState::SEEKING; 
-            predator.lastKnownPreyPosition = target_prey->position; 
+            predator.lastKnownPreyPosition = *target_prey; 
             predator.currentPath.clear(); 
             predator.turnsSincePathReplan = REPLAN_PATH_INTERVAL; 
             predator.restingDuration = 0; 
@@ -168,7 +171,7 @@ void handle_state_transitions(Sprite& predator, const Sprite* target_prey,
            predator.currentState = Sprite::AIState::SEARCHING_LKP;
            // lastKnownPreyPosition should already be set from when SEEKING started
         } else { // Still see prey
-           predator.lastKnownPreyPosition = target_prey->position; // Update LKP
+           predator.lastKnownPreyPosition = *target_prey; // Update LKP
            predator.turnsSincePathReplan++;
            // Check if needs to rest
            if(predator.currentStamina <= 0) {
@@ -180,7 +183,7 @@ void handle_state_transitions(Sprite& predator, const Sprite* target_prey,
     } else if (predator.currentState == Sprite::AIState::SEARCHING_LKP) {
         if (prey_in_sight) { // Found prey again
             predator.currentState = Sprite::AIState::SEEKING;
-            predator.lastKnownPreyPosition = target_prey->position;
+            predator.lastKnownPreyPosition = *target_prey;
             predator.currentPath.clear();
             predator.turnsSincePathReplan = REPLAN_PATH_INTERVAL;
         } else if (predator.position == predator.lastKnownPreyPosition || predator.currentPath.empty()) { 
@@ -192,7 +195,7 @@ void handle_state_transitions(Sprite& predator, const Sprite* target_prey,
     } else if (predator.currentState == Sprite::AIState::RESTING) {
         if (prey_in_sight) { // Prey appeared while resting!
             predator.currentState = Sprite::AIState::SEEKING;
-            predator.lastKnownPreyPosition = target_prey->position;
+            predator.lastKnownPreyPosition = *target_prey;
             predator.currentPath.clear(); 
             predator.turnsSincePathReplan = REPLAN_PATH_INTERVAL;
             predator.restingDuration = 0; 
@@ -213,19 +216,154 @@ void handle_state_transitions(Sprite& predator, const Sprite* target_prey,
     }
 }
 
-void generate_path(Sprite& predator, const Sprite* target_prey, const World& world) {
-    if (predator.currentState == Sprite::AIState::SEEKING && target_prey) {
-        bool need_new_path = predator.currentPath.empty() || 
-                            predator.turnsSincePathReplan >= REPLAN_PATH_INTERVAL;
+void set_incremental_replanning(bool enabled) {
+    incremental_replanning = enabled;
+}
+
+void set_path_expansion_budget(size_t cells) {
+    path_expansion_budget = cells;
+}
+
+// Chase search from start to goal using only the predator's own search state and the
+// (thread-safe) path cache, so it can also run on a PathService worker. The predator's
+// planner picks up where the previous replan stopped, which is most of the work when
+// the goal only moved a cell or two; without one, its BudgetedSearch carries on with
+// last tick's search if that is still after this goal and start is on ground it covered.
+static PathStatus search_chase_path(IncrementalPlanner* planner, BudgetedSearch* search, const Vec2D& start,
+                                    const Vec2D& goal, const World& world, size_t budget, std::vector<Vec2D>& path) {
+    if (planner) {
+        return planner->plan(start, goal, world, path, budget);
+    }
+    PathCache& cache = PathCache::shared();
+    if (cache.find_cached(start, goal, world, path)) {
+        return PathStatus::FOUND;
+    }
+    if (!search->can_resume(world) || search->goal() != goal || !search->has_reached(start)) {
+        search->start(start, goal, world);
+    }
+    const PathStatus status = search->resume(start, budget, path);
+    if (status == PathStatus::FOUND) {
+        cache.store(start, goal, world, path);
+    }
+    return status;
+}
+
+// A fresh path (waypoints if any_angle) was just put in currentPath
+static void begin_following(SpriteRef& predator, PathStatus status, bool any_angle) {
+    predator.pathIsWaypoints = any_angle;
+    predator.pathFollowStep = 0;
+    // Finish an interrupted search on the next tick
+    predator.turnsSincePathReplan = status == PathStatus::PARTIAL ? REPLAN_PATH_INTERVAL - 1 : 0;
+}
+
+// Replan a chasing predator's path, expanding at most path_expansion_budget cells.
+// Predators after the same prey share that tick's flow field toward it when flow
+// fields are on. With PATH_ENGINE=theta the path is Theta* waypoints instead (no
+// budget or incremental replanning). The IncrementalPlanner and BudgetedSearch are A*
+// and only stand in for the default A* engine; under any other engine, or with neither
+// incremental replanning nor a budget, the active engine's whole find_path runs through
+// PathCache::shared(). The search runs now, or, with
+// PathService workers, is queued and arrives next tick while the predator keeps
+// following its current path.
+static void plan_chase_path(SpriteRef& predator, const Vec2D& goal, const World& world, bool shared_goal) {
+    FlowFieldCache& flow_fields = FlowFieldCache::shared();
+    if (shared_goal && flow_fields.enabled() &&
+        flow_fields.field_for(goal, world).route(predator.position, predator.currentPath)) {
+        begin_following(predator, PathStatus::FOUND, false);
+        return;
+    }
+
+    const Vec2D start = predator.position;
+    const PathEngine engine = get_active_path_engine();
+    const bool any_angle = engine == PathEngine::THETA;
+    PathService::Search search_path;
+    if (any_angle) {
+        search_path = [start, goal](const World& searched, std::vector<Vec2D>& path) {
+            return find_waypoints_theta(start, goal, searched, path) ? PathStatus::FOUND : PathStatus::NO_PATH;
+        };
+    } else if (engine != PathEngine::ASTAR || (!incremental_replanning && path_expansion_budget == 0)) {
+        search_path = [start, goal](const World& searched, std::vector<Vec2D>& path) {
+            return PathCache::shared().find_path(start, goal, searched, path) ? PathStatus::FOUND : PathStatus::NO_PATH;
+        };
+    } else {
+        if (incremental_replanning && !predator.pathPlanner) {
+            predator.pathPlanner = std::make_shared<IncrementalPlanner>();
+        }
+        if (!incremental_replanning && !predator.pathSearch) {
+            predator.pathSearch = std::make_shared<BudgetedSearch>();
+        }
+        std::shared_ptr<IncrementalPlanner> planner = incremental_replanning ? predator.pathPlanner : nullptr;
+        std::shared_ptr<BudgetedSearch> search = incremental_replanning ? nullptr : predator.pathSearch;
+        const size_t budget = path_expansion_budget > 0 ? path_expansion_budget : SIZE_MAX;
+        search_path = [planner, search, start, goal, budget](const World& searched, std::vector<Vec2D>& path) {
+            return search_chase_path(planner.get(), search.get(), start, goal, searched, budget, path);
+        };
+    }
+
+    PathService& service = PathService::shared();
+    if (service.enabled()) {
+        predator.pendingPath = service.request(start, goal, world, std::move(search_path));
+        predator.pendingPath->waypoints = any_angle;
+        return;
+    }
+    begin_following(predator, search_path(world, predator.currentPath), any_angle);
+}
+
+// Take over a path the PathService delivered. The predator kept moving while it was
+// searched, so the path is joined at the predator's cell, and it is dropped if walls
+// placed since block it.
+static void adopt_delivered_path(SpriteRef& predator, const World& world) {
+    const std::shared_ptr<PathTicket> ticket = std::move(predator.pendingPath);
+    if (predator.currentState != Sprite::AIState::SEEKING && predator.currentState != Sprite::AIState::SEARCHING_LKP) {
+        return; // Stopped chasing meanwhile
+    }
+
+    const std::vector<Vec2D>& path = ticket->path;
+    if (ticket->waypoints) {
+        // Waypoints: start from here instead if the second one is in sight
+        if (!path.empty() && (path.front() == predator.position ||
+                              (path.size() > 1 && has_line_of_sight(predator.position, path[1], world)))) {
+            predator.currentPath = path;
+            predator.currentPath.front() = predator.position;
+        } else {
+            predator.currentPath.clear();
+        }
+    } else {
+        auto here = std::find(path.begin(), path.end(), predator.position);
+        if (here != path.end()) {
+            predator.currentPath.assign(here, path.end());
+        } else if (!path.empty() && std::abs(path.front().x - predator.position.x) <= 1 &&
+                   std::abs(path.front().y - predator.position.y) <= 1) {
+            predator.currentPath.assign(1, predator.position);
+            predator.currentPath.insert(predator.currentPath.end(), path.begin(), path.end());
+        } else {
+            predator.currentPath.clear(); // Wandered off since the request: replan
+        }
+    }
+    begin_following(predator, ticket->status, ticket->waypoints);
+    predator.pathWorldVersion = ticket->world_version;
+    MovementController::invalidate_path_if_blocked(predator, world);
+}
+
+void generate_path(SpriteRef& predator, const SpriteStore& all_prey, int target_prey, const World& world) {
+    if (predator.pendingPath && predator.pendingPath->ready) {
+        adopt_delivered_path(predator, world);
+    }
+
+    // While a search is queued the predator keeps following the path it has
+    if (predator.currentState == Sprite::AIState::SEEKING && target_prey >= 0) {
+        bool need_new_path = (predator.currentPath.empty() || 
+                              predator.turnsSincePathReplan >= REPLAN_PATH_INTERVAL) && !predator.pendingPath;
                             
         if (need_new_path) {
-            Vec2D path_goal = target_prey->position;
+            Vec2D path_goal = all_prey.position[target_prey];
+            const SpriteDetail& prey_detail = all_prey.detail[target_prey];
             
             // Try to predict prey movement
-            if (target_prey->lastMoveDirection.x != 0 || target_prey->lastMoveDirection.y != 0) {
+            if (prey_detail.lastMoveDirection.x != 0 || prey_detail.lastMoveDirection.y != 0) {
                 Vec2D predicted_target_pos = {
-                    target_prey->position.x + target_prey->lastMoveDirection.x * target_prey->speed,
-                    target_prey->position.y + target_prey->lastMoveDirection.y * target_prey->speed
+                    path_goal.x + prey_detail.lastMoveDirection.x * prey_detail.speed,
+                    path_goal.y + prey_detail.lastMoveDirection.y * prey_detail.speed
                 };
                 
                 if (predicted_target_pos.x >= 0 && predicted_target_pos.x < world.width && 
@@ -235,52 +373,37 @@ void generate_path(Sprite& predator, const Sprite* target_prey, const World& wor
                 }
             }
             
-            predator.currentPath = find_path(predator.position, path_goal, world.obstacles, world.width, world.height);
-            predator.pathFollowStep = 0;
-            predator.turnsSincePathReplan = 0;
+            plan_chase_path(predator, path_goal, world, true);
         }
     } else if (predator.currentState == Sprite::AIState::SEARCHING_LKP) {
-        bool need_new_path = predator.currentPath.empty() || 
-                            predator.turnsSincePathReplan >= REPLAN_PATH_INTERVAL;
+        bool need_new_path = (predator.currentPath.empty() || 
+                              predator.turnsSincePathReplan >= REPLAN_PATH_INTERVAL) && !predator.pendingPath;
                             
         if (need_new_path) {
-            predator.currentPath = find_path(predator.position, predator.lastKnownPreyPosition, 
-                                            world.obstacles, world.width, world.height);
-            predator.pathFollowStep = 0;
-            predator.turnsSincePathReplan = 0;
+            plan_chase_path(predator, predator.lastKnownPreyPosition, world, false);
         }
     }
 }
 
-static const Sprite* find_closest_prey(const Sprite& predator, const std::vector<Sprite>& all_prey, int& dist_to_closest) {
-    const Sprite* closest = nullptr;
-    int min_dist_sq = std::numeric_limits<int>::max();
+static int find_closest_prey(const SpriteRef& predator, const SpatialHash& prey_index, int& dist_to_closest) {
     dist_to_closest = std::numeric_limits<int>::max();
 
-    if (all_prey.empty()) {
-        return nullptr;
+    // Prey nearer by squared distance than the vision radius are the only ones that can be
+    // within it by Manhattan distance, so the search stops there
+    const int closest = prey_index.nearest(predator.position,
+                                           static_cast<int64_t>(PREDATOR_VISION_RADIUS) * PREDATOR_VISION_RADIUS);
+    if (closest < 0) {
+        return -1;
     }
-
-    for (const auto& prey : all_prey) {
-        int dist_sq = squared_distance(predator.position, prey.position);
-        if (dist_sq < min_dist_sq) {
-            min_dist_sq = dist_sq;
-            closest = &prey;
-        }
-    }
-
-    if (closest) {
-        dist_to_closest = manhattan_distance(predator.position, closest->position);
-        if (dist_to_closest > PREDATOR_VISION_RADIUS) {
-            return nullptr;
-        }
+    dist_to_closest = manhattan_distance(predator.position, prey_index.position(closest));
+    if (dist_to_closest > PREDATOR_VISION_RADIUS) {
+        return -1;
     }
-    
     return closest;
 }
 
-void update_predator(Sprite& predator, const std::vector<Sprite>& all_predators, 
-                    const std::vector<Sprite>& all_prey, const World& world) {
+void update_predator(SpriteRef& predator, const SpriteStore& all_prey,
+                    const SpatialHash& prey_index, const World& world) {
     // Skip AI update if stunned (handled in move_randomly)
     if (predator.isStunned) {
         MovementController::move_randomly(predator, world);
@@ -289,23 +412,24 @@ void update_predator(Sprite& predator, const std::vector<Sprite>& all_predators,
     
     // 1. Find closest prey and check if it's in vision range
     int dist_to_closest_prey = 0;
-    const Sprite* target_prey = find_closest_prey(predator, all_prey, dist_to_closest_prey);
-    bool prey_in_sight = (target_prey != nullptr);
+    const int target_prey = find_closest_prey(predator, prey_index, dist_to_closest_prey);
+    bool prey_in_sight = (target_prey >= 0);
     
     // 2. Store previous state for transition logic
     Sprite::AIState previous_state = predator.currentState;
     
     // 3. Check if predator is stuck and try to resolve it if so
-    bool was_stuck = detect_and_resolve_stuck(predator, all_predators, world);
+    bool was_stuck = detect_and_resolve_stuck(predator, world);
     if (was_stuck) {
         return; // If predator was stuck and we had to intervene, skip rest of update
     }
     
     // 4. Update predator state
-    handle_state_transitions(predator, target_prey, prey_in_sight, previous_state);
+    handle_state_transitions(predator, prey_in_sight ? &all_prey.position[target_prey] : nullptr,
+                             prey_in_sight, previous_state);
     
     // 5. Generate or update path based on current state
-    generate_path(predator, target_prey, world);
+    generate_path(predator, all_prey, target_prey, world);
     
     // 6. Move the predator according to its current state
     if (predator.currentState == Sprite::AIState::RESTING) {
@@ -322,7 +446,25 @@ void update_predator(Sprite& predator, const std::vector<Sprite>& all_predators,
             Vec2D temp_current_pos = predator.position;
             
             // Try to move along the path using the appropriate speed
-            for (int i = 0; i < speed && (predator.pathFollowStep + i) < predator.currentPath.size(); ++i) {
+            int waypoint = predator.pathFollowStep;
+            for (int i = 0; i < speed && predator.pathIsWaypoints; ++i) {
+                // Waypoint paths: one cell along the line to the next waypoint per step
+                Vec2D check_step;
+                if (MovementController::next_waypoint_step(predator, temp_current_pos, waypoint, check_step) &&
+                    world.is_walkable(check_step)) {
+                    temp_current_pos = check_step;
+                    candidate_pos = temp_current_pos;
+                    moved_along_path = true;
+                } else {
+                    if (i == 0) {
+                        predator.currentPath.clear();
+                        predator.turnsSincePathReplan = REPLAN_PATH_INTERVAL;
+                    }
+                    break;
+                }
+            }
+            for (int i = 0; i < speed && !predator.pathIsWaypoints &&
+                            (predator.pathFollowStep + i) < predator.currentPath.size(); ++i) {
                 Vec2D check_step = predator.currentPath[predator.pathFollowStep + i];
                 if (manhattan_distance(temp_current_pos, check_step) == 1 && world.is_walkable(check_step)) {
                     temp_current_pos = check_step;
@@ -339,7 +481,7 @@ void update_predator(Sprite& predator, const std::vector<Sprite>& all_predators,
             
             if (moved_along_path) {
                 predator.position = candidate_pos;
-                predator.pathFollowStep += steps_taken_on_path;
+                predator.pathFollowStep = predator.pathIsWaypoints ? waypoint : predator.pathFollowStep + steps_taken_on_path;
                 
                 // Consume stamina if sprinting
                 if (predator.currentState == Sprite::AIState::SEEKING && speed > 1) {
@@ -347,7 +489,8 @@ void update_predator(Sprite& predator, const std::vector<Sprite>& all_predators,
                 }
                 
                 // Check if we've reached the end of the path
-                if (predator.pathFollowStep >= predator.currentPath.size()) {
+                if (predator.pathFollowStep >= predator.currentPath.size() ||
+                    (predator.pathIsWaypoints && predator.position == predator.currentPath.back())) {
                     predator.currentPath.clear();
                     predator.turnsSincePathReplan = REPLAN_PATH_INTERVAL;
                 }
@@ -1,29 +1,46 @@
 #ifndef PREDATOR_AI_H
 #define PREDATOR_AI_H
 
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "World.h"
+#include "SpatialHash.h"
 #include <vector>
+#include <cstddef>
 
 namespace PredatorAI {
     // Update a predator's AI state and position
-    void update_predator(Sprite& predator, const std::vector<Sprite>& all_predators, 
-                         const std::vector<Sprite>& all_prey, const World& world);
+    // (prey_index indexes the current positions of all_prey)
+    void update_predator(SpriteRef& predator, const SpriteStore& all_prey,
+                         const SpatialHash& prey_index, const World& world);
     
     // Handle predator's state transitions based on current situation
-    void handle_state_transitions(Sprite& predator, const Sprite* target_prey, 
+    // (target_prey is the position of the prey in sight, if any)
+    void handle_state_transitions(SpriteRef& predator, const Vec2D* target_prey, 
                                  bool prey_in_sight, Sprite::AIState previous_state);
     
     // Path generation for predator based on current state
-    void generate_path(Sprite& predator, const Sprite* target_prey, const World& world);
+    // (target_prey is an index into all_prey, or -1 if no prey is in sight)
+    void generate_path(SpriteRef& predator, const SpriteStore& all_prey, int target_prey, const World& world);
     
-    // Handle predator stuck detection and resolution
-    bool detect_and_resolve_stuck(Sprite& predator, const std::vector<Sprite>& all_predators, const World& world);
+    // Replan SEEKING / SEARCHING_LKP paths with each predator's IncrementalPlanner
+    // (default) instead of a fresh search through PathCache::shared(). Applies to the
+    // default A* engine only: other PATH_ENGINEs always run their own search.
+    void set_incremental_replanning(bool enabled);
+
+    // Cells a predator's path search may expand per tick (0 = no limit). A search that
+    // runs out hands back a partial path and carries on during the next tick. Only the
+    // default A* engine's searches are budgeted.
+    void set_path_expansion_budget(size_t cells);
+
+    // Handle predator stuck detection and resolution (the first MAX_TRACKED_PREDATORS
+    // predators of the store are tracked)
+    bool detect_and_resolve_stuck(SpriteRef& predator, const World& world);
     
     // Constants
     extern const int PREDATOR_VISION_RADIUS;
     extern const int REPLAN_PATH_INTERVAL;
     extern const int STUCK_THRESHOLD;
+    extern const size_t DEFAULT_PATH_EXPANSION_BUDGET;
 }
 
 #endif // PREDATOR_AI_H 
\ No newline at end of file
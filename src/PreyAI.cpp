@@ -16,33 +16,20 @@ const int MAX_DIST_TO_CONSIDER_SAFE_ZONE = 25;
 const float SAFE_ZONE_FEAR_DECAY_MULTIPLIER = 2.0f;
 
 // Forward declaration of helper function
-static const Sprite* find_closest_predator(const Sprite& prey, const std::vector<Sprite>& all_predators, int& distance);
+static const Vec2D* find_closest_predator(const SpriteRef& prey, const SpatialHash& all_predators, int& distance);
 
-static const Sprite* find_closest_predator(const Sprite& prey, const std::vector<Sprite>& all_predators, int& distance) {
-    const Sprite* closest = nullptr;
-    int min_dist_sq = std::numeric_limits<int>::max();
+static const Vec2D* find_closest_predator(const SpriteRef& prey, const SpatialHash& all_predators, int& distance) {
     distance = std::numeric_limits<int>::max();
 
-    if (all_predators.empty()) {
+    const int closest = all_predators.nearest(prey.position);
+    if (closest < 0) {
         return nullptr;
     }
-
-    for (const auto& predator : all_predators) {
-        int dist_sq = squared_distance(prey.position, predator.position);
-        if (dist_sq < min_dist_sq) {
-            min_dist_sq = dist_sq;
-            closest = &predator;
-        }
-    }
-
-    if (closest) {
-        distance = manhattan_distance(prey.position, closest->position);
-    }
-    
-    return closest;
+    distance = manhattan_distance(prey.position, all_predators.position(closest));
+    return &all_predators.position(closest);
 }
 
-void update_fear(Sprite& prey, bool predator_in_awareness_radius, 
+void update_fear(SpriteRef& prey, bool predator_in_awareness_radius, 
                 bool predator_has_los, const World& world) {
     if (predator_in_awareness_radius && predator_has_los) {
         // Increase fear when predator is visible
@@ -60,7 +47,7 @@ void update_fear(Sprite& prey, bool predator_in_awareness_radius,
     }
 }
 
-void handle_state_transitions(Sprite& prey, const Sprite* closest_predator,
+void handle_state_transitions(SpriteRef& prey, const Vec2D* closest_predator,
                              bool predator_in_awareness_radius, bool predator_has_los) {
     if (prey.currentState == Sprite::AIState::WANDERING) {
         if (predator_in_awareness_radius && predator_has_los) {
@@ -77,60 +64,50 @@ void handle_state_transitions(Sprite& prey, const Sprite* closest_predator,
     }
 }
 
-bool find_path_to_safe_zone(Sprite& prey, const Sprite* closest_predator, const World& world) {
+bool find_path_to_safe_zone(SpriteRef& prey, const Vec2D* closest_predator, const World& world) {
     if (!closest_predator) return false;
     
-    Vec2D best_safe_zone_target = {-1, -1};
-    std::vector<Vec2D> path_to_safe_zone;
-    int shortest_path_len_to_safe_zone = std::numeric_limits<int>::max();
-    
-    // Check each safe zone center
-    for (const auto& zone_center : world.get_safe_zone_centers()) {
-        // Skip zones that are too far away
-        if (manhattan_distance(prey.position, zone_center) > MAX_DIST_TO_CONSIDER_SAFE_ZONE) {
-            continue;
-        }
-        
-        // Find path to this safe zone
-        std::vector<Vec2D> current_path = find_path(prey.position, zone_center, 
-                                                   world.obstacles, world.width, world.height);
-        
-        // Check if this is a valid path and shorter than current best
-        if (!current_path.empty() && static_cast<int>(current_path.size()) < shortest_path_len_to_safe_zone) {
-            // Make sure the first step isn't towards the predator
-            if (current_path.size() > 1) {
-                Vec2D first_step_dir = {
-                    current_path[1].x - prey.position.x, 
-                    current_path[1].y - prey.position.y
-                };
-                Vec2D predator_dir = {
-                    closest_predator->position.x - prey.position.x, 
-                    closest_predator->position.y - prey.position.y
-                };
-                
-                // Check if step direction is not towards predator
-                // (dot product <= 0 means angle between vectors is >= 90 degrees)
-                if ((first_step_dir.x * predator_dir.x + first_step_dir.y * predator_dir.y) <= 0) {
-                    shortest_path_len_to_safe_zone = static_cast<int>(current_path.size());
-                    path_to_safe_zone = current_path;
-                    best_safe_zone_target = zone_center;
-                }
-            }
-        }
+    // The world keeps a BFS field toward the nearest reachable safe zone center, so
+    // zones out of reach are rejected without a search
+    int distance_to_safe_zone = world.get_safe_zone_distance(prey.position);
+    if (distance_to_safe_zone < 0 || distance_to_safe_zone > MAX_DIST_TO_CONSIDER_SAFE_ZONE) {
+        return false; // No safe zone within reach
     }
     
-    // If we found a valid path to a safe zone, set it
-    if (!path_to_safe_zone.empty()) {
-        prey.currentPath = path_to_safe_zone;
-        prey.is_heading_to_safe_zone = true;
-        prey.pathFollowStep = 0;
-        return true;
+    // The first step must not lead towards the predator
+    // (dot product <= 0 means angle between vectors is >= 90 degrees)
+    const Vec2D predator_dir = {
+        closest_predator->x - prey.position.x, 
+        closest_predator->y - prey.position.y
+    };
+    auto away_from_predator = [&](const Vec2D& from, const Vec2D& to) {
+        return from != prey.position ||
+               (to.x - from.x) * predator_dir.x + (to.y - from.y) * predator_dir.y <= 0;
+    };
+    
+    // The field's route to the nearest zone is usually fine as it is; otherwise one
+    // multi-goal search finds the nearest zone reachable with an allowed first step
+    std::vector<Vec2D> path_to_safe_zone;
+    if (!world.get_route_to_safe_zone(prey.position, path_to_safe_zone) || path_to_safe_zone.size() <= 1) {
+        return false;
+    }
+    if (!away_from_predator(path_to_safe_zone[0], path_to_safe_zone[1]) &&
+        find_path_to_any(prey.position, world.get_safe_zone_centers(), world, path_to_safe_zone,
+                         away_from_predator, MAX_DIST_TO_CONSIDER_SAFE_ZONE) < 0) {
+        return false;
+    }
+    if (path_to_safe_zone.size() <= 1) {
+        return false;
     }
     
-    return false;
+    // We found a valid path to a safe zone, set it
+    prey.currentPath = path_to_safe_zone;
+    prey.is_heading_to_safe_zone = true;
+    prey.pathFollowStep = 0;
+    return true;
 }
 
-Vec2D calculate_flee_position(Sprite& prey, const Sprite* closest_predator, const World& world) {
+Vec2D calculate_flee_position(SpriteRef& prey, const Vec2D* closest_predator, const World& world) {
     if (!closest_predator) return prey.position;
     
     Vec2D best_evade_move_offset = {0, 0};
@@ -146,17 +123,23 @@ Vec2D calculate_flee_position(Sprite& prey, const Sprite* closest_predator, cons
     // Randomize options for less predictable movement
     std::shuffle(evade_options.begin(), evade_options.end(), gen);
     
-    // Evaluate each possible move
+    // Check every candidate against the predator's sight in one batch (walls come back unseen)
+    std::vector<Vec2D> candidates;
     for (const auto& offset : evade_options) {
-        Vec2D potential_pos = {
-            prey.position.x + offset.x * prey.speed,
-            prey.position.y + offset.y * prey.speed
-        };
+        candidates.push_back({prey.position.x + offset.x * prey.speed, prey.position.y + offset.y * prey.speed});
+    }
+    std::vector<uint8_t> in_predator_sight(candidates.size());
+    PathfindingHelpers::can_see_many(*closest_predator, candidates.data(), candidates.size(), world,
+                                     in_predator_sight.data());
+    
+    // Evaluate each possible move
+    for (size_t i = 0; i < evade_options.size(); ++i) {
+        const Vec2D& offset = evade_options[i];
+        const Vec2D& potential_pos = candidates[i];
         
         if (world.is_walkable(potential_pos)) {
-            int new_dist_to_pred = manhattan_distance(closest_predator->position, potential_pos);
-            bool breaks_los = !has_line_of_sight(potential_pos, closest_predator->position, 
-                                                world.obstacles, world.width, world.height);
+            int new_dist_to_pred = manhattan_distance(*closest_predator, potential_pos);
+            bool breaks_los = !in_predator_sight[i];
             
             // Prioritize moves that break line of sight
             if (breaks_los) {
@@ -195,10 +178,10 @@ Vec2D calculate_flee_position(Sprite& prey, const Sprite* closest_predator, cons
     return next_pos;
 }
 
-void update_prey(Sprite& prey, const std::vector<Sprite>& all_predators, const World& world) {
+void update_prey(SpriteRef& prey, const SpatialHash& all_predators, const World& world) {
     // 1. Find closest predator
     int dist_to_closest_predator = 0;
-    const Sprite* closest_predator = find_closest_predator(prey, all_predators, dist_to_closest_predator);
+    const Vec2D* closest_predator = find_closest_predator(prey, all_predators, dist_to_closest_predator);
     
     // 2. Check if predator is in awareness radius and has line of sight
     bool predator_in_awareness_radius = (closest_predator != nullptr && 
@@ -206,8 +189,7 @@ void update_prey(Sprite& prey, const std::vector<Sprite>& all_predators, const W
     bool predator_has_los_to_prey = false;
     
     if (closest_predator && predator_in_awareness_radius) {
-        predator_has_los_to_prey = has_line_of_sight(prey.position, closest_predator->position, 
-                                                   world.obstacles, world.width, world.height);
+        predator_has_los_to_prey = PathfindingHelpers::can_see(*closest_predator, prey.position, world);
     }
     
     // 3. Update fear level
@@ -1,27 +1,29 @@
 #ifndef PREY_AI_H
 #define PREY_AI_H
 
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "World.h"
+#include "SpatialHash.h"
 #include <vector>
 
 namespace PreyAI {
-    // Update a prey's AI state and position
-    void update_prey(Sprite& prey, const std::vector<Sprite>& all_predators, const World& world);
+    // Update a prey's AI state and position (all_predators indexes the current predator positions)
+    void update_prey(SpriteRef& prey, const SpatialHash& all_predators, const World& world);
     
     // Handle prey's state transitions based on current situation
-    void handle_state_transitions(Sprite& prey, const Sprite* closest_predator, 
+    // (closest_predator is the position of the closest predator, if any)
+    void handle_state_transitions(SpriteRef& prey, const Vec2D* closest_predator, 
                                  bool predator_in_awareness_radius, bool predator_has_los);
     
     // Update prey's fear level based on predator proximity
-    void update_fear(Sprite& prey, bool predator_in_awareness_radius, 
+    void update_fear(SpriteRef& prey, bool predator_in_awareness_radius, 
                     bool predator_has_los, const World& world);
     
     // Handle prey fleeing logic
-    Vec2D calculate_flee_position(Sprite& prey, const Sprite* closest_predator, const World& world);
+    Vec2D calculate_flee_position(SpriteRef& prey, const Vec2D* closest_predator, const World& world);
     
     // Find path to nearest safe zone
-    bool find_path_to_safe_zone(Sprite& prey, const Sprite* closest_predator, const World& world);
+    bool find_path_to_safe_zone(SpriteRef& prey, const Vec2D* closest_predator, const World& world);
     
     // Constants
     extern const int PREY_AWARENESS_RADIUS;
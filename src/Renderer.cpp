@@ -5,8 +5,8 @@
 namespace Renderer {
 
 void render_to_console(
-    const std::vector<Sprite>& predators,
-    const std::vector<Sprite>& prey_sprites,
+    const SpriteStore& predators,
+    const SpriteStore& prey_sprites,
     const World& world,
     int current_step,
     int max_steps,
@@ -3,7 +3,7 @@
 
 #include <vector>
 #include <string>
-#include "Sprite.h"
+#include "SpriteStore.h"
 #include "World.h"
 
 // Handles console rendering.
@@ -13,8 +13,8 @@ namespace Renderer {
     // Renders the current game state to the console.
     // Needs access to renderer state (passed by reference or managed internally if Renderer becomes a class).
     void render_to_console(
-        const std::vector<Sprite>& predators,
-        const std::vector<Sprite>& prey_sprites,
+        const SpriteStore& predators,
+        const SpriteStore& prey_sprites,
         const World& world,
         int current_step, // Added for displaying progress
         int max_steps,    // Added for displaying progress
@@ -1,36 +1,111 @@
 #include "SimulationSetup.h"
+#include "Pathfinding.h"
+#include "PathCache.h"
+#include "PredatorAI.h"
+#include "FlowField.h"
+#include "PathService.h"
 #include <algorithm>
 #include <cstdlib>   // For getenv function
 #include <limits>
 
 namespace SimulationSetup {
 
-int get_max_steps() {
-    // Try to get MAX_STEPS from environment
+int get_env_int(const char* name, int default_value) {
+    // Try to get the value from the environment
     char* env_val_buffer = nullptr;
     size_t buffer_size = 0;
-    errno_t err = _dupenv_s(&env_val_buffer, &buffer_size, "MAX_STEPS");
+    errno_t err = _dupenv_s(&env_val_buffer, &buffer_size, name);
 
     if (err == 0 && env_val_buffer != nullptr) {
         try {
-            int steps = std::stoi(env_val_buffer);
+            int value = std::stoi(env_val_buffer);
             free(env_val_buffer); // Free the buffer allocated by _dupenv_s
-            return steps;
+            return value;
         } catch (const std::exception&) {
             // In case of conversion error, use default
             free(env_val_buffer); // Free the buffer in case of error too
-            return 100000;
+            return default_value;
         }
     }
     // Default if not set or if _dupenv_s failed (env_val_buffer would be null)
     if (env_val_buffer) { // Should be null if err != 0, but good practice
         free(env_val_buffer);
     }
-    return 100000;
+    return default_value;
+}
+
+std::string get_env_string(const char* name, const std::string& default_value) {
+    char* env_val_buffer = nullptr;
+    size_t buffer_size = 0;
+    errno_t err = _dupenv_s(&env_val_buffer, &buffer_size, name);
+
+    std::string value = default_value;
+    if (err == 0 && env_val_buffer != nullptr) {
+        value = env_val_buffer;
+    }
+    if (env_val_buffer) {
+        free(env_val_buffer); // Free the buffer allocated by _dupenv_s
+    }
+    return value;
+}
+
+int get_max_steps() {
+    return get_env_int("MAX_STEPS", 100000);
+}
+
+int get_world_width() {
+    return get_env_int("WORLD_WIDTH", World::DEFAULT_WIDTH);
+}
+
+int get_world_height() {
+    return get_env_int("WORLD_HEIGHT", World::DEFAULT_HEIGHT);
+}
+
+uint32_t get_world_seed() {
+    // A fresh random seed unless the caller pinned one to reproduce a map
+    std::random_device seed_source;
+    return static_cast<uint32_t>(get_env_int("WORLD_SEED", static_cast<int>(seed_source() & 0x7FFFFFFF)));
+}
+
+int get_dynamic_wall_interval() {
+    return std::max(0, get_env_int("DYNAMIC_WALLS", 0));
+}
+
+void apply_path_engine_setting() {
+    PathEngine engine = PathEngine::ASTAR;
+    parse_path_engine(get_env_string("PATH_ENGINE", path_engine_name(engine)), engine);
+    set_active_path_engine(engine);
+}
+
+void apply_path_cache_setting() {
+    const int entries = get_env_int("PATH_CACHE", static_cast<int>(PathCache::DEFAULT_CAPACITY));
+    PathCache::shared().set_capacity(static_cast<size_t>(std::max(0, entries)));
+}
+
+void apply_incremental_replan_setting() {
+    PredatorAI::set_incremental_replanning(get_env_int("INCREMENTAL_REPLAN", 1) != 0);
+}
+
+void apply_path_budget_setting() {
+    const int cells = get_env_int("PATH_BUDGET", static_cast<int>(PredatorAI::DEFAULT_PATH_EXPANSION_BUDGET));
+    PredatorAI::set_path_expansion_budget(static_cast<size_t>(std::max(0, cells)));
+}
+
+void apply_path_service_setting() {
+    PathService::shared().set_thread_count(static_cast<size_t>(std::max(0, get_env_int("PATH_THREADS", 0))));
+}
+
+void apply_flow_field_setting() {
+    const int radius = get_env_int("FLOW_FIELDS", 0);
+    FlowFieldCache::shared().set_radius(radius == 1 ? FlowFieldCache::DEFAULT_RADIUS : std::max(0, radius));
+}
+
+std::string get_world_file() {
+    return get_env_string("WORLD_FILE", "");
 }
 
-std::vector<Sprite> initialize_predators() {
-    std::vector<Sprite> predators;
+SpriteStore initialize_predators() {
+    SpriteStore predators(Sprite::Type::PREDATOR);
     predators.reserve(NUM_PREDATORS);
     
     for (int i = 0; i < NUM_PREDATORS; ++i) {
@@ -59,8 +134,8 @@ std::vector<Sprite> initialize_predators() {
     return predators;
 }
 
-std::vector<Sprite> initialize_prey(const World& world) {
-    std::vector<Sprite> prey_sprites;
+SpriteStore initialize_prey(const World& world) {
+    SpriteStore prey_sprites(Sprite::Type::PREY);
     prey_sprites.reserve(NUM_PREY);
     
     for (int i = 0; i < NUM_PREY; ++i) {
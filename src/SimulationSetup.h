@@ -2,8 +2,10 @@
 #define SIMULATION_SETUP_H
 
 #include <vector>
+#include <string>
 #include <random>
-#include "Sprite.h"
+#include <cstdint>
+#include "SpriteStore.h"
 #include "World.h"
 
 // External reference to the global random generator
@@ -15,13 +17,53 @@ namespace SimulationSetup {
     const int NUM_PREY = 6;
 
     // Initialize the predators in the world
-    std::vector<Sprite> initialize_predators();
+    SpriteStore initialize_predators();
     
     // Initialize the prey in the world
-    std::vector<Sprite> initialize_prey(const World& world);
+    SpriteStore initialize_prey(const World& world);
     
+    // Read an integer environment variable, falling back to default_value if unset or invalid
+    int get_env_int(const char* name, int default_value);
+
+    // Read a string environment variable, falling back to default_value if unset
+    std::string get_env_string(const char* name, const std::string& default_value);
+
     // Get the maximum number of steps from environment variable
     int get_max_steps();
+
+    // Get the world dimensions from WORLD_WIDTH / WORLD_HEIGHT (defaults to the classic 60x20)
+    int get_world_width();
+    int get_world_height();
+
+    // Get the world generation seed from WORLD_SEED (random if unset)
+    uint32_t get_world_seed();
+
+    // Get the number of steps between dynamic wall changes from DYNAMIC_WALLS (0 = static world)
+    int get_dynamic_wall_interval();
+
+    // Apply the search engine named by PATH_ENGINE (see path_engine_name; A* if unset or unknown)
+    void apply_path_engine_setting();
+
+    // Size the predators' shared path cache from PATH_CACHE (entries, 0 = off, default 256)
+    void apply_path_cache_setting();
+
+    // Turn the predators' incremental chase replanning on or off from INCREMENTAL_REPLAN (default 1)
+    void apply_incremental_replan_setting();
+
+    // Limit the cells each predator's path search expands per tick from PATH_BUDGET
+    // (0 = no limit, default PredatorAI::DEFAULT_PATH_EXPANSION_BUDGET)
+    void apply_path_budget_setting();
+
+    // Run the predators' chase searches on PATH_THREADS worker threads, delivered the
+    // following tick (0 = search inline on the simulation thread, the default)
+    void apply_path_service_setting();
+
+    // Share per-tick flow fields between predators chasing the same prey if FLOW_FIELDS
+    // is set (window radius in cells, 1 = default radius; off by default)
+    void apply_flow_field_setting();
+
+    // Get the world file path from WORLD_FILE (empty if maps should not be saved or loaded)
+    std::string get_world_file();
 }
 
 #endif // SIMULATION_SETUP_H 
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include "SpatialHash.h"
+
+#include <algorithm> // For std::min, std::max, std::sort, std::push_heap, std::pop_heap
+#include <utility>   // For std::pair
+#include <cstdlib>   // For std::abs
+
+namespace {
+
+const int MIN_CELL_SHIFT = 2;  // 4-cell buckets at the densest
+const int MAX_CELL_SHIFT = 10; // 1024-cell buckets at the sparsest
+
+int64_t distance_sq(const Vec2D& a, int x, int y) {
+    const int64_t dx = a.x - x;
+    const int64_t dy = a.y - y;
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+void SpatialHash::build(const std::vector<Vec2D>& new_positions) {
+    positions = &new_positions;
+    entries.clear();
+    bucket_start.clear();
+    bucket_mask = 0;
+    min_cell_x = min_cell_y = 0;
+    max_cell_x = max_cell_y = -1;
+    if (new_positions.size() <= LINEAR_SCAN_LIMIT) {
+        return;
+    }
+
+    int min_x = INT_MAX;
+    int min_y = INT_MAX;
+    int max_x = INT_MIN;
+    int max_y = INT_MIN;
+    for (const Vec2D& pos : new_positions) {
+        min_x = std::min(min_x, pos.x);
+        min_y = std::min(min_y, pos.y);
+        max_x = std::max(max_x, pos.x);
+        max_y = std::max(max_y, pos.y);
+    }
+
+    // About one sprite per cell if they were spread evenly over their bounding box
+    const double area = (static_cast<double>(max_x) - min_x + 1) * (static_cast<double>(max_y) - min_y + 1);
+    cell_shift = MIN_CELL_SHIFT;
+    while (cell_shift < MAX_CELL_SHIFT && static_cast<double>(1 << (2 * cell_shift)) * new_positions.size() < area) {
+        cell_shift++;
+    }
+    min_cell_x = min_x >> cell_shift;
+    min_cell_y = min_y >> cell_shift;
+    max_cell_x = max_x >> cell_shift;
+    max_cell_y = max_y >> cell_shift;
+
+    size_t bucket_count = 64;
+    while (bucket_count < new_positions.size()) {
+        bucket_count <<= 1;
+    }
+    bucket_mask = bucket_count - 1;
+
+    // Counting sort by bucket: count, prefix sums, then scatter in vector order
+    bucket_start.assign(bucket_count + 1, 0);
+    for (const Vec2D& pos : new_positions) {
+        bucket_start[bucket_of(pos.x >> cell_shift, pos.y >> cell_shift) + 1]++;
+    }
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        bucket_start[bucket + 1] += bucket_start[bucket];
+    }
+    entries.resize(new_positions.size());
+    for (size_t i = 0; i < new_positions.size(); ++i) {
+        const Vec2D& pos = new_positions[i];
+        const size_t bucket = bucket_of(pos.x >> cell_shift, pos.y >> cell_shift);
+        entries[bucket_start[bucket]++] = {pos.x, pos.y, static_cast<int>(i)};
+    }
+    // Each bucket's offset has been advanced to where the next bucket starts: shift back
+    for (size_t bucket = bucket_count; bucket > 0; --bucket) {
+        bucket_start[bucket] = bucket_start[bucket - 1];
+    }
+    bucket_start[0] = 0;
+}
+
+template <typename Fn>
+void SpatialHash::for_each_in_cell(int cell_x, int cell_y, Fn&& fn) const {
+    const size_t bucket = bucket_of(cell_x, cell_y);
+    for (uint32_t i = bucket_start[bucket]; i < bucket_start[bucket + 1]; ++i) {
+        const Entry& entry = entries[i];
+        if ((entry.x >> cell_shift) == cell_x && (entry.y >> cell_shift) == cell_y) {
+            fn(entry);
+        }
+    }
+}
+
+template <typename Fn>
+bool SpatialHash::for_each_ring_cell(int center_x, int center_y, int r, Fn&& visit) const {
+    const int left = center_x - r;
+    const int right = center_x + r;
+    const int top = center_y - r;
+    const int bottom = center_y + r;
+    if (left < min_cell_x && right > max_cell_x && top < min_cell_y && bottom > max_cell_y) {
+        return false; // Every occupied cell is inside the rings already searched
+    }
+    const int first_x = std::max(left, min_cell_x);
+    const int last_x = std::min(right, max_cell_x);
+    if (top >= min_cell_y && top <= max_cell_y) {
+        for (int x = first_x; x <= last_x; ++x) {
+            visit(x, top);
+        }
+    }
+    if (r > 0 && bottom >= min_cell_y && bottom <= max_cell_y) {
+        for (int x = first_x; x <= last_x; ++x) {
+            visit(x, bottom);
+        }
+    }
+    const int first_y = std::max(top + 1, min_cell_y);
+    const int last_y = std::min(bottom - 1, max_cell_y);
+    if (r > 0 && left >= min_cell_x && left <= max_cell_x) {
+        for (int y = first_y; y <= last_y; ++y) {
+            visit(left, y);
+        }
+    }
+    if (r > 0 && right >= min_cell_x && right <= max_cell_x) {
+        for (int y = first_y; y <= last_y; ++y) {
+            visit(right, y);
+        }
+    }
+    return true;
+}
+
+int64_t SpatialHash::ring_clearance_sq(const Vec2D& pos, int r) const {
+    // Cells outside ring r start this far from pos along one axis or the other
+    const int cell_x = pos.x >> cell_shift;
+    const int cell_y = pos.y >> cell_shift;
+    const int64_t gap = std::min(std::min(pos.x - ((cell_x - r) << cell_shift) + 1, ((cell_x + r + 1) << cell_shift) - pos.x),
+                                 std::min(pos.y - ((cell_y - r) << cell_shift) + 1, ((cell_y + r + 1) << cell_shift) - pos.y));
+    return gap * gap;
+}
+
+int SpatialHash::nearest(const Vec2D& pos, int64_t max_dist_sq) const {
+    int best = -1;
+    int64_t best_dist_sq = max_dist_sq;
+    auto consider = [&](int x, int y, int index) {
+        const int64_t dist_sq = distance_sq(pos, x, y);
+        if (dist_sq < best_dist_sq || (dist_sq == best_dist_sq && (best < 0 || index < best))) {
+            best_dist_sq = dist_sq;
+            best = index;
+        }
+    };
+
+    if (entries.empty()) {
+        for (size_t i = 0; i < size(); ++i) {
+            consider((*positions)[i].x, (*positions)[i].y, static_cast<int>(i));
+        }
+        return best;
+    }
+
+    const int cell_x = pos.x >> cell_shift;
+    const int cell_y = pos.y >> cell_shift;
+    for (int r = 0;; ++r) {
+        const bool inside = for_each_ring_cell(cell_x, cell_y, r, [&](int x, int y) {
+            for_each_in_cell(x, y, [&](const Entry& entry) { consider(entry.x, entry.y, entry.index); });
+        });
+        // Anything further out is strictly farther than the best so far (or the limit)
+        if (!inside || ring_clearance_sq(pos, r) > best_dist_sq) {
+            break;
+        }
+    }
+    return best;
+}
+
+void SpatialHash::k_nearest(const Vec2D& pos, size_t k, std::vector<int>& out) const {
+    out.clear();
+    if (k == 0 || size() == 0) {
+        return;
+    }
+    // Max-heap of the k best (distance, index) pairs so far; the worst one is on top
+    std::vector<std::pair<int64_t, int>> best;
+    best.reserve(k + 1);
+    auto consider = [&](int x, int y, int index) {
+        const std::pair<int64_t, int> candidate = {distance_sq(pos, x, y), index};
+        if (best.size() < k || candidate < best.front()) {
+            best.push_back(candidate);
+            std::push_heap(best.begin(), best.end());
+            if (best.size() > k) {
+                std::pop_heap(best.begin(), best.end());
+                best.pop_back();
+            }
+        }
+    };
+
+    if (entries.empty()) {
+        for (size_t i = 0; i < size(); ++i) {
+            consider((*positions)[i].x, (*positions)[i].y, static_cast<int>(i));
+        }
+    } else {
+        const int cell_x = pos.x >> cell_shift;
+        const int cell_y = pos.y >> cell_shift;
+        for (int r = 0;; ++r) {
+            const bool inside = for_each_ring_cell(cell_x, cell_y, r, [&](int x, int y) {
+                for_each_in_cell(x, y, [&](const Entry& entry) { consider(entry.x, entry.y, entry.index); });
+            });
+            if (!inside || (best.size() == k && ring_clearance_sq(pos, r) > best.front().first)) {
+                break;
+            }
+        }
+    }
+
+    std::sort(best.begin(), best.end());
+    for (const auto& candidate : best) {
+        out.push_back(candidate.second);
+    }
+}
+
+void SpatialHash::within_radius(const Vec2D& pos, int radius, std::vector<int>& out) const {
+    out.clear();
+    if (radius < 0) {
+        return;
+    }
+    const int64_t radius_sq = static_cast<int64_t>(radius) * radius;
+    if (entries.empty()) {
+        for (size_t i = 0; i < size(); ++i) {
+            if (distance_sq(pos, (*positions)[i].x, (*positions)[i].y) <= radius_sq) {
+                out.push_back(static_cast<int>(i));
+            }
+        }
+        return;
+    }
+
+    const int first_x = std::max(min_cell_x, (pos.x - radius) >> cell_shift);
+    const int last_x = std::min(max_cell_x, (pos.x + radius) >> cell_shift);
+    const int first_y = std::max(min_cell_y, (pos.y - radius) >> cell_shift);
+    const int last_y = std::min(max_cell_y, (pos.y + radius) >> cell_shift);
+    for (int y = first_y; y <= last_y; ++y) {
+        for (int x = first_x; x <= last_x; ++x) {
+            for_each_in_cell(x, y, [&](const Entry& entry) {
+                if (distance_sq(pos, entry.x, entry.y) <= radius_sq) {
+                    out.push_back(entry.index);
+                }
+            });
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+void SpatialHash::within_square(const Vec2D& center, int half_side, std::vector<int>& out) const {
+    out.clear();
+    if (half_side < 0) {
+        return;
+    }
+    auto inside = [&](int x, int y) { return std::abs(x - center.x) <= half_side && std::abs(y - center.y) <= half_side; };
+    if (entries.empty()) {
+        for (size_t i = 0; i < size(); ++i) {
+            if (inside((*positions)[i].x, (*positions)[i].y)) {
+                out.push_back(static_cast<int>(i));
+            }
+        }
+        return;
+    }
+
+    const int first_x = std::max(min_cell_x, (center.x - half_side) >> cell_shift);
+    const int last_x = std::min(max_cell_x, (center.x + half_side) >> cell_shift);
+    const int first_y = std::max(min_cell_y, (center.y - half_side) >> cell_shift);
+    const int last_y = std::min(max_cell_y, (center.y + half_side) >> cell_shift);
+    for (int y = first_y; y <= last_y; ++y) {
+        for (int x = first_x; x <= last_x; ++x) {
+            for_each_in_cell(x, y, [&](const Entry& entry) {
+                if (inside(entry.x, entry.y)) {
+                    out.push_back(entry.index);
+                }
+            });
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+size_t SpatialHash::memory_bytes() const {
+    return bucket_start.capacity() * sizeof(uint32_t) + entries.capacity() * sizeof(Entry);
+}
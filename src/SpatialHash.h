@@ -0,0 +1,85 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include "Vec2D.h"
+
+// Sprite positions bucketed on a uniform grid, for closest-sprite queries that do not
+// scan every sprite.
+//
+// build() takes a snapshot of a position column (SpriteStore::position): grid cells are
+// hashed into about one bucket per sprite, and the entries are counting-sorted by
+// bucket, so a build is two passes over the positions with no per-bucket allocations.
+// The cell size is a power of two picked from the sprites' bounding box so that cells
+// hold about one sprite each.
+// Queries search rings of cells outward from the query cell and stop once no cell
+// further out can hold anything closer. Results are indices into the vector, valid
+// until it changes; rebuild after sprites move, are added or are removed.
+//
+// Distances are squared Euclidean, like the full scans these replace, and ties go to
+// the sprite that comes first in the vector, so results match a scan exactly.
+class SpatialHash {
+public:
+    // At most this many sprites are simply scanned (no grid is built)
+    static constexpr size_t LINEAR_SCAN_LIMIT = 32;
+
+    // Index the current sprite positions (which must outlive the queries)
+    void build(const std::vector<Vec2D>& positions);
+
+    size_t size() const { return positions ? positions->size() : 0; }
+    const Vec2D& position(int index) const { return (*positions)[index]; }
+    int cell_size() const { return 1 << cell_shift; }
+
+    // Index of the sprite nearest to pos, or -1 if none lies within max_dist_sq
+    int nearest(const Vec2D& pos, int64_t max_dist_sq = INT64_MAX) const;
+
+    // Indices of the k sprites nearest to pos (fewer if there are fewer), nearest first
+    void k_nearest(const Vec2D& pos, size_t k, std::vector<int>& out) const;
+
+    // Indices of the sprites within radius of pos (Euclidean), in vector order
+    void within_radius(const Vec2D& pos, int radius, std::vector<int>& out) const;
+
+    // Indices of the sprites at most half_side cells from center on both axes, in vector order
+    void within_square(const Vec2D& center, int half_side, std::vector<int>& out) const;
+
+    size_t memory_bytes() const;
+
+private:
+    struct Entry {
+        int x;
+        int y;
+        int index; // Into the sprite vector
+    };
+
+    size_t bucket_of(int cell_x, int cell_y) const {
+        const uint32_t hash = static_cast<uint32_t>(cell_x) * 73856093u ^ static_cast<uint32_t>(cell_y) * 19349663u;
+        return hash & bucket_mask;
+    }
+
+    // Calls fn(entry) for every sprite in grid cell (cell_x, cell_y)
+    template <typename Fn>
+    void for_each_in_cell(int cell_x, int cell_y, Fn&& fn) const;
+
+    // Calls visit(cell_x, cell_y) for the cells of ring r around (center_x, center_y)
+    // that lie inside the occupied box; false once the ring lies wholly outside it
+    template <typename Fn>
+    bool for_each_ring_cell(int center_x, int center_y, int r, Fn&& visit) const;
+
+    // Squared distance from pos to the nearest cell outside ring r around pos's cell
+    int64_t ring_clearance_sq(const Vec2D& pos, int r) const;
+
+    const std::vector<Vec2D>* positions = nullptr;
+    int cell_shift = 0;
+    int min_cell_x = 0; // Occupied box, in cells
+    int min_cell_y = 0;
+    int max_cell_x = -1;
+    int max_cell_y = -1;
+    size_t bucket_mask = 0;
+    std::vector<uint32_t> bucket_start; // bucket_mask + 2 offsets into entries
+    std::vector<Entry> entries;         // Sorted by bucket, vector order within one
+};
+
+#endif // SPATIAL_HASH_H
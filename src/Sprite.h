@@ -3,6 +3,8 @@
 
 #include <string> // For color strings
 #include <vector>     // For std::vector (used in currentPath)
+#include <cstdint>    // For uint64_t
+#include <memory>     // For std::shared_ptr (pathPlanner, pathSearch, pendingPath)
 #include "Vec2D.h" // Include the new Vec2D header
 
 // ANSI Color Codes
@@ -19,7 +21,12 @@ namespace Color {
 }
 
 // Forward declare if we need a more complex GameWorld/Screen representation later
+class IncrementalPlanner;
+class BudgetedSearch;
+struct PathTicket;
 
+// Everything about one sprite. The simulation keeps its sprites in a SpriteStore, split
+// into columns; a Sprite is what one is added from (SpriteStore::push_back)
 struct Sprite {
     Vec2D position;  // Current top-left position
     Vec2D size;      // Width and height
@@ -56,8 +63,13 @@ struct Sprite {
 
     // For Predator Path Caching
     std::vector<Vec2D> currentPath;
+    bool pathIsWaypoints = false;  // currentPath holds any-angle waypoints (find_waypoints_theta), not every step
     int pathFollowStep = 0;
     int turnsSincePathReplan = 0;
+    uint64_t pathWorldVersion = 0; // World::obstacle_version the path was last checked against
+    std::shared_ptr<IncrementalPlanner> pathPlanner; // Search state kept between chase replans (created on first use)
+    std::shared_ptr<BudgetedSearch> pathSearch;      // Unfinished search resumed next tick when incremental replanning is off
+    std::shared_ptr<PathTicket> pendingPath;         // Replan queued on the PathService, adopted once ready
 
     // For Predator Patrolling/Smarter Wandering
     std::vector<Vec2D> recentWanderTrail; // Stores last few unique positions during wandering
@@ -66,7 +78,7 @@ struct Sprite {
     enum class Type { PREDATOR, PREY };
     Type type;
 
-    enum class AIState { 
+    enum class AIState : uint8_t { 
         WANDERING,      // For both predator and prey
         SEEKING,        // Predator specific: actively hunting prey
         SEARCHING_LKP,  // Predator: moving to last known prey position
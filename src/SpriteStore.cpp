@@ -0,0 +1,77 @@
+#include "SpriteStore.h"
+
+#include <utility> // For std::move
+
+void SpriteStore::reserve(size_t count) {
+    position.reserve(count);
+    state.reserve(count);
+    fear.reserve(count);
+    stamina.reserve(count);
+    stunned.reserve(count);
+    stun_duration.reserve(count);
+    detail.reserve(count);
+    route.reserve(count);
+    trail.reserve(count);
+    look.reserve(count);
+}
+
+void SpriteStore::push_back(const Sprite& sprite) {
+    position.push_back(sprite.position);
+    state.push_back(sprite.currentState);
+    fear.push_back(sprite.currentFear);
+    stamina.push_back(sprite.currentStamina);
+    stunned.push_back(sprite.isStunned ? 1 : 0);
+    stun_duration.push_back(sprite.stunDuration);
+    detail.push_back({sprite.size, sprite.speed, sprite.lastKnownPreyPosition, sprite.lastMoveDirection,
+                      sprite.stepsInCurrentDirection, sprite.maxStamina, sprite.staminaRechargeTime,
+                      sprite.staminaRechargeCounter, sprite.restingDuration, sprite.maxRestingDuration,
+                      sprite.evasionChance, sprite.maxFear, sprite.fearIncreaseRate, sprite.fearDecreaseRate,
+                      sprite.is_heading_to_safe_zone});
+    route.push_back({sprite.currentPath, sprite.pathIsWaypoints, sprite.pathFollowStep, sprite.turnsSincePathReplan,
+                     sprite.pathWorldVersion, sprite.pathPlanner, sprite.pathSearch, sprite.pendingPath});
+    trail.push_back(sprite.recentWanderTrail);
+    look.push_back({sprite.displayChar, sprite.colorCode});
+}
+
+// Drop the entries of column at indices (ascending), moving the rest down in order
+template <typename T>
+static void compact(std::vector<T>& column, const std::vector<size_t>& indices) {
+    size_t write = indices.front();
+    size_t next = 0;
+    for (size_t read = indices.front(); read < column.size(); ++read) {
+        if (next < indices.size() && indices[next] == read) {
+            next++;
+            continue;
+        }
+        column[write++] = std::move(column[read]);
+    }
+    column.resize(write);
+}
+
+void SpriteStore::remove(const std::vector<size_t>& indices) {
+    if (indices.empty()) {
+        return;
+    }
+    compact(position, indices);
+    compact(state, indices);
+    compact(fear, indices);
+    compact(stamina, indices);
+    compact(stunned, indices);
+    compact(stun_duration, indices);
+    compact(detail, indices);
+    compact(route, indices);
+    compact(trail, indices);
+    compact(look, indices);
+}
+
+size_t SpriteStore::memory_bytes() const {
+    size_t bytes = position.capacity() * sizeof(Vec2D) + state.capacity() * sizeof(Sprite::AIState) +
+                   fear.capacity() * sizeof(float) + stamina.capacity() * sizeof(int) +
+                   stunned.capacity() * sizeof(uint8_t) + stun_duration.capacity() * sizeof(int) +
+                   detail.capacity() * sizeof(SpriteDetail) + route.capacity() * sizeof(SpriteRoute) +
+                   trail.capacity() * sizeof(std::vector<Vec2D>) + look.capacity() * sizeof(SpriteLook);
+    for (size_t i = 0; i < size(); ++i) {
+        bytes += route[i].currentPath.capacity() * sizeof(Vec2D) + trail[i].capacity() * sizeof(Vec2D);
+    }
+    return bytes;
+}
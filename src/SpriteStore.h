@@ -0,0 +1,181 @@
+#ifndef SPRITE_STORE_H
+#define SPRITE_STORE_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "Vec2D.h"
+#include "Sprite.h"
+
+// Fields only a sprite's own AI update reads or writes: its tuning and bookkeeping
+struct SpriteDetail {
+    Vec2D size;
+    int speed;
+    Vec2D lastKnownPreyPosition;
+    Vec2D lastMoveDirection;
+    int stepsInCurrentDirection;
+    int maxStamina;
+    int staminaRechargeTime;
+    int staminaRechargeCounter;
+    int restingDuration;
+    int maxRestingDuration;
+    float evasionChance;
+    float maxFear;
+    float fearIncreaseRate;
+    float fearDecreaseRate;
+    bool is_heading_to_safe_zone;
+};
+
+// The path a sprite follows and the search state behind it
+struct SpriteRoute {
+    std::vector<Vec2D> currentPath;
+    bool pathIsWaypoints;
+    int pathFollowStep;
+    int turnsSincePathReplan;
+    uint64_t pathWorldVersion;
+    std::shared_ptr<IncrementalPlanner> pathPlanner;
+    std::shared_ptr<BudgetedSearch> pathSearch;
+    std::shared_ptr<PathTicket> pendingPath;
+};
+
+// How a sprite is drawn
+struct SpriteLook {
+    char displayChar;
+    std::string colorCode;
+};
+
+struct SpriteRef;
+
+// The sprites of one type (all predators or all prey), stored column by column.
+//
+// The fields every tick sweeps over for all sprites (position, state, fear, stamina,
+// stun) each have a column of their own, so those loops read nothing else. What only a
+// sprite's own update touches is one SpriteDetail per sprite. Paths, wander trails and
+// display data are kept apart from both. Sprite is the description a sprite is added
+// from; operator[] gives a SpriteRef, which has the same field names, for code that
+// works on one sprite at a time. Index i is the same sprite in every column.
+struct SpriteStore {
+    explicit SpriteStore(Sprite::Type sprite_type) : type(sprite_type) {}
+
+    Sprite::Type type; // Of every sprite in the store
+
+    // Hot columns
+    std::vector<Vec2D> position;
+    std::vector<Sprite::AIState> state;
+    std::vector<float> fear;
+    std::vector<int> stamina;
+    std::vector<uint8_t> stunned;
+    std::vector<int> stun_duration;
+
+    std::vector<SpriteDetail> detail;
+
+    // Cold columns
+    std::vector<SpriteRoute> route;
+    std::vector<std::vector<Vec2D>> trail; // Recent wander trail, newest first
+    std::vector<SpriteLook> look;
+
+    size_t size() const { return position.size(); }
+    bool empty() const { return position.empty(); }
+    void reserve(size_t count);
+
+    // Add a sprite (its type must be the store's)
+    void push_back(const Sprite& sprite);
+
+    SpriteRef operator[](size_t index);
+
+    // Remove the sprites at indices (ascending) in one pass, keeping the rest in order
+    void remove(const std::vector<size_t>& indices);
+
+    size_t memory_bytes() const;
+};
+
+// One sprite of a SpriteStore, seen through references into its columns. The fields are
+// named as in Sprite, so per-sprite code reads the same as it would on a Sprite. Valid
+// until the store is resized.
+struct SpriteRef {
+    SpriteRef(SpriteStore& store, size_t sprite_index);
+
+    const size_t index; // In the store
+    const Sprite::Type& type;
+
+    Vec2D& position;
+    Sprite::AIState& currentState;
+    float& currentFear;
+    int& currentStamina;
+    uint8_t& isStunned;
+    int& stunDuration;
+
+    Vec2D& size;
+    int& speed;
+    Vec2D& lastKnownPreyPosition;
+    Vec2D& lastMoveDirection;
+    int& stepsInCurrentDirection;
+    int& maxStamina;
+    int& staminaRechargeTime;
+    int& staminaRechargeCounter;
+    int& restingDuration;
+    int& maxRestingDuration;
+    float& evasionChance;
+    float& maxFear;
+    float& fearIncreaseRate;
+    float& fearDecreaseRate;
+    bool& is_heading_to_safe_zone;
+
+    std::vector<Vec2D>& currentPath;
+    bool& pathIsWaypoints;
+    int& pathFollowStep;
+    int& turnsSincePathReplan;
+    uint64_t& pathWorldVersion;
+    std::shared_ptr<IncrementalPlanner>& pathPlanner;
+    std::shared_ptr<BudgetedSearch>& pathSearch;
+    std::shared_ptr<PathTicket>& pendingPath;
+
+    std::vector<Vec2D>& recentWanderTrail;
+
+    char& displayChar;
+    std::string& colorCode;
+};
+
+inline SpriteRef::SpriteRef(SpriteStore& store, size_t sprite_index)
+    : index(sprite_index),
+      type(store.type),
+      position(store.position[sprite_index]),
+      currentState(store.state[sprite_index]),
+      currentFear(store.fear[sprite_index]),
+      currentStamina(store.stamina[sprite_index]),
+      isStunned(store.stunned[sprite_index]),
+      stunDuration(store.stun_duration[sprite_index]),
+      size(store.detail[sprite_index].size),
+      speed(store.detail[sprite_index].speed),
+      lastKnownPreyPosition(store.detail[sprite_index].lastKnownPreyPosition),
+      lastMoveDirection(store.detail[sprite_index].lastMoveDirection),
+      stepsInCurrentDirection(store.detail[sprite_index].stepsInCurrentDirection),
+      maxStamina(store.detail[sprite_index].maxStamina),
+      staminaRechargeTime(store.detail[sprite_index].staminaRechargeTime),
+      staminaRechargeCounter(store.detail[sprite_index].staminaRechargeCounter),
+      restingDuration(store.detail[sprite_index].restingDuration),
+      maxRestingDuration(store.detail[sprite_index].maxRestingDuration),
+      evasionChance(store.detail[sprite_index].evasionChance),
+      maxFear(store.detail[sprite_index].maxFear),
+      fearIncreaseRate(store.detail[sprite_index].fearIncreaseRate),
+      fearDecreaseRate(store.detail[sprite_index].fearDecreaseRate),
+      is_heading_to_safe_zone(store.detail[sprite_index].is_heading_to_safe_zone),
+      currentPath(store.route[sprite_index].currentPath),
+      pathIsWaypoints(store.route[sprite_index].pathIsWaypoints),
+      pathFollowStep(store.route[sprite_index].pathFollowStep),
+      turnsSincePathReplan(store.route[sprite_index].turnsSincePathReplan),
+      pathWorldVersion(store.route[sprite_index].pathWorldVersion),
+      pathPlanner(store.route[sprite_index].pathPlanner),
+      pathSearch(store.route[sprite_index].pathSearch),
+      pendingPath(store.route[sprite_index].pendingPath),
+      recentWanderTrail(store.trail[sprite_index]),
+      displayChar(store.look[sprite_index].displayChar),
+      colorCode(store.look[sprite_index].colorCode) {}
+
+inline SpriteRef SpriteStore::operator[](size_t index) {
+    return SpriteRef(*this, index);
+}
+
+#endif // SPRITE_STORE_H
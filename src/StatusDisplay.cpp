@@ -12,8 +12,8 @@ namespace ColorExt {
 namespace StatusDisplay {
 
 void display_simulation_status(
-    const std::vector<Sprite>& predators,
-    const std::vector<Sprite>& prey_sprites,
+    const SpriteStore& predators,
+    const SpriteStore& prey_sprites,
     int current_step,
     int max_steps
 ) {
@@ -22,14 +22,14 @@ void display_simulation_status(
     
     // Calculate average fear and stamina
     float total_fear = 0.0f;
-    for (const auto& prey : prey_sprites) {
-        total_fear += prey.currentFear;
+    for (float fear : prey_sprites.fear) {
+        total_fear += fear;
     }
     float avg_fear = prey_sprites.empty() ? 0.0f : total_fear / prey_sprites.size();
 
     int total_stamina = 0;
-    for (const auto& predator : predators) {
-        total_stamina += predator.currentStamina;
+    for (int stamina : predators.stamina) {
+        total_stamina += stamina;
     }
     float avg_stamina = predators.empty() ? 0.0f : static_cast<float>(total_stamina) / predators.size();
 
@@ -44,16 +44,16 @@ void display_simulation_status(
     // Predator state counts
     int resting_count = 0;
     int stunned_count = 0;
-    for (const auto& predator : predators) {
-        if (predator.currentState == Sprite::AIState::RESTING) resting_count++;
-        if (predator.currentState == Sprite::AIState::STUNNED) stunned_count++;
+    for (Sprite::AIState state : predators.state) {
+        if (state == Sprite::AIState::RESTING) resting_count++;
+        if (state == Sprite::AIState::STUNNED) stunned_count++;
     }
     std::cout << "Predator States: Resting: " << resting_count 
               << ", Stunned: " << stunned_count << std::endl;
 }
 
 void display_predator_status(
-    const std::vector<Sprite>& predators
+    const SpriteStore& predators
 ) {
     // Predator colors for differentiation
     const std::string predator_colors[] = {
@@ -64,12 +64,11 @@ void display_predator_status(
     
     // Predator status line - limit to first 3 predators
     for (size_t i = 0; i < predators.size() && i < 3; ++i) {
-        const auto& p = predators[i];
         std::string pred_state_str;
         std::string color = (i < 3) ? predator_colors[i] : Color::RED;
         
         // Convert state enum to readable string for HUD
-        switch (p.currentState) {
+        switch (predators.state[i]) {
             case Sprite::AIState::SEEKING: pred_state_str = "SEEKING"; break;
             case Sprite::AIState::SEARCHING_LKP: pred_state_str = "SEARCH_LKP"; break;
             case Sprite::AIState::WANDERING: pred_state_str = "WANDERING"; break;
@@ -80,7 +79,7 @@ void display_predator_status(
         
         // Display predator info with color
         std::cout << color << "Predator " << (i+1) << ": "
-                  << "(" << p.position.x << "," << p.position.y << ") "
+                  << "(" << predators.position[i].x << "," << predators.position[i].y << ") "
                   << "[" << pred_state_str << "]" << Color::RESET;
         
         // Add separator between predators
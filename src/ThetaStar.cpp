@@ -0,0 +1,159 @@
+#include "Pathfinding.h"
+#include "PathSearchContext.h"
+
+#include <algorithm> // For std::reverse, std::max
+#include <cmath>     // For std::sqrt, std::lround
+#include <cstdlib>   // For std::abs
+#include <climits>   // For INT_MAX
+
+// Theta* (Nash, Daniel, Koenig & Felner): A* over the same eight neighbors, except that
+// a neighbor the expanded cell's parent can see gets that parent as its own parent.
+// Parents are then any earlier waypoint rather than an adjacent cell, and the path is
+// the waypoints alone, joined by lines has_line_of_sight found clear. Costs are
+// Euclidean, so paths are close to the shortest geometric route.
+//
+// This is the lazy variant: a neighbor takes over the parent without a line-of-sight
+// check, which is made once when the neighbor is expanded, rather than once per
+// neighbor generated. A node's parent can be any cell, which a Node's parent_dir and
+// parent_steps cannot name, so they hold an index into a per-thread list of cells instead.
+
+namespace {
+
+const int COST_SCALE = 100; // g and h in hundredths of a cell
+
+// Cells the calling thread's current search uses as parents; parent fields index into it
+thread_local std::vector<Vec2D> vertices;
+
+const uint32_t NO_VERTEX = (static_cast<uint32_t>(PathSearchContext::NO_PARENT) << 16); // touch()'s parent fields
+const uint32_t MAX_VERTICES = NO_VERTEX;
+
+uint32_t parent_vertex(const PathSearchContext::Node& node) {
+    return (static_cast<uint32_t>(node.parent_dir) << 16) | node.parent_steps;
+}
+
+void set_parent_vertex(PathSearchContext::Node& node, uint32_t vertex) {
+    node.parent_dir = static_cast<uint8_t>(vertex >> 16);
+    node.parent_steps = static_cast<uint16_t>(vertex & 0xFFFF);
+}
+
+int euclidean_cost(const Vec2D& a, const Vec2D& b) {
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    return static_cast<int>(std::lround(COST_SCALE * std::sqrt(dx * dx + dy * dy)));
+}
+
+} // namespace
+
+bool find_waypoints_theta(
+    const Vec2D& start,
+    const Vec2D& goal,
+    const World& world,
+    std::vector<Vec2D>& waypoints
+) {
+    waypoints.clear();
+    if (!world.is_reachable(start, goal)) {
+        return false;
+    }
+
+    PathSearchContext& search = PathSearchContext::for_this_thread();
+    search.begin(world);
+    vertices.clear();
+
+    PathSearchContext::Node& start_node = search.touch(start.x, start.y);
+    start_node.g = 0;
+    const int start_h = euclidean_cost(start, goal);
+    search.push_or_decrease(start, start_node, start_h, start_h);
+
+    while (!search.open_empty()) {
+        const Vec2D current = search.pop();
+        // Lazy Theta*: neighbors get the expanded cell's parent without a line-of-sight
+        // check (below); it is checked once here, and if the parent cannot see this cell
+        // after all, the best expanded neighbor becomes its parent instead
+        PathSearchContext::Node& current_node = search.touch(current.x, current.y);
+        const uint32_t assumed_parent = parent_vertex(current_node);
+        if (assumed_parent != NO_VERTEX &&
+            !PathfindingHelpers::has_line_of_sight(vertices[assumed_parent], current, world)) {
+            current_node.g = INT_MAX;
+            Vec2D best_neighbor = current;
+            for (uint8_t dir = 0; dir < 8; ++dir) {
+                const Vec2D neighbor_pos = {current.x + World::NEIGHBOR_OFFSETS[dir].x,
+                                            current.y + World::NEIGHBOR_OFFSETS[dir].y};
+                // Any closed neighbor was reached, a blocked start included; one left at
+                // INT_MAX had no parent either and was never expanded
+                const PathSearchContext::Node* neighbor = search.find(neighbor_pos.x, neighbor_pos.y);
+                if (neighbor && neighbor->closed && neighbor->g != INT_MAX &&
+                    neighbor->g + euclidean_cost(neighbor_pos, current) < current_node.g) {
+                    current_node.g = neighbor->g + euclidean_cost(neighbor_pos, current);
+                    best_neighbor = neighbor_pos;
+                }
+            }
+            if (best_neighbor == current) {
+                continue; // No reached neighbor: leave it unexpanded rather than its own parent
+            }
+            set_parent_vertex(current_node, static_cast<uint32_t>(vertices.size()));
+            vertices.push_back(best_neighbor);
+        }
+        if (current == goal) {
+            for (uint32_t vertex = parent_vertex(current_node); vertex != NO_VERTEX;) {
+                const Vec2D& cell = vertices[vertex];
+                waypoints.push_back(cell);
+                vertex = parent_vertex(search.touch(cell.x, cell.y));
+            }
+            std::reverse(waypoints.begin(), waypoints.end());
+            waypoints.push_back(goal);
+            if (!PathfindingHelpers::validate_waypoint_path(waypoints, world)) {
+                waypoints.clear();
+                return false;
+            }
+            return true;
+        }
+        if (vertices.size() + 2 >= MAX_VERTICES) {
+            return false; // Parent indices would run into NO_VERTEX
+        }
+
+        const uint32_t current_vertex = static_cast<uint32_t>(vertices.size());
+        vertices.push_back(current);
+        const int current_g = current_node.g;
+        const uint32_t parent = parent_vertex(current_node);
+        const Vec2D& parent_cell = parent != NO_VERTEX ? vertices[parent] : current;
+        const int parent_g = parent != NO_VERTEX ? search.touch(parent_cell.x, parent_cell.y).g : 0;
+
+        for (uint8_t dir = 0; dir < 8; ++dir) {
+            const Vec2D neighbor_pos = {current.x + World::NEIGHBOR_OFFSETS[dir].x,
+                                        current.y + World::NEIGHBOR_OFFSETS[dir].y};
+            if (!world.is_walkable(neighbor_pos)) {
+                continue;
+            }
+            PathSearchContext::Node& neighbor = search.touch(neighbor_pos.x, neighbor_pos.y);
+            if (neighbor.closed) {
+                continue;
+            }
+            // Straight from the current cell's parent (checked when the neighbor is expanded)
+            const uint32_t via = parent != NO_VERTEX ? parent : current_vertex;
+            const int tentative_g_cost = parent != NO_VERTEX ? parent_g + euclidean_cost(parent_cell, neighbor_pos)
+                                                             : current_g + euclidean_cost(current, neighbor_pos);
+            if (tentative_g_cost < neighbor.g) {
+                neighbor.g = tentative_g_cost;
+                set_parent_vertex(neighbor, via);
+                const int h_cost = euclidean_cost(neighbor_pos, goal);
+                search.push_or_decrease(neighbor_pos, neighbor, tentative_g_cost + h_cost, h_cost);
+            }
+        }
+    }
+    return false; // Goal not reachable
+}
+
+bool find_path_theta(
+    const Vec2D& start,
+    const Vec2D& goal,
+    const World& world,
+    std::vector<Vec2D>& path
+) {
+    thread_local std::vector<Vec2D> waypoints;
+    path.clear();
+    if (!find_waypoints_theta(start, goal, world, waypoints)) {
+        return false;
+    }
+    PathfindingHelpers::expand_waypoints(waypoints, path);
+    return true;
+}
@@ -0,0 +1,96 @@
+#include "ThreadPool.h"
+#include <atomic>
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        tasks.push_back(std::move(task));
+    }
+    task_available.notify_one();
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    idle.wait(lock, [this]() { return tasks.empty() && active_tasks == 0; });
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    std::atomic<size_t> next_index{0};
+    std::atomic<size_t> finished_helpers{0};
+    std::mutex done_mutex;
+    std::condition_variable done;
+
+    auto run_indices = [&]() {
+        for (size_t i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    // The calling thread works too, so only size() - 1 helpers are needed
+    const size_t helpers = std::min(workers.size(), count) - 1;
+    for (size_t h = 0; h < helpers; ++h) {
+        submit([&]() {
+            run_indices();
+            std::lock_guard<std::mutex> lock(done_mutex);
+            finished_helpers++;
+            done.notify_one();
+        });
+    }
+
+    run_indices();
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done.wait(lock, [&]() { return finished_helpers.load() == helpers; });
+}
+
+void ThreadPool::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            task_available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            active_tasks++;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            active_tasks--;
+            if (tasks.empty() && active_tasks == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+
+// Fixed-size pool of worker threads.
+// Tasks are run in submission order by whichever worker is free; parallel_for
+// splits an index range across the workers and the calling thread.
+class ThreadPool {
+public:
+    // thread_count == 0 uses std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of worker threads
+    size_t size() const { return workers.size(); }
+
+    // Queue a task for the workers
+    void submit(std::function<void()> task);
+
+    // Block until the queue is empty and no task is running
+    void wait_idle();
+
+    // Call fn(i) for every i in [0, count), blocking until all calls have returned.
+    // Indices are handed out dynamically, so fn must not depend on which thread runs it.
+    void parallel_for(size_t count, const std::function<void(size_t)>& fn);
+
+private:
+    void worker_loop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex queue_mutex;
+    std::condition_variable task_available;
+    std::condition_variable idle;
+    size_t active_tasks = 0;
+    bool stopping = false;
+};
+
+#endif // THREAD_POOL_H
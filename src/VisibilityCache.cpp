@@ -0,0 +1,168 @@
+#include "VisibilityCache.h"
+#include "World.h"
+
+#include <algorithm> // For std::min, std::max, std::fill
+#include <cstring>   // For std::memset
+
+namespace {
+
+// floor(a / b) for b > 0
+int floor_div(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Slope num / den (den > 0) of a shadow edge, as in Ford's algorithm
+struct Slope {
+    int num;
+    int den;
+};
+
+// One row of a quadrant scan: cells at distance depth from the origin between two slopes
+struct Row {
+    int depth;
+    Slope start;
+    Slope end;
+};
+
+// Slope through the left edge of the cell at (depth, col)
+Slope edge_slope(int depth, int col) {
+    return {2 * col - 1, 2 * depth};
+}
+
+} // namespace
+
+bool VisibilityCache::is_visible(const World& world, const Vec2D& from, const Vec2D& to) {
+    sync(world);
+    const int chunk = (from.y >> CHUNK_SHIFT) * chunks_x + (from.x >> CHUNK_SHIFT);
+    if (!pages[chunk]) {
+        pages[chunk].reset(new Page);
+        std::memset(pages[chunk]->built, 0, sizeof(pages[chunk]->built));
+    }
+    Page& page = *pages[chunk];
+    const int cell = ((from.y & CHUNK_MASK) << CHUNK_SHIFT) + (from.x & CHUNK_MASK);
+    uint64_t* mask = page.masks[cell];
+    if (!(page.built[cell >> 6] & (uint64_t{1} << (cell & 63)))) {
+        build_mask(world, from.x, from.y, mask);
+        page.built[cell >> 6] |= uint64_t{1} << (cell & 63);
+        built_cells++;
+    }
+    const int bit = (to.y - from.y + RADIUS) * SPAN + (to.x - from.x + RADIUS);
+    return (mask[bit >> 6] >> (bit & 63)) & 1u;
+}
+
+void VisibilityCache::clear() {
+    for (const std::unique_ptr<Page>& page : pages) {
+        if (page) {
+            std::memset(page->built, 0, sizeof(page->built));
+        }
+    }
+}
+
+size_t VisibilityCache::memory_bytes() const {
+    size_t bytes = pages.capacity() * sizeof(std::unique_ptr<Page>);
+    for (const std::unique_ptr<Page>& page : pages) {
+        if (page) {
+            bytes += sizeof(Page);
+        }
+    }
+    return bytes;
+}
+
+void VisibilityCache::sync(const World& world) {
+    if (synced_world == &world && synced_version == world.obstacle_version) {
+        return;
+    }
+    const int world_chunks_x = (world.width + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    const size_t chunk_count = static_cast<size_t>(world_chunks_x) * ((world.height + CHUNK_SIZE - 1) >> CHUNK_SHIFT);
+    const bool same_map = synced_world == &world && chunks_x == world_chunks_x && pages.size() == chunk_count;
+    // A changed cell can shadow (or stop shadowing) anything within RADIUS of it
+    if (!same_map || !world.for_each_change_since(synced_version, [&](const DirtyRegion& region) {
+            invalidate(region.min_x - RADIUS, region.min_y - RADIUS, region.max_x + RADIUS, region.max_y + RADIUS);
+        })) {
+        if (same_map) {
+            clear();
+        } else {
+            pages.clear();
+            pages.resize(chunk_count);
+            chunks_x = world_chunks_x;
+        }
+    }
+    synced_world = &world;
+    synced_version = world.obstacle_version;
+}
+
+void VisibilityCache::invalidate(int min_x, int min_y, int max_x, int max_y) {
+    const int chunks_y = static_cast<int>(pages.size()) / std::max(1, chunks_x);
+    min_x = std::max(0, min_x);
+    min_y = std::max(0, min_y);
+    max_x = std::min(chunks_x * CHUNK_SIZE - 1, max_x);
+    max_y = std::min(chunks_y * CHUNK_SIZE - 1, max_y);
+    for (int y = min_y; y <= max_y; ++y) {
+        for (int x = min_x; x <= max_x; ++x) {
+            Page* page = pages[(y >> CHUNK_SHIFT) * chunks_x + (x >> CHUNK_SHIFT)].get();
+            if (page) {
+                const int cell = ((y & CHUNK_MASK) << CHUNK_SHIFT) + (x & CHUNK_MASK);
+                page->built[cell >> 6] &= ~(uint64_t{1} << (cell & 63));
+            }
+        }
+    }
+}
+
+void VisibilityCache::build_mask(const World& world, int origin_x, int origin_y, uint64_t* mask) {
+    std::fill(mask, mask + WORDS, uint64_t{0});
+    if (!world.is_walkable(origin_y, origin_x)) {
+        return; // Nothing is visible from inside a wall
+    }
+    auto reveal = [&](int x, int y) {
+        const int bit = (y - origin_y + RADIUS) * SPAN + (x - origin_x + RADIUS);
+        mask[bit >> 6] |= uint64_t{1} << (bit & 63);
+    };
+    reveal(origin_x, origin_y);
+
+    // Rows still to scan; each quadrant starts with the full 90-degree row at depth 1
+    Row rows[RADIUS * SPAN + 1];
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        // Map (depth, col) in this quadrant to a cell: north, south, east, west
+        auto cell_at = [&](int depth, int col) -> Vec2D {
+            switch (quadrant) {
+                case 0: return {origin_x + col, origin_y - depth};
+                case 1: return {origin_x + col, origin_y + depth};
+                case 2: return {origin_x + depth, origin_y + col};
+                default: return {origin_x - depth, origin_y + col};
+            }
+        };
+
+        int row_count = 0;
+        rows[row_count++] = {1, {-1, 1}, {1, 1}};
+        while (row_count > 0) {
+            Row row = rows[--row_count];
+            if (row.depth > RADIUS) {
+                continue;
+            }
+            // Columns from round-half-up(depth * start) to round-half-down(depth * end)
+            const int min_col = floor_div(2 * row.depth * row.start.num + row.start.den, 2 * row.start.den);
+            const int max_col = -floor_div(-(2 * row.depth * row.end.num - row.end.den), 2 * row.end.den);
+            int previous = -1; // -1 none yet, 0 floor, 1 wall
+            for (int col = min_col; col <= max_col; ++col) {
+                const Vec2D cell = cell_at(row.depth, col);
+                const bool wall = !world.is_walkable(cell);
+                // Floor is only lit if its center lies inside the visible wedge (keeps sight
+                // symmetric); walls still shadow the row behind them but are never lit
+                if (!wall && col * row.start.den >= row.depth * row.start.num &&
+                    col * row.end.den <= row.depth * row.end.num) {
+                    reveal(cell.x, cell.y);
+                }
+                if (previous == 1 && !wall) {
+                    row.start = edge_slope(row.depth, col);
+                }
+                if (previous == 0 && wall) {
+                    rows[row_count++] = {row.depth + 1, row.start, edge_slope(row.depth, col)};
+                }
+                previous = wall ? 1 : 0;
+            }
+            if (previous == 0) {
+                rows[row_count++] = {row.depth + 1, row.start, row.end};
+            }
+        }
+    }
+}
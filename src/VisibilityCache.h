@@ -0,0 +1,66 @@
+#ifndef VISIBILITY_CACHE_H
+#define VISIBILITY_CACHE_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "Vec2D.h"
+#include "ChunkedGrid.h"
+
+struct World;
+
+// Field of view of every cell out to RADIUS (Chebyshev), as one bitmask per cell over
+// the (2 * RADIUS + 1)^2 square around it, computed with symmetric shadowcasting
+// (Albert Ford's variant): a floor cell sees another exactly when that one sees it
+// back. Walls and the map edge cast shadows, and only floor cells are ever visible,
+// so a set bit means both ends are walkable.
+//
+// Masks live in pages of one chunk each and are built on first query, one cell at a
+// time. The cache remembers the world's obstacle_version and, when it changes,
+// forgets only the masks of cells within RADIUS of the logged dirty regions (all of
+// them if the log no longer reaches back that far). Queries fill the cache, so only
+// one thread may use it.
+struct VisibilityCache {
+    static constexpr int RADIUS = 7; // Covers PREY_AWARENESS_RADIUS plus one flee step
+    static constexpr int SPAN = 2 * RADIUS + 1;
+    static constexpr int WORDS = (SPAN * SPAN + 63) / 64; // Mask words per cell
+
+    // True if to lies within RADIUS of from on both axes
+    static bool in_range(const Vec2D& from, const Vec2D& to) {
+        const int dx = to.x - from.x;
+        const int dy = to.y - from.y;
+        return dx >= -RADIUS && dx <= RADIUS && dy >= -RADIUS && dy <= RADIUS;
+    }
+
+    // True if to is visible from from (caller guarantees from is in bounds and to in range);
+    // false if either cell is a wall
+    bool is_visible(const World& world, const Vec2D& from, const Vec2D& to);
+
+    // Drop every mask (pages are kept for reuse)
+    void clear();
+
+    size_t built_count() const { return built_cells; }
+    size_t memory_bytes() const;
+
+private:
+    struct Page {
+        uint64_t built[CHUNK_CELLS / 64];   // Bit set = the cell's mask is current
+        uint64_t masks[CHUNK_CELLS][WORDS]; // Bit (dy + RADIUS) * SPAN + dx + RADIUS
+    };
+
+    // Catch up with obstacle edits made since the cache last looked at world
+    void sync(const World& world);
+    // Forget the masks of cells in the box (clamped to the map)
+    void invalidate(int min_x, int min_y, int max_x, int max_y);
+    // Shadowcast from (x, y) into mask
+    static void build_mask(const World& world, int x, int y, uint64_t* mask);
+
+    std::vector<std::unique_ptr<Page>> pages; // Per chunk, null until a cell in it is queried
+    int chunks_x = 0;
+    const World* synced_world = nullptr;
+    uint64_t synced_version = 0;
+    size_t built_cells = 0; // Masks built since the cache was created
+};
+
+#endif // VISIBILITY_CACHE_H
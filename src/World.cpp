@@ -1,5 +1,6 @@
 #include "World.h"
 #include "Pathfinding.h" // Include for manhattan_distance
+#include "ThreadPool.h"
 #include <random>
 #include <ctime>
 #include <iostream>
@@ -7,14 +8,19 @@
 #include <functional>
 #include <cmath> // For std::abs
 
-// For random number generation (needs to be accessible or passed in)
-// Option 1: Redeclare static generator here (simplest for now, but not ideal)
-// Option 2: Pass generator by reference to initialize_obstacles
-// Option 3: Make World responsible for its own generator
-// Let's go with Option 1 for now to keep changes minimal, but note this isn't best practice.
-static std::random_device rd_world; // Avoid name clash with main.cpp's static rd
-static std::mt19937 gen_world(rd_world());
-static std::uniform_real_distribution<float> dist(0.0f, 1.0f); // Define dist
+// Random numbers for world generation come from one generator per tile, seeded from the
+// world seed and the tile coordinates. The output therefore does not depend on which
+// thread generates a tile or in what order tiles are processed.
+static std::mt19937 make_tile_generator(uint32_t seed, int tile_x, int tile_y) {
+    std::seed_seq sequence{seed, static_cast<uint32_t>(tile_x), static_cast<uint32_t>(tile_y)};
+    return std::mt19937(sequence);
+}
+
+// Uniform float in [0, 1) built from the top 24 bits, so it is identical on every
+// standard library (std::uniform_real_distribution is implementation-defined)
+static float unit_float(std::mt19937& generator) {
+    return static_cast<float>(generator() >> 8) * (1.0f / 16777216.0f);
+}
 
 // Helper function for Manhattan distance - REMOVED, now in Pathfinding.h/.cpp
 
@@ -26,38 +32,93 @@ World::World() {
     // initialize_obstacles(); // Called by user (main.cpp) after world creation
 }
 
-void World::initialize_obstacles() {
-    obstacles.clear();
+World::World(int world_width, int world_height)
+    : width(std::max(DEFAULT_WIDTH, std::min(world_width, MAX_DIMENSION))),
+      height(std::max(DEFAULT_HEIGHT, std::min(world_height, MAX_DIMENSION))) {
+    // Dimensions are clamped: sprite spawn points and safe zones assume at least the default size
+}
+
+void World::initialize_obstacles(uint32_t seed, unsigned thread_count) {
+    ThreadPool pool(thread_count);
+    generation_seed = seed;
+
+    // A new map invalidates everything derived from the old one, logged or not
+    obstacle_version++;
+    dirty_log_start = obstacle_version;
+    dirty_regions.clear();
+    grid.resize(width, height);
     safe_zone_centers.clear(); // Clear previous safe zones
 
     // Create border walls
     for (int r = 0; r < height; ++r) {
-        obstacles.insert({0, r});            // Left wall
-        obstacles.insert({width - 1, r});    // Right wall
+        grid.set(0, r, true);            // Left wall
+        grid.set(width - 1, r, true);    // Right wall
     }
     for (int c = 0; c < width; ++c) {
-        obstacles.insert({c, 0});            // Top wall
-        obstacles.insert({c, height - 1});   // Bottom wall
+        grid.set(c, 0, true);            // Top wall
+        grid.set(c, height - 1, true);   // Bottom wall
     }
     
     // Add some random obstacles, but with less density to allow better navigation
-    float obstacle_probability = 0.06f;  // Reduced from typical 0.1-0.2 to make more open space
+    const float obstacle_probability = 0.06f;  // Reduced from typical 0.1-0.2 to make more open space
     
-    for (int y = 2; y < height - 2; ++y) {
-        for (int x = 2; x < width - 2; ++x) {
-            if (dist(gen_world) < obstacle_probability) {
-                obstacles.insert({x, y});
-                
-                // Only extend obstacles occasionally, creating smaller clusters
-                if (dist(gen_world) < 0.4f && x + 1 < width - 2) { 
-                    obstacles.insert({x + 1, y}); 
-                }
-                if (dist(gen_world) < 0.4f && y + 1 < height - 2) { 
-                    obstacles.insert({x, y + 1}); 
+    // Each chunk is a generation tile. Tiles write into private row words, and cluster
+    // extensions that cross into the next tile are spilled and OR-ed in afterwards,
+    // so tiles never touch shared storage while running in parallel.
+    struct TileOutput {
+        uint64_t rows[CHUNK_SIZE] = {};
+        std::vector<Vec2D> spill;
+    };
+    std::vector<TileOutput> tiles(grid.chunk_count());
+
+    pool.parallel_for(tiles.size(), [&](size_t tile_index) {
+        const int cx = static_cast<int>(tile_index) % grid.chunks_x;
+        const int cy = static_cast<int>(tile_index) / grid.chunks_x;
+        const int x_base = cx * CHUNK_SIZE;
+        const int y_base = cy * CHUNK_SIZE;
+        const int y_begin = std::max(2, y_base);
+        const int y_end = std::min(height - 2, y_base + CHUNK_SIZE);
+        const int x_begin = std::max(2, x_base);
+        const int x_end = std::min(width - 2, x_base + CHUNK_SIZE);
+
+        TileOutput& tile = tiles[tile_index];
+        std::mt19937 tile_gen = make_tile_generator(seed, cx, cy);
+        auto place = [&](int x, int y) {
+            if (x < x_base + CHUNK_SIZE && y < y_base + CHUNK_SIZE) {
+                tile.rows[y - y_base] |= uint64_t{1} << (x - x_base);
+            } else {
+                tile.spill.push_back({x, y});
+            }
+        };
+
+        for (int y = y_begin; y < y_end; ++y) {
+            for (int x = x_begin; x < x_end; ++x) {
+                if (unit_float(tile_gen) < obstacle_probability) {
+                    place(x, y);
+                    
+                    // Only extend obstacles occasionally, creating smaller clusters
+                    if (unit_float(tile_gen) < 0.4f && x + 1 < width - 2) { 
+                        place(x + 1, y); 
+                    }
+                    if (unit_float(tile_gen) < 0.4f && y + 1 < height - 2) { 
+                        place(x, y + 1); 
+                    }
                 }
             }
         }
+    });
+
+    // Merge tiles in chunk order (OR is order independent, so this is deterministic)
+    for (size_t tile_index = 0; tile_index < tiles.size(); ++tile_index) {
+        grid.merge_chunk_rows(static_cast<int>(tile_index), tiles[tile_index].rows);
+    }
+    for (const auto& tile : tiles) {
+        for (const auto& pos : tile.spill) {
+            grid.set(pos.x, pos.y, true);
+        }
     }
+    tiles.clear();
+    tiles.shrink_to_fit();
     
     // Ensure starting areas are clear (no obstacles in corners)
     const int clear_radius = 5;
@@ -65,14 +126,14 @@ void World::initialize_obstacles() {
     // Clear top-left corner
     for (int y = 1; y < clear_radius; ++y) {
         for (int x = 1; x < clear_radius; ++x) {
-            obstacles.erase({x, y});
+            grid.set(x, y, false);
         }
     }
     
     // Clear bottom-right corner
     for (int y = height - clear_radius; y < height - 1; ++y) {
         for (int x = width - clear_radius; x < width - 1; ++x) {
-            obstacles.erase({x, y});
+            grid.set(x, y, false);
         }
     }
     
@@ -84,13 +145,13 @@ void World::initialize_obstacles() {
     for (int y = center_y - center_radius; y <= center_y + center_radius; ++y) {
         for (int x = center_x - center_radius; x <= center_x + center_radius; ++x) {
             if (x > 0 && x < width - 1 && y > 0 && y < height - 1) {
-                obstacles.erase({x, y});
+                grid.set(x, y, false);
             }
         }
     }
     
     // Remove obvious dead ends and isolated obstacles
-    clean_up_obstacles();
+    clean_up_obstacles(pool);
 
     // Initialize a few safe zones (example locations)
     // Ensure these are walkable initially, though they might overlap with random obstacles later.
@@ -101,66 +162,108 @@ void World::initialize_obstacles() {
 
     // Optional: Remove any obstacles that fall within the immediate center of a safe zone
     for(const auto& center : safe_zone_centers){
-        obstacles.erase(center);
+        grid.set(center.x, center.y, false);
     }
-}
 
-bool World::is_walkable(int r, int c) const {
-    if (r < 0 || r >= height || c < 0 || c >= width) {
-        return false;
+    // Chunks emptied by the clearing passes above no longer need storage
+    grid.release_empty_chunks();
+
+    components.build(grid, pool);
+    if (path_hierarchy.built) {
+        path_hierarchy.build(grid, pool);
     }
-    return obstacles.count({c, r}) == 0;
-}
 
-// Overload for convenience
-bool World::is_walkable(const Vec2D& pos) const {
-    return is_walkable(pos.y, pos.x);
+    build_safe_zone_fields();
+
+    // Every grid now lives in owned memory, so a previously loaded file can be unmapped
+    mapped_file.reset();
 }
 
 // Helper function to clean up obstacles
-void World::clean_up_obstacles() {
-    std::vector<Vec2D> to_remove;
+// Both passes only visit allocated chunks (plus a one-cell margin for dead ends),
+// so the cost scales with populated chunks rather than with the map area.
+// Each pass decides every removal from the same snapshot of the grid, so the
+// chunks are scanned in parallel and the removals are applied afterwards.
+void World::clean_up_obstacles(ThreadPool& pool) {
+    std::vector<int> populated_chunks;
+    for (int chunk = 0; chunk < static_cast<int>(grid.chunk_count()); ++chunk) {
+        if (grid.is_chunk_allocated(chunk)) {
+            populated_chunks.push_back(chunk);
+        }
+    }
+    std::vector<std::vector<Vec2D>> to_remove(populated_chunks.size());
+    auto apply_removals = [&]() {
+        for (auto& chunk_removals : to_remove) {
+            for (const auto& pos : chunk_removals) {
+                grid.set(pos.x, pos.y, false);
+            }
+            chunk_removals.clear();
+        }
+    };
     
     // Find isolated obstacles (ones surrounded by 6+ empty cells)
-    for (const auto& obs : obstacles) {
-        if (obs.x <= 0 || obs.x >= width - 1 || obs.y <= 0 || obs.y >= height - 1) {
-            continue; // Skip border walls
-        }
-        
-        int empty_neighbors = 0;
-        for (int dy = -1; dy <= 1; ++dy) {
-            for (int dx = -1; dx <= 1; ++dx) {
-                if (dx == 0 && dy == 0) continue;
+    pool.parallel_for(populated_chunks.size(), [&](size_t i) {
+        const int chunk = populated_chunks[i];
+        const int x_base = (chunk % grid.chunks_x) * CHUNK_SIZE;
+        const int y_base = (chunk / grid.chunks_x) * CHUNK_SIZE;
+
+        for (int row = 0; row < CHUNK_SIZE; ++row) {
+            uint64_t bits = grid.chunk_row(chunk, row);
+            while (bits) {
+                const int x = x_base + lowest_set_bit(bits);
+                const int y = y_base + row;
+                bits &= bits - 1;
+
+                if (x <= 0 || x >= width - 1 || y <= 0 || y >= height - 1) {
+                    continue; // Skip border walls
+                }
+
+                int empty_neighbors = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (dx == 0 && dy == 0) continue;
+                        
+                        if (!grid.is_set(x + dx, y + dy)) {
+                            empty_neighbors++;
+                        }
+                    }
+                }
                 
-                Vec2D neighbor = {obs.x + dx, obs.y + dy};
-                if (obstacles.count(neighbor) == 0) {
-                    empty_neighbors++;
+                if (empty_neighbors >= 6) {
+                    to_remove[i].push_back({x, y});
                 }
             }
         }
-        
-        if (empty_neighbors >= 6) {
-            to_remove.push_back(obs);
-        }
-    }
+    });
     
     // Remove isolated obstacles
-    for (const auto& pos : to_remove) {
-        obstacles.erase(pos);
-    }
+    apply_removals();
     
     // Find dead ends (cells with 3+ adjacent obstacles)
-    to_remove.clear();
-    for (int y = 1; y < height - 1; ++y) {
-        for (int x = 1; x < width - 1; ++x) {
-            if (obstacles.count({x, y}) == 0) {
+    // A dead end always touches an obstacle, so only cells in or next to an allocated chunk qualify
+    pool.parallel_for(populated_chunks.size(), [&](size_t i) {
+        const int chunk = populated_chunks[i];
+        const int cx = chunk % grid.chunks_x;
+        const int cy = chunk / grid.chunks_x;
+        const int y_begin = std::max(1, cy * CHUNK_SIZE - 1);
+        const int y_end = std::min(height - 1, (cy + 1) * CHUNK_SIZE + 1);
+        const int x_begin = std::max(1, cx * CHUNK_SIZE - 1);
+        const int x_end = std::min(width - 1, (cx + 1) * CHUNK_SIZE + 1);
+
+        for (int y = y_begin; y < y_end; ++y) {
+            for (int x = x_begin; x < x_end; ++x) {
+                // Margin cells inside another allocated chunk are handled by that chunk
+                const int cell_chunk = grid.chunk_index(x, y);
+                if (cell_chunk != chunk && grid.is_chunk_allocated(cell_chunk)) continue;
+                if (grid.is_set(x, y)) continue;
+
                 // Count obstacles around this open cell
                 int adjacent_obstacles = 0;
                 for (int dy = -1; dy <= 1; ++dy) {
                     for (int dx = -1; dx <= 1; ++dx) {
                         if (dx == 0 && dy == 0) continue;
                         
-                        if (obstacles.count({x + dx, y + dy}) > 0) {
+                        if (grid.is_set(x + dx, y + dy)) {
                             adjacent_obstacles++;
                         }
                     }
@@ -172,38 +275,251 @@ void World::clean_up_obstacles() {
                     int dx_dirs[] = {1, 0, -1, 0};
                     int dy_dirs[] = {0, 1, 0, -1};
                     
-                    for (int i = 0; i < 4; ++i) {
-                        Vec2D neighbor = {x + dx_dirs[i], y + dy_dirs[i]};
-                        if (obstacles.count(neighbor) > 0 &&
+                    for (int d = 0; d < 4; ++d) {
+                        Vec2D neighbor = {x + dx_dirs[d], y + dy_dirs[d]};
+                        if (grid.is_set(neighbor.x, neighbor.y) &&
                             neighbor.x > 0 && neighbor.x < width - 1 && 
                             neighbor.y > 0 && neighbor.y < height - 1) {
-                            to_remove.push_back(neighbor);
+                            to_remove[i].push_back(neighbor);
                             break;
                         }
                     }
                 }
             }
         }
-    }
+    });
     
     // Remove obstacles creating dead ends
-    for (const auto& pos : to_remove) {
-        obstacles.erase(pos);
+    apply_removals();
+}
+
+void World::build_path_hierarchy(unsigned thread_count) {
+    ThreadPool pool(thread_count);
+    path_hierarchy.build(grid, pool);
+}
+
+void World::set_obstacles(const std::vector<Vec2D>& cells, bool blocked) {
+    // Apply the changes and collect one bounding box per touched chunk
+    std::vector<DirtyRegion> regions;
+    std::vector<int> region_chunks;
+    for (const auto& cell : cells) {
+        if (!grid.in_bounds(cell.x, cell.y) || grid.is_set(cell.x, cell.y) == blocked) {
+            continue;
+        }
+        grid.set(cell.x, cell.y, blocked);
+
+        const int chunk = grid.chunk_index(cell.x, cell.y);
+        auto found = std::find(region_chunks.begin(), region_chunks.end(), chunk);
+        if (found == region_chunks.end()) {
+            region_chunks.push_back(chunk);
+            regions.push_back({cell.x, cell.y, cell.x, cell.y, 0, blocked});
+        } else {
+            DirtyRegion& region = regions[found - region_chunks.begin()];
+            region.min_x = std::min(region.min_x, cell.x);
+            region.min_y = std::min(region.min_y, cell.y);
+            region.max_x = std::max(region.max_x, cell.x);
+            region.max_y = std::max(region.max_y, cell.y);
+        }
+    }
+    if (regions.empty()) {
+        return;
+    }
+
+    obstacle_version++;
+    for (auto& region : regions) {
+        region.version = obstacle_version;
+        dirty_regions.push_back(region);
+    }
+    while (dirty_regions.size() > MAX_DIRTY_REGIONS) {
+        dirty_log_start = dirty_regions.front().version; // That version is now only partly logged
+        dirty_regions.pop_front();
+    }
+
+    components.update_chunks(grid, region_chunks);
+    if (path_hierarchy.built) {
+        path_hierarchy.update_chunks(grid, region_chunks);
     }
+
+    // The BFS field never leaves the square of safe_zone_field_range steps around a
+    // center, so changes outside every such square cannot affect it
+    const int reach = safe_zone_field_range;
+    bool field_touched = false;
+    for (const auto& center : safe_zone_centers) {
+        for (const auto& region : regions) {
+            field_touched = field_touched ||
+                            region.intersects(center.x - reach, center.y - reach, center.x + reach, center.y + reach);
+        }
+    }
+    if (field_touched) {
+        build_safe_zone_fields();
+    }
+}
+
+bool World::is_path_blocked_since(const std::vector<Vec2D>& path, size_t first, uint64_t since_version) const {
+    if (first >= path.size()) {
+        return false;
+    }
+    // Only steps inside a region where obstacles were placed need the grid lookup;
+    // cleared cells never make an existing path invalid
+    bool blocked = false;
+    const bool complete = for_each_change_since(since_version, [&](const DirtyRegion& region) {
+        if (!region.blocked || blocked) {
+            return;
+        }
+        for (size_t i = first; i < path.size() && !blocked; ++i) {
+            blocked = region.contains(path[i]) && !is_walkable(path[i]);
+        }
+    });
+    if (!complete) {
+        // The log was trimmed: check the remaining steps directly
+        for (size_t i = first; i < path.size(); ++i) {
+            if (!is_walkable(path[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return blocked;
+}
+
+bool World::is_reachable(const Vec2D& from, const Vec2D& to) const {
+    if (from == to) {
+        return true;
+    }
+    if (!is_walkable(to)) {
+        return false;
+    }
+    const uint32_t goal_component = components.component_at(to.x, to.y);
+    if (is_walkable(from)) {
+        return components.component_at(from.x, from.y) == goal_component;
+    }
+    // A search from a blocked cell still expands its walkable neighbors
+    for (const auto& offset : NEIGHBOR_OFFSETS) {
+        const Vec2D neighbor = {from.x + offset.x, from.y + offset.y};
+        if (is_walkable(neighbor) && components.component_at(neighbor.x, neighbor.y) == goal_component) {
+            return true;
+        }
+    }
+    return false;
 }
 
 const std::vector<Vec2D>& World::get_safe_zone_centers() const {
     return safe_zone_centers;
 }
 
-bool World::is_in_safe_zone(const Vec2D& pos) const {
+void World::build_safe_zone_fields() {
+    safe_zone_mask.resize(width, height);
+    safe_zone_distance.resize(width, height, SAFE_ZONE_UNREACHED);
+    safe_zone_next_step.resize(width, height, NO_STEP);
+
+    // Zone membership: Manhattan distance to a center, for a square-ish zone
     for (const auto& center : safe_zone_centers) {
-        // Using Manhattan distance for simplicity to define a square-ish zone
-        if (manhattan_distance(pos, center) <= safe_zone_radius) {
-            return true;
+        for (int dy = -safe_zone_radius; dy <= safe_zone_radius; ++dy) {
+            for (int dx = -safe_zone_radius; dx <= safe_zone_radius; ++dx) {
+                if (std::abs(dx) + std::abs(dy) <= safe_zone_radius) {
+                    safe_zone_mask.set(center.x + dx, center.y + dy, true);
+                }
+            }
         }
     }
-    return false;
+
+    // Multi-source BFS from every walkable zone center, limited to safe_zone_field_range steps.
+    // Each reached cell remembers the direction of its BFS parent, so routes are read back
+    // by following next steps until the distance reaches zero.
+    // Stepping from a neighbor back to current is the opposite offset (pairs are 0/1, 2/3, 4/7, 5/6)
+    static const uint8_t opposite[8] = {1, 0, 3, 2, 7, 6, 5, 4};
+    std::vector<Vec2D> frontier;
+    for (const auto& center : safe_zone_centers) {
+        if (is_walkable(center) && safe_zone_distance.get(center.x, center.y) == SAFE_ZONE_UNREACHED) {
+            safe_zone_distance.set(center.x, center.y, 0);
+            frontier.push_back(center);
+        }
+    }
+
+    for (size_t head = 0; head < frontier.size(); ++head) {
+        const Vec2D current = frontier[head];
+        const uint16_t current_distance = safe_zone_distance.get(current.x, current.y);
+        if (current_distance >= safe_zone_field_range) {
+            continue;
+        }
+
+        for (uint8_t dir = 0; dir < 8; ++dir) {
+            const Vec2D neighbor = {current.x + NEIGHBOR_OFFSETS[dir].x, current.y + NEIGHBOR_OFFSETS[dir].y};
+            if (!is_walkable(neighbor) ||
+                safe_zone_distance.get(neighbor.x, neighbor.y) != SAFE_ZONE_UNREACHED) {
+                continue;
+            }
+            safe_zone_distance.set(neighbor.x, neighbor.y, static_cast<uint16_t>(current_distance + 1));
+            safe_zone_next_step.set(neighbor.x, neighbor.y, opposite[dir]);
+            frontier.push_back(neighbor);
+        }
+    }
+}
+
+int World::get_safe_zone_distance(const Vec2D& pos) const {
+    if (!safe_zone_distance.in_bounds(pos.x, pos.y)) {
+        return -1;
+    }
+    const uint16_t distance = safe_zone_distance.get(pos.x, pos.y);
+    return distance == SAFE_ZONE_UNREACHED ? -1 : distance;
+}
+
+bool World::get_route_to_safe_zone(const Vec2D& start, std::vector<Vec2D>& route) const {
+    route.clear();
+    int remaining = get_safe_zone_distance(start);
+    if (remaining < 0) {
+        return false;
+    }
+
+    route.reserve(static_cast<size_t>(remaining) + 1);
+    Vec2D current = start;
+    route.push_back(current);
+    while (remaining-- > 0) {
+        const uint8_t dir = safe_zone_next_step.get(current.x, current.y);
+        if (dir >= 8) {
+            route.clear(); // Field and distances disagree (a damaged world file)
+            return false;
+        }
+        current = {current.x + NEIGHBOR_OFFSETS[dir].x, current.y + NEIGHBOR_OFFSETS[dir].y};
+        if (!safe_zone_next_step.in_bounds(current.x, current.y)) {
+            route.clear();
+            return false;
+        }
+        route.push_back(current);
+    }
+    return true;
+}
+
+void World::print_memory_report(std::ostream& out) const {
+    const size_t total_chunks = grid.chunk_count();
+    const size_t allocated_chunks = grid.allocated_chunk_count();
+    const size_t dense_bytes = (static_cast<size_t>(width) * height + 7) / 8;
+
+    out << "World " << width << "x" << height << " memory report" << std::endl;
+    if (mapped_file) {
+        out << "  Storage:          memory-mapped from world file (chunks are paged in on first touch)" << std::endl;
+    }
+    out << "  Chunk size:       " << CHUNK_SIZE << "x" << CHUNK_SIZE << " cells, "
+        << ChunkedBitGrid::bytes_per_chunk() << " bytes per chunk" << std::endl;
+    out << "  Chunks allocated: " << allocated_chunks << " / " << total_chunks << std::endl;
+    out << "  Chunk table:      " << total_chunks * sizeof(int32_t) << " bytes" << std::endl;
+    out << "  Obstacle storage: " << grid.memory_bytes() << " bytes"
+        << " (dense bit grid would need " << dense_bytes << " bytes)" << std::endl;
+    out << "  Safe zone mask:   " << safe_zone_mask.allocated_chunk_count() << " chunks, "
+        << safe_zone_mask.memory_bytes() << " bytes" << std::endl;
+    out << "  Safe zone field:  " << safe_zone_distance.allocated_chunk_count() << " chunks x "
+        << (ChunkedField<uint16_t>::bytes_per_chunk() + ChunkedField<uint8_t>::bytes_per_chunk())
+        << " bytes per chunk, "
+        << safe_zone_distance.memory_bytes() + safe_zone_next_step.memory_bytes() << " bytes" << std::endl;
+    out << "  Components:       " << components.component_count << " (" << components.node_component.size()
+        << " chunk-local, " << components.local_labels.allocated_chunk_count() << " chunks with labels), "
+        << components.memory_bytes() << " bytes" << std::endl;
+    if (path_hierarchy.built) {
+        out << "  Path hierarchy:   " << path_hierarchy.node_count() << " entrances in "
+            << path_hierarchy.clusters.size() << " clusters, " << path_hierarchy.memory_bytes() << " bytes" << std::endl;
+    }
+    out << "  Visibility cache: " << visibility.built_count() << " masks built, "
+        << visibility.memory_bytes() << " bytes" << std::endl;
 }
 
 // Private helper to add random obstacles
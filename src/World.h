@@ -3,42 +3,184 @@
 
 #include <vector>
 #include <string>
-#include <unordered_set>
+#include <iosfwd>
+#include <memory>
+#include <deque>
+#include <cstdint>
 #include "Vec2D.h"      // For Vec2D struct
 #include "Sprite.h" // Include Sprite.h for Color namespace
+#include "ChunkedGrid.h" // Sparse chunked bit grid for obstacles
+#include "ComponentIndex.h" // Connected components of the walkable cells
+#include "PathHierarchy.h" // Cluster graph for hierarchical pathfinding
+#include "VisibilityCache.h" // Per-cell field-of-view masks for short sight checks
+
+class ThreadPool;
+class MappedFile;
+
+// Bounding box of cells whose obstacles changed in one edit, stamped with the
+// world version that edit produced
+struct DirtyRegion {
+    int min_x = 0;
+    int min_y = 0;
+    int max_x = 0;
+    int max_y = 0;
+    uint64_t version = 0;
+    bool blocked = false; // True if the cells became obstacles, false if they were cleared
+
+    bool contains(const Vec2D& pos) const {
+        return pos.x >= min_x && pos.x <= max_x && pos.y >= min_y && pos.y <= max_y;
+    }
+    bool intersects(int other_min_x, int other_min_y, int other_max_x, int other_max_y) const {
+        return min_x <= other_max_x && other_min_x <= max_x && min_y <= other_max_y && other_min_y <= max_y;
+    }
+};
 
 struct World {
+    // Default and limit dimensions for runtime-sized worlds
+    static constexpr int DEFAULT_WIDTH = 60;  // Reduced from 80 for better console rendering
+    static constexpr int DEFAULT_HEIGHT = 20; // Kept the same height
+    static constexpr int MAX_DIMENSION = 16384; // Largest supported side length (16k x 16k)
+
+    // Dimensions (set at construction, clamped to [DEFAULT, MAX_DIMENSION])
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+
     // Constants
-    const int width = 60;  // Reduced from 80 for better console rendering
-    const int height = 20; // Kept the same height
     const char obstacleChar = '#';
     const std::string obstacleColor = Color::WHITE;
     const char safeZoneChar = '~'; // Character for safe zone tiles
     const std::string safeZoneColor = Color::GREEN; // Color for safe zone tiles
 
+    // 8-connected step offsets shared by the BFS fields (same order as find_path)
+    static constexpr Vec2D NEIGHBOR_OFFSETS[8] = {
+        {0, 1}, {0, -1}, {1, 0}, {-1, 0},  // Cardinal directions
+        {1, 1}, {1, -1}, {-1, 1}, {-1, -1} // Diagonal directions
+    };
+    static constexpr uint16_t SAFE_ZONE_UNREACHED = 0xFFFF; // Distance of cells outside the field
+    static constexpr uint8_t NO_STEP = 0xFF;                // Next step of zone centers and unreached cells
+
     // Data
-    std::unordered_set<Vec2D> obstacles;
+    ChunkedBitGrid grid; // Obstacle bits, chunks are only allocated where obstacles exist
     std::vector<Vec2D> safe_zone_centers; // Added for safe zones
     const int safe_zone_radius = 2;      // Added for safe zones
+    const int safe_zone_field_range = 32; // BFS steps covered by the safe-zone distance field
+    uint32_t generation_seed = 0;         // Seed passed to the last initialize_obstacles() call
+
+    // Derived safe-zone data, rebuilt by build_safe_zone_fields()
+    ChunkedBitGrid safe_zone_mask;                  // Bit set = cell lies inside some safe zone
+    ChunkedField<uint16_t> safe_zone_distance;      // Walking steps to the nearest reachable zone center
+    ChunkedField<uint8_t> safe_zone_next_step;      // Index into NEIGHBOR_OFFSETS toward that center
+
+    // Connected components of the walkable cells, kept in sync by set_obstacles()
+    ComponentIndex components;
+
+    // HPA* cluster graph; empty until build_path_hierarchy(), then kept in sync by
+    // set_obstacles() and rebuilt by initialize_obstacles() / load_from_file()
+    PathHierarchy path_hierarchy;
+
+    // Field of view of each cell out to VisibilityCache::RADIUS, built on first query and
+    // forgotten around obstacle edits (see PathfindingHelpers::can_see). Filled by const
+    // queries, so it is mutable and may only be used from the simulation thread.
+    mutable VisibilityCache visibility;
+
+    // Obstacle edits made after generation. Every set_obstacles() call bumps the version
+    // and logs one region per touched chunk; consumers remember the version they last
+    // saw and only invalidate what the newer regions overlap.
+    static constexpr size_t MAX_DIRTY_REGIONS = 1024; // Older regions are dropped from the log
+    uint64_t obstacle_version = 0;
+    uint64_t dirty_log_start = 0;          // Every change after this version is still in the log
+    std::deque<DirtyRegion> dirty_regions; // Oldest first
 
-    // Constructor to initialize obstacles
+    // World file the grids above point into after load_from_file() (null for generated worlds)
+    std::shared_ptr<const MappedFile> mapped_file;
+
+    // Constructors - obstacles are created later by initialize_obstacles()
     World(); 
+    World(int world_width, int world_height);
 
     // Methods
     // Check if a position is within bounds AND not an obstacle
-    bool is_walkable(int r, int c) const;
-    bool is_walkable(const Vec2D& pos) const; // Overload for convenience
+    // Defined inline: this is the hottest query in the simulation
+    bool is_walkable(int r, int c) const { return grid.in_bounds(c, r) && !grid.is_set(c, r); }
+    bool is_walkable(const Vec2D& pos) const { return is_walkable(pos.y, pos.x); } // Overload for convenience
+    bool is_obstacle(const Vec2D& pos) const { return grid.in_bounds(pos.x, pos.y) && grid.is_set(pos.x, pos.y); }
     bool is_valid(const Vec2D& pos) const;
 
     // Method to initialize/re-initialize obstacles (could be called by constructor)
-    void initialize_obstacles();
+    // The map is generated in CHUNK_SIZE tiles on a pool of thread_count threads
+    // (0 = one per hardware thread); the same seed always yields the same map,
+    // whatever the thread count.
+    void initialize_obstacles(uint32_t seed, unsigned thread_count = 0);
+
+    // Place (blocked = true) or remove obstacles mid-run. Cells that already have the
+    // requested state are skipped. The component labels of the touched chunks are
+    // updated, the safe-zone fields are rebuilt only if the change lies within their
+    // range, and the change is logged in dirty_regions.
+    void set_obstacles(const std::vector<Vec2D>& cells, bool blocked);
+    void set_obstacle(const Vec2D& pos, bool blocked) { set_obstacles({pos}, blocked); }
+    void add_obstacle(const Vec2D& pos) { set_obstacles({pos}, true); }
+    void remove_obstacle(const Vec2D& pos) { set_obstacles({pos}, false); }
+
+    // Build path_hierarchy for find_path_hierarchical on thread_count threads (0 = one
+    // per hardware thread). Worth it on large maps only, so nothing builds it by default.
+    void build_path_hierarchy(unsigned thread_count = 0);
+
+    // Calls fn(region) for every logged region newer than since_version and returns
+    // false if the log no longer reaches back that far (treat everything as changed)
+    template <typename Fn>
+    bool for_each_change_since(uint64_t since_version, Fn&& fn) const {
+        if (since_version >= obstacle_version) {
+            return true;
+        }
+        if (since_version < dirty_log_start) {
+            return false;
+        }
+        for (auto it = dirty_regions.rbegin(); it != dirty_regions.rend() && it->version > since_version; ++it) {
+            fn(*it);
+        }
+        return true;
+    }
+
+    // True if an obstacle placed after since_version now blocks any of path[first..]
+    bool is_path_blocked_since(const std::vector<Vec2D>& path, size_t first, uint64_t since_version) const;
+
+    // O(1) check whether find_path(from, to) can possibly succeed: to must be walkable
+    // and in the same component as from (or, if from is blocked, as one of its neighbors)
+    bool is_reachable(const Vec2D& from, const Vec2D& to) const;
 
     const std::vector<Vec2D>& get_safe_zone_centers() const; // Added
-    bool is_in_safe_zone(const Vec2D& pos) const;           // Added
+    bool is_in_safe_zone(const Vec2D& pos) const {          // Single bit test on the zone mask
+        return safe_zone_mask.in_bounds(pos.x, pos.y) && safe_zone_mask.is_set(pos.x, pos.y);
+    }
+
+    // Rebuild the zone mask and the multi-source BFS distance / next-step field
+    // from the current safe_zone_centers and obstacles
+    void build_safe_zone_fields();
+
+    // Walking distance to the nearest reachable safe zone center, or -1 if outside the field
+    int get_safe_zone_distance(const Vec2D& pos) const;
+
+    // Follow the next-step field from start to the nearest reachable zone center.
+    // Fills route with start..center (inclusive) and returns false if start is outside the field
+    // (or the field leads nowhere, as only a damaged world file could make it).
+    bool get_route_to_safe_zone(const Vec2D& start, std::vector<Vec2D>& route) const;
+
+    // Write the obstacles, safe zones and derived fields to a versioned binary file
+    // (format described in WorldFile.cpp). Returns false if the file cannot be written.
+    bool save_to_file(const std::string& path) const;
+
+    // Memory-map a file written by save_to_file() and point the grids straight into it.
+    // Nothing is copied or rebuilt; pages are read by the OS on first touch.
+    // Returns false (leaving the world unchanged) if the file is missing, truncated,
+    // from another format version or was saved with different zone settings.
+    bool load_from_file(const std::string& path);
+
+    // Prints chunk usage (bytes per chunk, allocated vs total) and total storage
+    void print_memory_report(std::ostream& out) const;
 
 private:
     // Helper function to clean up obstacles after initial generation
-    void clean_up_obstacles();
+    void clean_up_obstacles(ThreadPool& pool);
     void add_random_obstacles([[maybe_unused]] int count);
 };
 
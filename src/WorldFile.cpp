@@ -0,0 +1,282 @@
+#include "World.h"
+#include "MappedFile.h"
+#include <fstream>
+#include <cstring>
+#include <utility>
+#include <algorithm> // For std::any_of
+
+// World file layout (all values little-endian, as written by the saving machine):
+//
+//   FileHeader                  fixed 64 bytes, see below
+//   SectionEntry[section_count] one entry per array stored in the file
+//   section payloads            each starting on a SECTION_ALIGNMENT boundary
+//
+// Every section is a raw copy of one in-memory array (chunk table, chunk payloads,
+// zone centers), so loading only has to validate the header and point the grids
+// at the mapped bytes. Bump FORMAT_VERSION whenever the layout or meaning changes.
+namespace {
+
+const char FILE_MAGIC[8] = {'P', 'P', 'W', 'O', 'R', 'L', 'D', '\0'};
+const uint32_t FORMAT_VERSION = 2; // 2: connected-component labels
+const uint32_t ENDIAN_CHECK = 0x01020304;
+const size_t SECTION_ALIGNMENT = 64; // Cache-line aligned payloads
+
+enum SectionId : uint32_t {
+    SECTION_GRID_SLOTS = 1,
+    SECTION_GRID_ROWS,
+    SECTION_SAFE_ZONE_CENTERS,
+    SECTION_ZONE_MASK_SLOTS,
+    SECTION_ZONE_MASK_ROWS,
+    SECTION_ZONE_DISTANCE_SLOTS,
+    SECTION_ZONE_DISTANCE_CELLS,
+    SECTION_ZONE_STEP_SLOTS,
+    SECTION_ZONE_STEP_CELLS,
+    SECTION_COMPONENT_LABEL_SLOTS,
+    SECTION_COMPONENT_LABEL_CELLS,
+    SECTION_COMPONENT_CHUNK_COUNTS,
+    SECTION_COMPONENT_NODES,
+    SECTION_COUNT = SECTION_COMPONENT_NODES
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;       // sizeof(FileHeader), guards against struct layout drift
+    uint32_t endian_check;      // ENDIAN_CHECK as written by the saving machine
+    int32_t width;
+    int32_t height;
+    int32_t chunk_size;         // CHUNK_SIZE the chunk tables were built with
+    uint32_t generation_seed;
+    int32_t safe_zone_radius;
+    int32_t safe_zone_field_range;
+    uint32_t section_count;
+    uint8_t reserved[16];
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t element_size; // Bytes per element, checked against the loader's type
+    uint64_t offset;       // From the start of the file, SECTION_ALIGNMENT aligned
+    uint64_t count;        // Number of elements
+};
+static_assert(sizeof(SectionEntry) == 24, "SectionEntry must stay 24 bytes");
+
+// One array to be written: where it lives in memory and how big it is
+struct SectionSource {
+    uint32_t id;
+    uint32_t element_size;
+    const void* data;
+    uint64_t count;
+};
+
+size_t align_up(size_t value) {
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+template <typename T, int N>
+void add_storage_sections(std::vector<SectionSource>& sections, uint32_t slots_id, uint32_t data_id,
+                          const ChunkStorage<T, N>& storage) {
+    sections.push_back({slots_id, sizeof(int32_t), storage.slots, storage.chunk_count});
+    sections.push_back({data_id, sizeof(T), storage.data, storage.allocated * N});
+}
+
+// Bounds-checked view of the mapped file's section table
+class SectionReader {
+public:
+    SectionReader(const MappedFile& mapped, const SectionEntry* table, uint32_t table_size)
+        : file(mapped), entries(table), entry_count(table_size) {}
+
+    // Pointer to section id if it exists, has elements of type T and expected_count
+    // elements (or any count when expected_count is negative), else nullptr.
+    // count receives the element count.
+    template <typename T>
+    const T* find(uint32_t id, int64_t expected_count, uint64_t& count) const {
+        for (uint32_t i = 0; i < entry_count; ++i) {
+            const SectionEntry& entry = entries[i];
+            if (entry.id != id) continue;
+            if (entry.element_size != sizeof(T) || entry.offset % SECTION_ALIGNMENT != 0) return nullptr;
+            if (expected_count >= 0 && entry.count != static_cast<uint64_t>(expected_count)) return nullptr;
+            if (entry.offset > file.size() || entry.count > (file.size() - entry.offset) / sizeof(T)) return nullptr;
+            count = entry.count;
+            return reinterpret_cast<const T*>(file.data() + entry.offset);
+        }
+        return nullptr;
+    }
+
+private:
+    const MappedFile& file;
+    const SectionEntry* entries;
+    uint32_t entry_count;
+};
+
+// Chunk table plus payload of one grid. The table is checked so that every
+// lookup through it stays inside the payload.
+template <typename T>
+struct StorageView {
+    const int32_t* slots = nullptr;
+    const T* data = nullptr;
+    size_t allocated = 0;
+};
+
+template <typename T, int ELEMENTS_PER_CHUNK>
+bool read_storage(const SectionReader& reader, uint32_t slots_id, uint32_t data_id,
+                  size_t chunk_count, StorageView<T>& view) {
+    uint64_t slot_count = 0;
+    uint64_t element_count = 0;
+    view.slots = reader.find<int32_t>(slots_id, static_cast<int64_t>(chunk_count), slot_count);
+    view.data = reader.find<T>(data_id, -1, element_count);
+    if (!view.slots || !view.data || element_count % ELEMENTS_PER_CHUNK != 0) {
+        return false;
+    }
+    view.allocated = static_cast<size_t>(element_count / ELEMENTS_PER_CHUNK);
+    for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        if (view.slots[chunk] >= static_cast<int64_t>(view.allocated)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool World::save_to_file(const std::string& path) const {
+    std::vector<SectionSource> sections;
+    add_storage_sections(sections, SECTION_GRID_SLOTS, SECTION_GRID_ROWS, grid.storage);
+    sections.push_back({SECTION_SAFE_ZONE_CENTERS, sizeof(Vec2D), safe_zone_centers.data(), safe_zone_centers.size()});
+    add_storage_sections(sections, SECTION_ZONE_MASK_SLOTS, SECTION_ZONE_MASK_ROWS, safe_zone_mask.storage);
+    add_storage_sections(sections, SECTION_ZONE_DISTANCE_SLOTS, SECTION_ZONE_DISTANCE_CELLS, safe_zone_distance.storage);
+    add_storage_sections(sections, SECTION_ZONE_STEP_SLOTS, SECTION_ZONE_STEP_CELLS, safe_zone_next_step.storage);
+    add_storage_sections(sections, SECTION_COMPONENT_LABEL_SLOTS, SECTION_COMPONENT_LABEL_CELLS,
+                         components.local_labels.storage);
+    sections.push_back({SECTION_COMPONENT_CHUNK_COUNTS, sizeof(uint16_t), components.chunk_component_count.data(),
+                        components.chunk_component_count.size()});
+    sections.push_back({SECTION_COMPONENT_NODES, sizeof(uint32_t), components.node_component.data(),
+                        components.node_component.size()});
+
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.header_size = sizeof(FileHeader);
+    header.endian_check = ENDIAN_CHECK;
+    header.width = width;
+    header.height = height;
+    header.chunk_size = CHUNK_SIZE;
+    header.generation_seed = generation_seed;
+    header.safe_zone_radius = safe_zone_radius;
+    header.safe_zone_field_range = safe_zone_field_range;
+    header.section_count = static_cast<uint32_t>(sections.size());
+
+    // Lay the payloads out after the section table
+    std::vector<SectionEntry> entries;
+    size_t offset = align_up(sizeof(FileHeader) + sections.size() * sizeof(SectionEntry));
+    for (const auto& section : sections) {
+        entries.push_back({section.id, section.element_size, offset, section.count});
+        offset = align_up(offset + section.count * section.element_size);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    const char padding[SECTION_ALIGNMENT] = {};
+    auto pad_to = [&](size_t target) {
+        const size_t position = static_cast<size_t>(out.tellp());
+        out.write(padding, static_cast<std::streamsize>(target - position));
+    };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(SectionEntry)));
+    for (size_t i = 0; i < sections.size(); ++i) {
+        pad_to(static_cast<size_t>(entries[i].offset));
+        out.write(static_cast<const char*>(sections[i].data),
+                  static_cast<std::streamsize>(sections[i].count * sections[i].element_size));
+    }
+    pad_to(offset);
+    return static_cast<bool>(out);
+}
+
+bool World::load_from_file(const std::string& path) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path) || file->size() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.header_size != sizeof(FileHeader) ||
+        header.endian_check != ENDIAN_CHECK ||
+        header.chunk_size != CHUNK_SIZE ||
+        header.width < DEFAULT_WIDTH || header.width > MAX_DIMENSION ||
+        header.height < DEFAULT_HEIGHT || header.height > MAX_DIMENSION ||
+        header.safe_zone_radius != safe_zone_radius ||
+        header.safe_zone_field_range != safe_zone_field_range ||
+        header.section_count < SECTION_COUNT ||
+        header.section_count > (file->size() - sizeof(FileHeader)) / sizeof(SectionEntry)) {
+        return false;
+    }
+
+    // The section table directly follows the 64-byte header, so it is suitably aligned
+    const SectionReader reader(*file, reinterpret_cast<const SectionEntry*>(file->data() + sizeof(FileHeader)),
+                               header.section_count);
+    const size_t chunk_count = static_cast<size_t>((header.width + CHUNK_MASK) >> CHUNK_SHIFT) *
+                               static_cast<size_t>((header.height + CHUNK_MASK) >> CHUNK_SHIFT);
+
+    StorageView<uint64_t> grid_view;
+    StorageView<uint64_t> mask_view;
+    StorageView<uint16_t> distance_view;
+    StorageView<uint8_t> step_view;
+    StorageView<uint16_t> label_view;
+    uint64_t node_count = 0;
+    uint64_t chunk_count_check = 0;
+    const uint16_t* component_counts = reader.find<uint16_t>(SECTION_COMPONENT_CHUNK_COUNTS,
+                                                            static_cast<int64_t>(chunk_count), chunk_count_check);
+    const uint32_t* component_nodes = reader.find<uint32_t>(SECTION_COMPONENT_NODES, -1, node_count);
+    uint64_t center_count = 0;
+    const Vec2D* centers = reader.find<Vec2D>(SECTION_SAFE_ZONE_CENTERS, -1, center_count);
+    if (!read_storage<uint64_t, CHUNK_SIZE>(reader, SECTION_GRID_SLOTS, SECTION_GRID_ROWS, chunk_count, grid_view) ||
+        !read_storage<uint64_t, CHUNK_SIZE>(reader, SECTION_ZONE_MASK_SLOTS, SECTION_ZONE_MASK_ROWS, chunk_count, mask_view) ||
+        !read_storage<uint16_t, CHUNK_CELLS>(reader, SECTION_ZONE_DISTANCE_SLOTS, SECTION_ZONE_DISTANCE_CELLS, chunk_count, distance_view) ||
+        !read_storage<uint8_t, CHUNK_CELLS>(reader, SECTION_ZONE_STEP_SLOTS, SECTION_ZONE_STEP_CELLS, chunk_count, step_view) ||
+        !read_storage<uint16_t, CHUNK_CELLS>(reader, SECTION_COMPONENT_LABEL_SLOTS, SECTION_COMPONENT_LABEL_CELLS, chunk_count, label_view) ||
+        !centers || !component_counts || !component_nodes) {
+        return false;
+    }
+    // Routes to safe zones index NEIGHBOR_OFFSETS with these bytes
+    const uint8_t* steps_end = step_view.data + step_view.allocated * CHUNK_CELLS;
+    if (std::any_of(step_view.data, steps_end, [](uint8_t dir) { return dir >= 8 && dir != NO_STEP; })) {
+        return false;
+    }
+
+    ComponentIndex loaded_components;
+    if (!loaded_components.attach_labels(header.width, header.height, label_view.slots, label_view.data,
+                                         label_view.allocated, component_counts, component_nodes,
+                                         static_cast<size_t>(node_count))) {
+        return false;
+    }
+
+    // Everything checked out: switch the world over to the mapped data
+    width = header.width;
+    height = header.height;
+    generation_seed = header.generation_seed;
+    grid.attach(width, height, grid_view.slots, grid_view.data, grid_view.allocated);
+    safe_zone_mask.attach(width, height, mask_view.slots, mask_view.data, mask_view.allocated);
+    safe_zone_distance.attach(width, height, distance_view.slots, distance_view.data,
+                              distance_view.allocated, SAFE_ZONE_UNREACHED);
+    safe_zone_next_step.attach(width, height, step_view.slots, step_view.data,
+                               step_view.allocated, NO_STEP);
+    safe_zone_centers.assign(centers, centers + center_count); // A handful of points, copied for convenience
+    components = std::move(loaded_components);
+    obstacle_version++;
+    dirty_log_start = obstacle_version;
+    dirty_regions.clear();
+    mapped_file = file;
+    if (path_hierarchy.built) {
+        build_path_hierarchy(); // Not stored in the file
+    }
+    return true;
+}
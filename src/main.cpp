@@ -1,10 +1,16 @@
 #include <iostream>
 #include <random>
 #include <vector>
-#include "Sprite.h"
+#include <string>
+#include "SpriteStore.h"
 #include "World.h"
 #include "SimulationSetup.h"
 #include "GameLogic.h"
+#include "Benchmark.h"
+#include "Pathfinding.h"
+#include "PathCache.h"
+#include "FlowField.h"
+#include "PathService.h"
 
 // Global Random Generator (used by multiple modules)
 std::random_device rd;
@@ -12,19 +18,75 @@ std::mt19937 gen(rd());
 
 // --- Main Function --- 
 int main(int /*argc*/, char* /*argv*/[]) {
-    // Initialize the world
-    World world;
-    world.initialize_obstacles();
+    // Optional benchmark mode: print timings and exit without running the simulation
+    if (SimulationSetup::get_env_int("BENCHMARK", 0) != 0) {
+        Benchmark::run_all(std::cout);
+        return 0;
+    }
+
+    // Initialize the world (dimensions and seed are chosen at runtime).
+    // With WORLD_FILE set, a saved map is mapped straight from disk; if the file
+    // does not exist yet the generated map is written there for the next run.
+    World world(SimulationSetup::get_world_width(), SimulationSetup::get_world_height());
+    std::string world_file = SimulationSetup::get_world_file();
+    if (world_file.empty() || !world.load_from_file(world_file)) {
+        world.initialize_obstacles(SimulationSetup::get_world_seed());
+        if (!world_file.empty() && !world.save_to_file(world_file)) {
+            std::cerr << "Could not save world to " << world_file << std::endl;
+        }
+    }
+    uint32_t world_seed = world.generation_seed;
+
+    // Pick the pathfinding engine (PATH_ENGINE=astar|astar-chebyshev|astar-octile|jps|hpa|bidirectional|theta);
+    // the hierarchical engine needs its cluster graph built first
+    SimulationSetup::apply_path_engine_setting();
+    if (get_active_path_engine() == PathEngine::HPA) {
+        world.build_path_hierarchy();
+    }
+    SimulationSetup::apply_path_cache_setting();
+    SimulationSetup::apply_incremental_replan_setting();
+    SimulationSetup::apply_path_budget_setting();
+    SimulationSetup::apply_path_service_setting();
+    SimulationSetup::apply_flow_field_setting();
 
     // Get the maximum number of steps
     int max_steps = SimulationSetup::get_max_steps();
     
     // Initialize predators and prey
-    std::vector<Sprite> predators = SimulationSetup::initialize_predators();
-    std::vector<Sprite> prey_sprites = SimulationSetup::initialize_prey(world);
+    SpriteStore predators = SimulationSetup::initialize_predators();
+    SpriteStore prey_sprites = SimulationSetup::initialize_prey(world);
     
     // Run the simulation
     GameLogic::run_simulation(predators, prey_sprites, world, max_steps);
+
+    // Report the seed so the same map can be regenerated with WORLD_SEED
+    std::cout << "World seed: " << world_seed << std::endl;
+
+    // How much replanning the predators' path cache saved
+    const PathCache::Stats cache_stats = PathCache::shared().stats();
+    if (cache_stats.hits + cache_stats.suffix_hits + cache_stats.misses > 0) {
+        std::cout << "Path cache: " << cache_stats.hits << " hits, " << cache_stats.suffix_hits << " suffix hits, "
+                  << cache_stats.misses << " misses, " << cache_stats.evictions << " evicted, "
+                  << cache_stats.stale << " stale" << std::endl;
+    }
+
+    const FlowFieldCache::Stats& flow_stats = FlowFieldCache::shared().stats();
+    if (flow_stats.lookups > 0) {
+        std::cout << "Flow fields: " << flow_stats.fields_built << " built for " << flow_stats.lookups
+                  << " chase replans" << std::endl;
+    }
+
+    const PathService::Stats& service_stats = PathService::shared().stats();
+    if (PathService::shared().enabled()) {
+        std::cout << "Path service: " << service_stats.searches << " searches for " << service_stats.requests
+                  << " requests (" << service_stats.shared << " shared, " << service_stats.dropped << " dropped)"
+                  << std::endl;
+    }
+
+    // Optional storage statistics for tuning large maps
+    if (SimulationSetup::get_env_int("MEMORY_REPORT", 0) != 0) {
+        world.print_memory_report(std::cout);
+    }
     
     return 0;
 } 
\ No newline at end of file